@@ -0,0 +1,405 @@
+
+/* Standalone throughput benchmark for the device kernels behind
+ * vclMatrix gemm, the elementwise operations, colSums, pmcc and eucl.
+ *
+ * Every kernel is timed through the templates the package links: the
+ * BLAS of gpuR/vcl_blas_helpers.hpp (the 64 bit kernels of
+ * gpuR/vcl_int_kernels.hpp for int), the in-place elementwise kernel of
+ * gpuR/vcl_inplace_kernels.hpp and the statistics of
+ * gpuR/vcl_stats_helpers.hpp.  Results are reported as GFLOP/s and
+ * GB/s relative to peaks measured on the device.
+ * Results are written as CSV, one row per kernel/type/shape/size.
+ */
+
+// Use OpenCL with ViennaCL
+#define VIENNACL_WITH_OPENCL 1
+
+// ViennaCL headers
+#include "viennacl/ocl/backend.hpp"
+#include "viennacl/ocl/device.hpp"
+#include "viennacl/ocl/platform.hpp"
+#include "viennacl/matrix.hpp"
+#include "viennacl/vector.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/sum.hpp"
+#include "viennacl/tools/timer.hpp"
+
+#include "gpuR/vcl_blas_helpers.hpp"
+#include "gpuR/vcl_inplace_kernels.hpp"
+#include "gpuR/vcl_int_kernels.hpp"
+#include "gpuR/vcl_stats_helpers.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+struct benchOptions {
+    std::string device;
+    std::vector<int> sizes;
+    std::vector<std::string> types;
+    int reps;
+    std::string out;
+};
+
+struct devicePeak {
+    double gflops;
+    double gbs;
+};
+
+struct benchShape {
+    const char *name;
+    int rows;
+    int cols;
+};
+
+static std::vector<std::string>
+split(const std::string &s)
+{
+    std::vector<std::string> out;
+    std::stringstream ss(s);
+    std::string item;
+    while(std::getline(ss, item, ',')){
+        if(!item.empty()) out.push_back(item);
+    }
+    return out;
+}
+
+static void
+usage()
+{
+    std::cerr << "usage: bench [--device cpu|gpu] [--sizes 256,512,1024]\n"
+              << "             [--types int,float,double] [--reps 10] [--out file.csv]\n";
+}
+
+// time a device operation, excluding kernel compilation
+template <typename F>
+double
+time_op(F f, int reps)
+{
+    f();
+    viennacl::backend::finish();
+
+    viennacl::tools::timer timer;
+    timer.start();
+    for(int i = 0; i < reps; i++){
+        f();
+    }
+    viennacl::backend::finish();
+    return timer.get() / reps;
+}
+
+template <typename T>
+void
+random_matrix(viennacl::matrix<T> &vcl_A, int seed)
+{
+    std::vector<std::vector<T> > host(vcl_A.size1(), std::vector<T>(vcl_A.size2()));
+    std::srand(seed);
+    for(unsigned int i = 0; i < host.size(); i++){
+        for(unsigned int j = 0; j < host[i].size(); j++){
+            host[i][j] = static_cast<T>(std::rand() % 100) / static_cast<T>(10);
+        }
+    }
+    viennacl::copy(host, vcl_A);
+}
+
+/* Device peaks for type T.
+ * Compute: independent multiply-add chains in a kernel compiled for the
+ * current context.  Bandwidth: a large device-to-device vector copy.
+ */
+template <typename T>
+devicePeak
+measure_peak(int reps)
+{
+    devicePeak peak;
+    const std::string type = viennacl::ocl::type_to_string<T>::apply();
+
+    std::string src;
+    if(type == "double"){
+        src += "#pragma OPENCL EXTENSION cl_khr_fp64 : enable\n";
+    }
+    src += "__kernel void peak(__global " + type + " *out, " + type + " y, int iters)\n"
+           "{\n"
+           "    " + type + " x0 = get_global_id(0), x1 = x0 + 1, x2 = x0 + 2, x3 = x0 + 3;\n"
+           "    " + type + " x4 = x0 + 4, x5 = x0 + 5, x6 = x0 + 6, x7 = x0 + 7;\n"
+           "    for(int i = 0; i < iters; i++){\n"
+           "        x0 = x0 * y + x1; x1 = x1 * y + x2; x2 = x2 * y + x3; x3 = x3 * y + x4;\n"
+           "        x4 = x4 * y + x5; x5 = x5 * y + x6; x6 = x6 * y + x7; x7 = x7 * y + x0;\n"
+           "    }\n"
+           "    out[get_global_id(0)] = x0 + x1 + x2 + x3 + x4 + x5 + x6 + x7;\n"
+           "}\n";
+
+    viennacl::ocl::context &ctx = viennacl::ocl::current_context();
+    const std::string prog_name = "gpuR_bench_peak_" + type;
+    if(!ctx.has_program(prog_name)){
+        ctx.add_program(src, prog_name);
+    }
+    viennacl::ocl::kernel &k = ctx.get_kernel(prog_name, "peak");
+
+    const int iters = 1024;
+    const size_t local = 64;
+    const size_t global = local * 64 * ctx.current_device().max_compute_units();
+    k.local_work_size(0, local);
+    k.global_work_size(0, global);
+
+    viennacl::vector<T> out(global);
+    const T y = static_cast<T>(1);
+
+    double secs = time_op([&](){
+        viennacl::ocl::enqueue(k(viennacl::traits::opencl_handle(out), y, static_cast<cl_int>(iters)));
+    }, reps);
+    peak.gflops = 2.0 * 8 * iters * global / secs * 1e-9;
+
+    const size_t n = (size_t)(64 * 1024 * 1024) / sizeof(T);
+    viennacl::vector<T> v1 = viennacl::scalar_vector<T>(n, 1);
+    viennacl::vector<T> v2(n);
+    secs = time_op([&](){ v2 = v1; }, reps);
+    peak.gbs = 2.0 * n * sizeof(T) / secs * 1e-9;
+
+    return peak;
+}
+
+static void
+report(
+    std::ostream &out,
+    const std::string &kernel, const std::string &type, const benchShape &shape,
+    int rows, int cols, int inner,
+    double secs, double flops, double bytes, const devicePeak &peak)
+{
+    double gflops = flops / secs * 1e-9;
+    double gbs = bytes / secs * 1e-9;
+
+    out << kernel << "," << type << "," << shape.name << ","
+        << rows << "," << cols << "," << inner << ","
+        << secs << "," << gflops << "," << gbs << ","
+        << 100 * gflops / peak.gflops << "," << 100 * gbs / peak.gbs << "\n";
+    out.flush();
+}
+
+// the package paths of the BLAS cases, the integer suite for int
+template <typename T>
+struct benchOps {
+    static void gemm(viennacl::matrix<T> &A, viennacl::matrix<T> &B, viennacl::matrix<T> &C){
+        vcl_gemm<T>(A, B, C);
+    }
+    static void elem_prod(viennacl::matrix<T> &A, viennacl::matrix<T> &B, viennacl::matrix<T> &C){
+        vcl_elem_prod<T>(A, B, C);
+    }
+    static void axpy(T alpha, viennacl::matrix<T> &A, viennacl::matrix<T> &B){
+        vcl_axpy<T>(alpha, A, B);
+    }
+    static void col_sums(viennacl::matrix<T> &A, viennacl::vector<T> &S){
+        S = viennacl::linalg::column_sum(A);
+    }
+};
+
+template <>
+struct benchOps<int> {
+    static void gemm(viennacl::matrix<int> &A, viennacl::matrix<int> &B, viennacl::matrix<int> &C){
+        vcl_int_gemm<int>(A.handle().opencl_handle(), vcl_matrix_layout(A),
+                          B.handle().opencl_handle(), vcl_matrix_layout(B),
+                          C.handle().opencl_handle(), vcl_matrix_layout(C));
+    }
+    static void elem_prod(viennacl::matrix<int> &A, viennacl::matrix<int> &B, viennacl::matrix<int> &C){
+        vcl_int_arith<int>(A.handle().opencl_handle(), vcl_matrix_layout(A),
+                           B.handle().opencl_handle(), vcl_matrix_layout(B),
+                           0, false, false, GPUR_INT_MULT,
+                           C.handle().opencl_handle(), vcl_matrix_layout(C));
+    }
+    // integer '+' and '-', the only integer axpy the package has
+    static void axpy(int, viennacl::matrix<int> &A, viennacl::matrix<int> &B){
+        vcl_int_arith<int>(B.handle().opencl_handle(), vcl_matrix_layout(B),
+                           A.handle().opencl_handle(), vcl_matrix_layout(A),
+                           0, false, false, GPUR_INT_ADD,
+                           B.handle().opencl_handle(), vcl_matrix_layout(B));
+    }
+    static void col_sums(viennacl::matrix<int> &A, viennacl::vector<int> &S){
+        vcl_int_sums<int>(A.handle().opencl_handle(), vcl_matrix_layout(A),
+                          S.handle().opencl_handle(), vcl_vector_layout(S), true);
+    }
+};
+
+template <typename T>
+void
+run_type(std::ostream &out, const benchOptions &opts)
+{
+    const std::string type = viennacl::ocl::type_to_string<T>::apply();
+    const bool is_int = (type == "int");
+    const double s = sizeof(T);
+
+    if(type == "double" && !viennacl::ocl::current_device().double_support()){
+        std::cerr << "skipping double: not supported by "
+                  << viennacl::ocl::current_device().name() << std::endl;
+        return;
+    }
+
+    devicePeak peak = measure_peak<T>(opts.reps);
+    std::cerr << type << " peak: " << peak.gflops << " GFLOP/s, "
+              << peak.gbs << " GB/s" << std::endl;
+
+    for(unsigned int i = 0; i < opts.sizes.size(); i++){
+        const int n = opts.sizes[i];
+
+        // square, tall-skinny and short-wide with the same element count
+        benchShape shapes[3] = {
+            {"square", n, n},
+            {"tall", 4 * n, n / 4},
+            {"wide", n / 4, 4 * n}
+        };
+
+        for(int j = 0; j < 3; j++){
+            const benchShape &sh = shapes[j];
+            const int M = sh.rows;
+            const int K = sh.cols;
+            if(M < 2 || K < 2) continue;
+
+            viennacl::matrix<T> vcl_A(M, K);
+            viennacl::matrix<T> vcl_B(M, K);
+            viennacl::matrix<T> vcl_C(M, K);
+            random_matrix(vcl_A, 1);
+            random_matrix(vcl_B, 2);
+
+            const double mk = (double)M * K;
+            double secs;
+
+            // gemm, A (M x K) %*% t(B) (K x M)
+            {
+                viennacl::matrix<T> vcl_Bt = trans(vcl_B);
+                viennacl::matrix<T> vcl_D(M, M);
+                secs = time_op([&](){ benchOps<T>::gemm(vcl_A, vcl_Bt, vcl_D); }, opts.reps);
+                report(out, "gemm", type, sh, M, M, K, secs,
+                       2.0 * M * M * K, s * (2 * mk + (double)M * M), peak);
+            }
+
+            // the kernel of the in-place and out= operators
+            secs = time_op([&](){
+                vcl_elementwise<T>(vcl_A.handle().opencl_handle(), vcl_matrix_layout(vcl_A),
+                                   vcl_B.handle().opencl_handle(), vcl_matrix_layout(vcl_B),
+                                   T(0), false, GPUR_ELEM_ADD,
+                                   vcl_C.handle().opencl_handle(), vcl_matrix_layout(vcl_C));
+            }, opts.reps);
+            report(out, "elem_add", type, sh, M, K, 0, secs, mk, s * 3 * mk, peak);
+
+            secs = time_op([&](){ benchOps<T>::elem_prod(vcl_A, vcl_B, vcl_C); }, opts.reps);
+            report(out, "elem_prod", type, sh, M, K, 0, secs, mk, s * 3 * mk, peak);
+
+            secs = time_op([&](){ benchOps<T>::axpy(static_cast<T>(2), vcl_A, vcl_C); }, opts.reps);
+            report(out, "axpy", type, sh, M, K, 0, secs, 2 * mk, s * 3 * mk, peak);
+
+            {
+                viennacl::vector<T> vcl_sums(K);
+                secs = time_op([&](){ benchOps<T>::col_sums(vcl_A, vcl_sums); }, opts.reps);
+                report(out, "colSums", type, sh, M, K, 0, secs, mk, s * (mk + K), peak);
+            }
+
+            if(is_int) continue;
+
+            secs = time_op([&](){ vcl_C = viennacl::linalg::element_exp(vcl_A); }, opts.reps);
+            report(out, "elem_exp", type, sh, M, K, 0, secs, mk, s * 2 * mk, peak);
+
+            // pmcc, covariance of the K columns
+            {
+                viennacl::matrix<T> vcl_P(K, K);
+                secs = time_op([&](){ vcl_pmcc<T>(vcl_A, vcl_P); }, opts.reps);
+                report(out, "pmcc", type, sh, K, K, M, secs,
+                       2.0 * M * K * K + 3 * mk, s * (mk + (double)K * K), peak);
+            }
+
+            // eucl, distances between the M rows
+            {
+                viennacl::matrix<T> vcl_D(M, M);
+                secs = time_op([&](){ vcl_eucl<T>(vcl_A, vcl_D, false); }, opts.reps);
+                report(out, "eucl", type, sh, M, M, K, secs,
+                       2.0 * M * M * K + 2 * mk + 4.0 * M * M, s * (mk + (double)M * M), peak);
+            }
+        }
+    }
+}
+
+int
+main(int argc, char **argv)
+{
+    benchOptions opts;
+    opts.device = "cpu";
+    opts.types = split("int,float,double");
+    opts.reps = 10;
+
+    std::vector<std::string> sizes = split("256,512,1024");
+
+    for(int i = 1; i < argc; i++){
+        std::string arg = argv[i];
+        if(arg == "--help" || arg == "-h"){
+            usage();
+            return 0;
+        }
+        if(i + 1 >= argc){
+            usage();
+            return 1;
+        }
+        std::string val = argv[++i];
+        if(arg == "--device"){
+            opts.device = val;
+        }else if(arg == "--sizes"){
+            sizes = split(val);
+        }else if(arg == "--types"){
+            opts.types = split(val);
+        }else if(arg == "--reps"){
+            opts.reps = std::atoi(val.c_str());
+        }else if(arg == "--out"){
+            opts.out = val;
+        }else{
+            usage();
+            return 1;
+        }
+    }
+
+    for(unsigned int i = 0; i < sizes.size(); i++){
+        opts.sizes.push_back(std::atoi(sizes[i].c_str()));
+    }
+
+    // same context layout as the package, 0 for GPUs and 1 for CPUs
+    if(opts.device == "gpu"){
+        long id = 0;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::gpu_tag());
+        viennacl::ocl::switch_context(id);
+    }else if(opts.device == "cpu"){
+        long id = 1;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::cpu_tag());
+        viennacl::ocl::switch_context(id);
+    }else{
+        usage();
+        return 1;
+    }
+
+    std::ofstream file;
+    if(!opts.out.empty()){
+        file.open(opts.out.c_str());
+        if(!file){
+            std::cerr << "unable to open " << opts.out << std::endl;
+            return 1;
+        }
+    }
+    std::ostream &out = opts.out.empty() ? std::cout : file;
+
+    std::cerr << "device: " << viennacl::ocl::current_device().name() << std::endl;
+
+    out << "kernel,type,shape,rows,cols,inner,seconds,gflops,gbs,pct_peak_gflops,pct_peak_gbs\n";
+
+    for(unsigned int i = 0; i < opts.types.size(); i++){
+        if(opts.types[i] == "int"){
+            run_type<int>(out, opts);
+        }else if(opts.types[i] == "float"){
+            run_type<float>(out, opts);
+        }else if(opts.types[i] == "double"){
+            run_type<double>(out, opts);
+        }else{
+            std::cerr << "unknown type " << opts.types[i] << std::endl;
+            return 1;
+        }
+    }
+
+    return 0;
+}
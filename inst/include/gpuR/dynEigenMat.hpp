@@ -14,17 +14,34 @@
 
 #include <RcppEigen.h>
 
+#include <memory>
+
+// storage a gpuMatrix lends to its lazy deep copies, they read 'source'
+// until it is about to change and then 'snapshot', the data from before
+template <class T>
+struct eigenMatLink {
+    Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> *source;
+    Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> snapshot;
+};
+
 template <class T> 
 class dynEigenMat {
     private:
-        int nr, orig_nr, nc, orig_nc, r_start, r_end, c_start, c_end;
-        T* ptr;
+        int nr, nc, r_start, r_end, c_start, c_end;
+        // matrix holding the elements, &A unless this is a block
+        Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> *ptr;
+        // set on lazy deep copies, which have no storage (ptr is NULL)
+        std::shared_ptr<eigenMatLink<T> > link;
+        Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>* storage() {
+            if(ptr) return ptr;
+            return link->source ? link->source : &link->snapshot;
+        }
         
     public:
         Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> A;
 //        Eigen::Block<Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> > block;
         
-        dynEigenMat() { }; // private default constructor
+        dynEigenMat() : ptr(&A) { }; // private default constructor
         dynEigenMat(SEXP A_);
         dynEigenMat(Eigen::Matrix<T, Eigen::Dynamic,Eigen::Dynamic> &A_);
         dynEigenMat(int nr_in, int nc_in);
@@ -35,8 +52,12 @@ class dynEigenMat {
             const int col_start, const int col_end
             );
         dynEigenMat(Rcpp::XPtr<dynEigenMat<T> > dynMat);
+        ~dynEigenMat();
         
-        T* getPtr() { return A.data(); }
+        Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>* getPtr() { 
+            detach_copy();
+            return ptr; 
+        }
         int nrow() { return nr; }
         int ncol() { return nc; }
         int row_start() { return r_start; }
@@ -56,27 +77,24 @@ class dynEigenMat {
             nr = r_end - r_start + 1;
             nc = c_end - c_start + 1;
         }
-        void setSourceDim(const int rows, const int cols){
-            orig_nr = rows;
-            orig_nc = cols;
-        }
         void setMatrix(Eigen::Map<Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> > &Mat){
+            detach();
             A = Mat;
         }
         void setMatrix(Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> &Mat){
+            detach();
             A = Mat;
         }
-        void setPtr(T* ptr_){
+        void setPtr(Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>* ptr_){
             ptr = ptr_;
         }
         Eigen::Ref<Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> > data();
-        Eigen::Map<Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> > matrix() {
-            Eigen::Map<Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> > mat(ptr, nr, nc);
-//            Eigen::Matrix<T, Eigen::Dynamic, 1>& vec = A;
-            return mat;
-        }
         viennacl::matrix<T> device_data();
         void to_host(viennacl::matrix<T> &vclMat);
+        dynEigenMat<T>* share();
+        void detach();
+        void detach_copy();
+        void append_rows(const Eigen::Ref<const Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> > &B);
 };
 
 #endif
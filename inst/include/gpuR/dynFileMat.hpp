@@ -0,0 +1,35 @@
+#pragma once
+#ifndef DYNFILE_MAT_HPP
+#define DYNFILE_MAT_HPP
+
+#include <RcppEigen.h>
+
+#include "gpuR/matrix_file.hpp"
+
+#include <string>
+
+/* A matrix stored in a gpuR matrix file (matrix_file.hpp) and mapped
+ * into memory instead of read.  The elements are column-major with a
+ * leading dimension of nrow(), straight from the mapping, so the pages
+ * are only read as they are touched and the matrix may be larger than
+ * RAM.  A read-only mapping must not be written through data().
+ */
+template <class T>
+class dynFileMat {
+    private:
+        size_t nr, nc;
+        bool writable;
+        std::string path;
+        mappedFile map;
+
+    public:
+        dynFileMat(std::string path_, int type_flag, bool writable_);
+
+        size_t nrow() { return nr; }
+        size_t ncol() { return nc; }
+        bool is_writable() { return writable; }
+        std::string file() { return path; }
+        T* data() { return reinterpret_cast<T *>(map.data() + GPUR_FILE_HEADER); }
+};
+
+#endif
@@ -0,0 +1,32 @@
+#pragma once
+#ifndef DYNVCL_HALF_HPP
+#define DYNVCL_HALF_HPP
+
+// Use OpenCL with ViennaCL
+#define VIENNACL_WITH_OPENCL 1
+
+// ViennaCL headers
+#include "viennacl/ocl/backend.hpp"
+#include "viennacl/ocl/context.hpp"
+#include "viennacl/backend/memory.hpp"
+
+/* A half precision matrix or vector on the device, stored densely in
+ * column-major order (a vector is a single column).  ViennaCL has no
+ * half type so the buffer is a plain OpenCL one, written and read only
+ * through the vstore_half/vload_half kernels of vcl_half_kernels.hpp.
+ */
+class dynVCLHalf {
+    private:
+        int nr, nc;
+        viennacl::backend::mem_handle buf;
+
+    public:
+        dynVCLHalf(int nr_in, int nc_in);
+
+        int nrow() { return nr; }
+        int ncol() { return nc; }
+        unsigned int size() { return (unsigned int)nr * (unsigned int)nc; }
+        const viennacl::ocl::handle<cl_mem>& handle() { return buf.opencl_handle(); }
+};
+
+#endif
@@ -16,6 +16,27 @@
 
 #include <RcppEigen.h>
 
+#include <memory>
+
+// storage a vclMatrix lends to its lazy deep copies, they read 'source'
+// until it is about to change and then 'snapshot', the data from before
+template <class T>
+struct vclMatLink {
+    viennacl::matrix<T> *source;
+    viennacl::matrix<T> snapshot;
+};
+
+// whether R stores elements of type T as is (int, double), so they can
+// cross to and from the device straight from R's own memory
+template <class T>
+struct vclRStorage {
+    static const int rtype = Rcpp::traits::r_sexptype_traits<T>::rtype;
+    static const bool direct = Rcpp::traits::same_type<T, typename Rcpp::traits::storage_type<rtype>::type>::value;
+};
+
+// selects the dynVCLMat constructor that leaves the elements unset
+struct vclUninitialized {};
+
 template <class T> 
 class dynVCLMat {
     private:
@@ -23,12 +44,21 @@ class dynVCLMat {
         viennacl::range row_r;
         viennacl::range col_r;
         viennacl::matrix<T> *ptr;
+        // set on lazy deep copies, which have no storage (ptr is NULL)
+        std::shared_ptr<vclMatLink<T> > link;
+        void reserve_rows(int k);
+        void upload(SEXP A_, int nr_in, int nc_in, int device_flag);
+        viennacl::matrix<T>* storage() {
+            if(ptr) return ptr;
+            return link->source ? link->source : &link->snapshot;
+        }
     
     public:
         viennacl::matrix<T> A;
         
-        dynVCLMat() { } // private default constructor
+        dynVCLMat() : ptr(&A) { } // private default constructor
         dynVCLMat(SEXP A_, int device_flag);
+        dynVCLMat(SEXP A_, int nr_in, int nc_in, int device_flag);
         dynVCLMat(
             Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> Am,
             int nr_in, int nc_in,
@@ -36,9 +66,14 @@ class dynVCLMat {
             );
         dynVCLMat(int nr_in, int nc_in, int device_flag);
         dynVCLMat(int nr_in, int nc_in, T scalar, int device_flag);
+        dynVCLMat(int nr_in, int nc_in, int device_flag, vclUninitialized);
         dynVCLMat(Rcpp::XPtr<dynVCLMat<T> > dynMat);
+        ~dynVCLMat();
         
-        viennacl::matrix<T>* getPtr() { return ptr; }
+        viennacl::matrix<T>* getPtr() { 
+            detach_copy();
+            return ptr; 
+        }
         int nrow() { return nr; }
         int ncol() { return nc; }
         viennacl::range row_range() { return row_r; }
@@ -49,10 +84,12 @@ class dynVCLMat {
             int col_start, int col_end
             );
         void setMatrix(viennacl::matrix_range<viennacl::matrix<T> > mat){
+            detach();
             A = mat;
             ptr = &A;
         }
         void setMatrix(viennacl::matrix<T> mat){
+            detach();
             A = mat;
             ptr = &A;
         }
@@ -62,10 +99,31 @@ class dynVCLMat {
         }
         void setPtr(viennacl::matrix<T>* ptr_);
         viennacl::matrix_range<viennacl::matrix<T> > data();
-        viennacl::matrix<T> matrix() {
-            return A;
-        }
+        dynVCLMat<T>* share();
+        void detach();
+        void detach_copy();
+        void append_rows(Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> &B);
+        void append_rows(viennacl::matrix_range<viennacl::matrix<T> > B);
         
 };
 
+// whether two views share an element of one device buffer, a block
+// of a matrix is a different object over the same buffer
+template <class T>
+bool
+vcl_overlap(
+    const viennacl::matrix_range<viennacl::matrix<T> > &A,
+    const viennacl::matrix_range<viennacl::matrix<T> > &B)
+{
+    if(A.handle().opencl_handle().get() != B.handle().opencl_handle().get()){
+        return false;
+    }
+    
+    const size_t a1 = viennacl::traits::start1(A), a2 = viennacl::traits::start2(A);
+    const size_t b1 = viennacl::traits::start1(B), b2 = viennacl::traits::start2(B);
+    
+    return a1 < b1 + B.size1() && b1 < a1 + A.size1() &&
+        a2 < b2 + B.size2() && b2 < a2 + A.size2();
+}
+
 #endif
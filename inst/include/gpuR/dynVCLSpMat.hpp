@@ -0,0 +1,69 @@
+#pragma once
+#ifndef DYNVCL_SPMAT_HPP
+#define DYNVCL_SPMAT_HPP
+
+// Use OpenCL with ViennaCL
+#define VIENNACL_WITH_OPENCL 1
+
+// ViennaCL headers
+#include "viennacl/ocl/device.hpp"
+#include "viennacl/ocl/platform.hpp"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/coordinate_matrix.hpp"
+
+#include <RcppEigen.h>
+
+#include <memory>
+#include <vector>
+
+// sparse storage formats of a vclSparseMatrix
+#define GPUR_SPARSE_CSR 0
+#define GPUR_SPARSE_COO 1
+
+/* Compressed sparse row arrays on the host, the layout
+ * viennacl::compressed_matrix uploads from.  A dgCMatrix (compressed
+ * sparse column) is the CSR form of its transpose.
+ */
+template <class T>
+struct hostCSR {
+    int nr, nc;
+    std::vector<unsigned int> row_jumper;
+    std::vector<unsigned int> cols;
+    std::vector<T> elements;
+};
+
+/* A sparse matrix on the device in CSR (viennacl::compressed_matrix) or
+ * COO (viennacl::coordinate_matrix) format.  Products with the
+ * transpose use a CSR copy of it, built on the first crossprod or
+ * colSums and kept.  A COO matrix likewise gets a CSR copy of itself
+ * for the iterative solvers' preconditioners.
+ */
+template <class T>
+class dynVCLSpMat {
+    private:
+        int nr, nc;
+        int format;
+        viennacl::compressed_matrix<T> csr_;
+        viennacl::coordinate_matrix<T> coo_;
+        std::unique_ptr<viennacl::compressed_matrix<T> > trans_;
+        hostCSR<T> download();
+
+    public:
+        dynVCLSpMat(
+            SEXP i_, SEXP p_, SEXP x_,
+            int nr_in, int nc_in,
+            int format_in, int device_flag);
+
+        int nrow() { return nr; }
+        int ncol() { return nc; }
+        int sparse_format() { return format; }
+        int nnz() {
+            return format == GPUR_SPARSE_COO ? coo_.nnz() : csr_.nnz();
+        }
+        viennacl::compressed_matrix<T>& csr() { return csr_; }
+        viennacl::coordinate_matrix<T>& coo() { return coo_; }
+        viennacl::compressed_matrix<T>& trans();
+        viennacl::compressed_matrix<T>& compressed();
+};
+
+#endif
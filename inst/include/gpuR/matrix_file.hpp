@@ -0,0 +1,266 @@
+#pragma once
+#ifndef MATRIX_FILE_HPP
+#define MATRIX_FILE_HPP
+
+#include <RcppEigen.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <string>
+
+#ifdef _WIN32
+// keep std::min/std::max usable
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/* Binary matrix files.
+ *
+ * A fixed GPUR_FILE_HEADER byte header followed by the elements in
+ * column-major order, the order of R and of gpuMatrix storage, without
+ * padding.  The header records the element type (the type_flag of the
+ * exported functions), the dimensions and the layout, and a byte order
+ * mark so a file is never read with the wrong endianness.  The data
+ * offset keeps the elements aligned when the file is mapped.
+ */
+
+#define GPUR_FILE_MAGIC "gpuRmat"
+#define GPUR_FILE_VERSION 1
+#define GPUR_FILE_BOM 0x01020304
+#define GPUR_FILE_HEADER 64
+
+// elements are column-major, the only layout written so far
+#define GPUR_FILE_COL_MAJOR 0
+
+// bytes staged per host/device transfer when streaming a file
+#define GPUR_FILE_CHUNK (64 * 1024 * 1024)
+
+struct matrixFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t bom;
+    int32_t type_flag;
+    int32_t layout;
+    uint64_t nrow;
+    uint64_t ncol;
+};
+
+inline size_t
+matrix_file_elem_size(int type_flag)
+{
+    switch(type_flag) {
+        case 4:
+            return sizeof(int);
+        case 6:
+            return sizeof(float);
+        case 8:
+            return sizeof(double);
+        default:
+            throw Rcpp::exception("unknown type detected in matrix file");
+    }
+}
+
+/* Bytes staged per transfer, GPUR_FILE_CHUNK unless the internal option
+ * gpuR.file.chunk asks for less.  The tests shrink it to stream small
+ * matrices in several tiles.
+ */
+inline size_t
+matrix_file_chunk()
+{
+    SEXP opt = Rf_GetOption1(Rf_install("gpuR.file.chunk"));
+    if(Rf_isNumeric(opt) && Rf_length(opt) == 1){
+        const double bytes = Rf_asReal(opt);
+        if(bytes >= 1 && bytes < GPUR_FILE_CHUNK){
+            return (size_t)bytes;
+        }
+    }
+    return GPUR_FILE_CHUNK;
+}
+
+inline matrixFileHeader
+matrix_file_header(int type_flag, size_t nrow, size_t ncol)
+{
+    matrixFileHeader h;
+    std::memset(&h, 0, sizeof(h));
+    std::strcpy(h.magic, GPUR_FILE_MAGIC);
+    h.version = GPUR_FILE_VERSION;
+    h.bom = GPUR_FILE_BOM;
+    h.type_flag = type_flag;
+    h.layout = GPUR_FILE_COL_MAJOR;
+    h.nrow = nrow;
+    h.ncol = ncol;
+    return h;
+}
+
+// whether nrow x ncol elements of 'elem' bytes fit in 'bytes', divided
+// rather than multiplied so huge or corrupt dimensions cannot overflow
+inline bool
+matrix_file_fits(uint64_t nrow, uint64_t ncol, size_t elem, uint64_t bytes)
+{
+    return ncol == 0 || nrow <= bytes / elem / ncol;
+}
+
+// throws unless 'h' heads a file of 'size' bytes this build can read
+inline void
+matrix_file_check(const matrixFileHeader &h, size_t size)
+{
+    if(size < GPUR_FILE_HEADER || std::strncmp(h.magic, GPUR_FILE_MAGIC, 8) != 0){
+        throw Rcpp::exception("not a gpuR matrix file");
+    }
+    if(h.bom != GPUR_FILE_BOM){
+        throw Rcpp::exception("matrix file written with a different byte order");
+    }
+    if(h.version > GPUR_FILE_VERSION || h.layout != GPUR_FILE_COL_MAJOR){
+        throw Rcpp::exception("matrix file written by a newer version of gpuR");
+    }
+    if(!matrix_file_fits(h.nrow, h.ncol, matrix_file_elem_size(h.type_flag), size - GPUR_FILE_HEADER)){
+        throw Rcpp::exception("matrix file is truncated");
+    }
+}
+
+// the header of a new matrix file, padded to the start of the data
+inline void
+matrix_file_write_header(std::ostream &out, int type_flag, size_t nrow, size_t ncol)
+{
+    const matrixFileHeader h = matrix_file_header(type_flag, nrow, ncol);
+    char buf[GPUR_FILE_HEADER] = {0};
+    std::memcpy(buf, &h, sizeof(h));
+    out.write(buf, GPUR_FILE_HEADER);
+}
+
+/* A new file of an nrow x ncol matrix, all zero.  The data is only
+ * extended to its size, so most file systems store it sparse until
+ * written.
+ */
+inline void
+matrix_file_create(const std::string &path, int type_flag, size_t nrow, size_t ncol)
+{
+    // checked before the file is touched, the largest offset a stream
+    // can seek to and a size_t can map bound the data
+    const size_t elem = matrix_file_elem_size(type_flag);
+    const uint64_t limit = std::min<uint64_t>(std::numeric_limits<size_t>::max(),
+                                              std::numeric_limits<std::streamoff>::max());
+    if(!matrix_file_fits(nrow, ncol, elem, limit - GPUR_FILE_HEADER)){
+        throw Rcpp::exception("matrix is too large for a file");
+    }
+
+    std::ofstream out(path.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    if(!out){
+        throw Rcpp::exception(("cannot open file '" + path + "' for writing").c_str());
+    }
+
+    matrix_file_write_header(out, type_flag, nrow, ncol);
+
+    const size_t bytes = nrow * ncol * elem;
+    if(bytes > 0){
+        out.seekp(GPUR_FILE_HEADER + bytes - 1);
+        out.put(0);
+    }
+
+    if(!out){
+        throw Rcpp::exception(("error writing file '" + path + "'").c_str());
+    }
+}
+
+/* A whole file mapped into memory, read-only unless 'writable'.  The
+ * mapping lives as long as the object.
+ */
+class mappedFile {
+    private:
+        char *addr;
+        size_t len;
+#ifdef _WIN32
+        HANDLE file, mapping;
+#else
+        int fd;
+#endif
+        mappedFile(const mappedFile &);
+        mappedFile & operator=(const mappedFile &);
+
+    public:
+        mappedFile(const std::string &path, bool writable = false) : addr(NULL), len(0) {
+#ifdef _WIN32
+            file = CreateFileA(path.c_str(),
+                               writable ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ,
+                               FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                               FILE_ATTRIBUTE_NORMAL, NULL);
+            if(file == INVALID_HANDLE_VALUE){
+                throw Rcpp::exception(("cannot open file '" + path + "'").c_str());
+            }
+            LARGE_INTEGER sz;
+            if(!GetFileSizeEx(file, &sz)){
+                CloseHandle(file);
+                throw Rcpp::exception(("cannot read the size of file '" + path + "'").c_str());
+            }
+            len = (size_t)sz.QuadPart;
+            mapping = len == 0 ? NULL : CreateFileMappingA(file, NULL,
+                writable ? PAGE_READWRITE : PAGE_READONLY, 0, 0, NULL);
+            if(mapping){
+                addr = (char *)MapViewOfFile(mapping,
+                    writable ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, 0);
+            }
+            if(len != 0 && !addr){
+                if(mapping) CloseHandle(mapping);
+                CloseHandle(file);
+                throw Rcpp::exception(("cannot map file '" + path + "'").c_str());
+            }
+#else
+            fd = open(path.c_str(), writable ? O_RDWR : O_RDONLY);
+            if(fd < 0){
+                throw Rcpp::exception(("cannot open file '" + path + "'").c_str());
+            }
+            struct stat st;
+            if(fstat(fd, &st) != 0){
+                close(fd);
+                throw Rcpp::exception(("cannot read the size of file '" + path + "'").c_str());
+            }
+            len = (size_t)st.st_size;
+            if(len != 0){
+                void *p = mmap(NULL, len, writable ? PROT_READ | PROT_WRITE : PROT_READ,
+                               MAP_SHARED, fd, 0);
+                if(p == MAP_FAILED){
+                    close(fd);
+                    throw Rcpp::exception(("cannot map file '" + path + "'").c_str());
+                }
+                addr = (char *)p;
+            }
+#endif
+        }
+
+        ~mappedFile() {
+#ifdef _WIN32
+            if(addr) UnmapViewOfFile(addr);
+            if(mapping) CloseHandle(mapping);
+            CloseHandle(file);
+#else
+            if(addr) munmap(addr, len);
+            close(fd);
+#endif
+        }
+
+        char* data() { return addr; }
+        size_t size() const { return len; }
+
+        // the header of a matrix file, checked against the file size
+        matrixFileHeader header() {
+            matrixFileHeader h;
+            std::memset(&h, 0, sizeof(h));
+            if(len >= sizeof(h)){
+                std::memcpy(&h, addr, sizeof(h));
+            }
+            matrix_file_check(h, len);
+            return h;
+        }
+};
+
+#endif
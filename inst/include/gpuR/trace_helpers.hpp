@@ -0,0 +1,184 @@
+#pragma once
+#ifndef TRACE_HELPERS
+#define TRACE_HELPERS
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// track (thread) ids used on the exported timeline
+#define GPUR_TRACE_R_CALL 1
+#define GPUR_TRACE_STAGING 2
+// device queues are offset by the ViennaCL context id
+#define GPUR_TRACE_QUEUE 100
+
+struct traceEvent {
+    std::string name;
+    std::string cat;
+    int tid;
+    double ts;
+    double dur;
+    double bytes;
+};
+
+/* Collects complete ('X') events for the Chrome trace-event format.
+ * Timestamps are microseconds since the recorder was started.
+ */
+class traceRecorder {
+    private:
+        bool active;
+        std::chrono::steady_clock::time_point origin;
+        std::vector<traceEvent> events;
+        std::vector<std::pair<std::string, double> > open_calls;
+        std::map<int, std::string> tracks;
+        std::map<int, double> queue_idle;
+
+    public:
+        traceRecorder() : active(false) { }
+
+        bool enabled() { return active; }
+
+        void start(){
+            events.clear();
+            open_calls.clear();
+            queue_idle.clear();
+            tracks.clear();
+            tracks[GPUR_TRACE_R_CALL] = "R call";
+            tracks[GPUR_TRACE_STAGING] = "host staging";
+            origin = std::chrono::steady_clock::now();
+            active = true;
+        }
+
+        void stop(){
+            active = false;
+        }
+
+        double now(){
+            return std::chrono::duration<double, std::micro>(
+                std::chrono::steady_clock::now() - origin).count();
+        }
+
+        void record(
+            const std::string &name, const std::string &cat,
+            int tid, double ts, double dur, double bytes = 0)
+        {
+            if(!active) return;
+            traceEvent ev = {name, cat, tid, ts, dur, bytes};
+            events.push_back(ev);
+        }
+
+        void nameTrack(int tid, const std::string &name){
+            tracks[tid] = name;
+        }
+
+        void beginCall(const std::string &name){
+            if(!active) return;
+            open_calls.push_back(std::make_pair(name, now()));
+        }
+
+        // returns the start time of the closed call or -1 if none open
+        double endCall(std::string &name){
+            if(!active || open_calls.empty()) return -1;
+            name = open_calls.back().first;
+            double ts = open_calls.back().second;
+            open_calls.pop_back();
+            record(name, "R", GPUR_TRACE_R_CALL, ts, now() - ts);
+            return ts;
+        }
+
+        // the queue is known to be empty from this point on
+        double queueIdleSince(int tid){
+            std::map<int, double>::iterator it = queue_idle.find(tid);
+            return it == queue_idle.end() ? 0 : it->second;
+        }
+
+        void setQueueIdle(int tid, double ts){
+            queue_idle[tid] = ts;
+        }
+
+        std::string json(){
+            std::ostringstream out;
+            out.precision(3);
+            out << std::fixed;
+            out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+            out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,"
+                << "\"args\":{\"name\":\"gpuR\"}}";
+            for(std::map<int, std::string>::iterator it = tracks.begin(); it != tracks.end(); ++it){
+                out << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << it->first
+                    << ",\"args\":{\"name\":\"" << escape(it->second) << "\"}}";
+                out << ",\n{\"name\":\"thread_sort_index\",\"ph\":\"M\",\"pid\":1,\"tid\":" << it->first
+                    << ",\"args\":{\"sort_index\":" << it->first << "}}";
+            }
+            for(unsigned int i = 0; i < events.size(); i++){
+                out << ",\n{\"name\":\"" << escape(events[i].name)
+                    << "\",\"cat\":\"" << events[i].cat
+                    << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << events[i].tid
+                    << ",\"ts\":" << events[i].ts
+                    << ",\"dur\":" << std::max(events[i].dur, 0.0);
+                if(events[i].bytes > 0){
+                    out << ",\"args\":{\"bytes\":" << std::setprecision(0) << events[i].bytes
+                        << "}" << std::setprecision(3);
+                }
+                out << "}";
+            }
+            out << "\n]}\n";
+            return out.str();
+        }
+
+        static std::string escape(const std::string &s){
+            std::string out;
+            for(unsigned int i = 0; i < s.size(); i++){
+                switch(s[i]){
+                    case '"': out += "\\\""; break;
+                    case '\\': out += "\\\\"; break;
+                    case '\n': out += "\\n"; break;
+                    case '\t': out += "\\t"; break;
+                    default:
+                        if((unsigned char)s[i] < 0x20){
+                            char buf[8];
+                            std::snprintf(buf, sizeof(buf), "\\u%04x", s[i]);
+                            out += buf;
+                        }else{
+                            out += s[i];
+                        }
+                }
+            }
+            return out;
+        }
+};
+
+// single recorder shared by every translation unit
+inline traceRecorder& gpuRTracer(){
+    static traceRecorder recorder;
+    return recorder;
+}
+
+/* Scoped span on the host staging track, e.g. around the
+ * viennacl::copy calls that move data between R/Eigen and the device.
+ * The number of bytes copied is attached to the event.
+ */
+class traceScope {
+    private:
+        const char *name;
+        double bytes;
+        double ts;
+        bool on;
+
+    public:
+        traceScope(const char *name_, double bytes_ = 0) : name(name_), bytes(bytes_), ts(0) {
+            on = gpuRTracer().enabled();
+            if(on) ts = gpuRTracer().now();
+        }
+        ~traceScope(){
+            if(on){
+                gpuRTracer().record(name, "staging", GPUR_TRACE_STAGING, ts, gpuRTracer().now() - ts, bytes);
+            }
+        }
+};
+
+#endif
@@ -0,0 +1,41 @@
+#pragma once
+#ifndef VCL_BLAS_HELPERS
+#define VCL_BLAS_HELPERS
+
+// Device side BLAS shared by the vclMatrix functions and the standalone
+// benchmarks (inst/benchmarks/cpp).  These only depend on ViennaCL so
+// they can be used without R.  Integer matrices go through the 64 bit
+// kernels of vcl_int_kernels.hpp instead.
+
+// Use OpenCL with ViennaCL
+#define VIENNACL_WITH_OPENCL 1
+
+// ViennaCL headers
+#include "viennacl/matrix.hpp"
+#include "viennacl/linalg/prod.hpp"
+
+// C <- A %*% B
+template <typename T, typename MatA, typename MatB, typename MatC>
+void
+vcl_gemm(MatA &vcl_A, MatB &vcl_B, MatC &vcl_C)
+{
+    vcl_C = viennacl::linalg::prod(vcl_A, vcl_B);
+}
+
+// C <- A * B elementwise
+template <typename T, typename MatA, typename MatB, typename MatC>
+void
+vcl_elem_prod(MatA &vcl_A, MatB &vcl_B, MatC &vcl_C)
+{
+    vcl_C = viennacl::linalg::element_prod(vcl_A, vcl_B);
+}
+
+// B <- B + alpha * A
+template <typename T, typename MatA, typename MatB>
+void
+vcl_axpy(T alpha, MatA &vcl_A, MatB &vcl_B)
+{
+    vcl_B += alpha * vcl_A;
+}
+
+#endif
@@ -0,0 +1,40 @@
+#pragma once
+#ifndef VCL_EIGEN_COPY
+#define VCL_EIGEN_COPY
+
+#include <RcppEigen.h>
+
+#include <vector>
+
+// host <-> device block copies
+#include "gpuR/vcl_rect_copy.hpp"
+
+/* Small device matrices to and from double precision Eigen matrices, for
+ * the projected problems the iterative methods solve on the host.
+ */
+template <typename T, typename MatA>
+Eigen::MatrixXd
+vcl_to_eigen(MatA &vcl_A)
+{
+    const size_t nr = vcl_A.size1();
+    const size_t nc = vcl_A.size2();
+
+    std::vector<T> buf(nr * nc);
+    vcl_read_block(vcl_A, &buf[0], nr);
+
+    return Eigen::Map<Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> >(
+        &buf[0], nr, nc).template cast<double>();
+}
+
+template <typename T>
+viennacl::matrix<T>
+vcl_from_eigen(const Eigen::MatrixXd &A)
+{
+    Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> buf = A.template cast<T>();
+
+    viennacl::matrix<T> vcl_A(A.rows(), A.cols());
+    vcl_write_block(buf.data(), A.rows(), vcl_A);
+    return vcl_A;
+}
+
+#endif
@@ -0,0 +1,374 @@
+#pragma once
+#ifndef VCL_FACTOR
+#define VCL_FACTOR
+
+// Use OpenCL with ViennaCL
+#define VIENNACL_WITH_OPENCL 1
+
+// ViennaCL headers
+#include "viennacl/ocl/backend.hpp"
+#include "viennacl/ocl/context.hpp"
+#include "viennacl/ocl/kernel.hpp"
+#include "viennacl/ocl/utils.hpp"
+#include "viennacl/matrix.hpp"
+#include "viennacl/matrix_proxy.hpp"
+#include "viennacl/vector_proxy.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/inner_prod.hpp"
+#include "viennacl/linalg/direct_solve.hpp"
+#include "viennacl/linalg/qr.hpp"
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+// vclLayout and the launch size of the elementwise kernels
+#include "gpuR/vcl_mask_kernels.hpp"
+// host <-> device block copies
+#include "gpuR/vcl_rect_copy.hpp"
+
+// columns per panel of the blocked factorizations
+#define GPUR_FACTOR_BLOCK 64
+
+/* Dense factorizations on the device.
+ *
+ * Cholesky and LU are right-looking blocked algorithms: each panel is
+ * factored on the host, it is only GPUR_FACTOR_BLOCK columns wide, and
+ * the trailing matrix is updated with ViennaCL's triangular solves and
+ * products.  LU uses partial pivoting, the row interchanges of a panel
+ * are applied to the rest of the matrix in a single kernel launch.  QR
+ * is ViennaCL's blocked Householder inplace_qr, Q is never formed
+ * unless asked for.
+ */
+template <typename T>
+struct vclFactorKernels {
+
+    static std::string program_name(){
+        return viennacl::ocl::type_to_string<T>::apply() + "_gpuR_factor";
+    }
+
+    static std::string source(viennacl::ocl::context &ctx){
+        const std::string type = viennacl::ocl::type_to_string<T>::apply();
+        std::string src;
+
+        if(type == "double"){
+            src += "#pragma OPENCL EXTENSION " + ctx.current_device().double_support_extension() + " : enable\n";
+        }
+        src += "#define T " + type + "\n";
+
+        src +=
+            "#define AT(i, j) A[off + (i) * rs + (j) * cs]\n"
+            "\n"
+            // rows first + k and ipiv[k] swapped in turn, k < count, in
+            // every column outside [skip_begin, skip_end)
+            "__kernel void swap_rows(\n"
+            "    __global T *A, uint off, uint rs, uint cs, uint size2,\n"
+            "    __global const uint *ipiv, uint first, uint count,\n"
+            "    uint skip_begin, uint skip_end)\n"
+            "{\n"
+            "    for(uint j = get_global_id(0); j < size2; j += get_global_size(0)){\n"
+            "        if(j >= skip_begin && j < skip_end) continue;\n"
+            "        for(uint k = 0; k < count; k++){\n"
+            "            const uint r = first + k;\n"
+            "            const uint p = ipiv[k];\n"
+            "            if(p != r){\n"
+            "                const T tmp = AT(r, j);\n"
+            "                AT(r, j) = AT(p, j);\n"
+            "                AT(p, j) = tmp;\n"
+            "            }\n"
+            "        }\n"
+            "    }\n"
+            "}\n"
+            "\n"
+            "__kernel void zero_lower(\n"
+            "    __global T *A, uint off, uint rs, uint cs,\n"
+            "    uint size1, uint size2)\n"
+            "{\n"
+            "    const uint n = size1 * size2;\n"
+            "    for(uint k = get_global_id(0); k < n; k += get_global_size(0)){\n"
+            "        const uint i = k % size1;\n"
+            "        const uint j = k / size1;\n"
+            "        if(i > j) AT(i, j) = 0;\n"
+            "    }\n"
+            "}\n";
+
+        return src;
+    }
+
+    static void init(viennacl::ocl::context &ctx){
+        if(!ctx.has_program(program_name())){
+            ctx.add_program(source(ctx), program_name());
+        }
+    }
+
+    static viennacl::ocl::kernel & get(viennacl::ocl::context &ctx, const std::string &name){
+        init(ctx);
+        return ctx.get_kernel(program_name(), name);
+    }
+};
+
+/* rows first + k <-> ipiv[first + k] (0-based) of A for k < count,
+ * outside columns [skip_begin, skip_end) */
+template <typename T>
+void
+vcl_swap_rows(
+    const viennacl::ocl::handle<cl_mem> &A, const vclLayout &la,
+    const std::vector<cl_uint> &ipiv, size_t first, size_t count,
+    cl_uint skip_begin, cl_uint skip_end)
+{
+    if(count == 0) return;
+
+    viennacl::ocl::context &ctx = viennacl::ocl::current_context();
+    viennacl::ocl::kernel &k = vclFactorKernels<T>::get(ctx, "swap_rows");
+    vcl_mask_range(k, la.size2);
+
+    viennacl::backend::mem_handle vcl_ipiv;
+    viennacl::backend::memory_create(vcl_ipiv, sizeof(cl_uint) * count,
+                                     viennacl::context(ctx), &ipiv[first]);
+
+    viennacl::ocl::enqueue(k(
+        A, la.offset, la.row_stride, la.col_stride, la.size2,
+        vcl_ipiv.opencl_handle(), cl_uint(first), cl_uint(count),
+        skip_begin, skip_end));
+}
+
+/* zero the strictly lower triangle */
+template <typename T, typename MatA>
+void
+vcl_zero_lower(MatA &vcl_A)
+{
+    const vclLayout l = vcl_matrix_layout(vcl_A);
+
+    viennacl::ocl::context &ctx = viennacl::ocl::current_context();
+    viennacl::ocl::kernel &k = vclFactorKernels<T>::get(ctx, "zero_lower");
+    vcl_mask_range(k, l.size1 * l.size2);
+
+    viennacl::ocl::enqueue(k(
+        vcl_A.handle().opencl_handle(), l.offset, l.row_stride, l.col_stride,
+        l.size1, l.size2));
+}
+
+/* A <- R, the upper Cholesky factor t(R) %*% R = A, from the upper
+ * triangle of A.  Returns 0 or the order of the leading minor that is
+ * not positive definite.
+ */
+template <typename T>
+int
+vcl_chol(viennacl::matrix<T> &A)
+{
+    const size_t n = A.size1();
+
+    for(size_t k = 0; k < n; k += GPUR_FACTOR_BLOCK){
+        const size_t nb = std::min((size_t)GPUR_FACTOR_BLOCK, n - k);
+        viennacl::range rk(k, k + nb);
+
+        viennacl::matrix_range<viennacl::matrix<T> > A11(A, rk, rk);
+
+        // diagonal block on the host, column-major
+        std::vector<T> D(nb * nb);
+        vcl_read_block(A11, &D[0], nb);
+
+        for(size_t j = 0; j < nb; j++){
+            T s = D[j + j * nb];
+            for(size_t i = 0; i < j; i++){
+                s -= D[i + j * nb] * D[i + j * nb];
+            }
+            if(!(s > 0)){
+                return (int)(k + j + 1);
+            }
+            D[j + j * nb] = std::sqrt(s);
+
+            for(size_t c = j + 1; c < nb; c++){
+                T u = D[j + c * nb];
+                for(size_t i = 0; i < j; i++){
+                    u -= D[i + j * nb] * D[i + c * nb];
+                }
+                D[j + c * nb] = u / D[j + j * nb];
+            }
+        }
+        vcl_write_block(&D[0], nb, A11);
+
+        if(k + nb < n){
+            viennacl::range rest(k + nb, n);
+            viennacl::matrix_range<viennacl::matrix<T> > A12(A, rk, rest);
+            viennacl::matrix_range<viennacl::matrix<T> > A22(A, rest, rest);
+
+            // R12 = t(R11)^-1 A12, A22 <- A22 - t(R12) R12
+            viennacl::linalg::inplace_solve(viennacl::trans(A11), A12, viennacl::linalg::lower_tag());
+            A22 -= viennacl::linalg::prod(viennacl::trans(A12), A12);
+        }
+    }
+
+    vcl_zero_lower<T>(A);
+
+    return 0;
+}
+
+/* A <- L U (unit lower L below the diagonal) with row interchanges
+ * ipiv (0-based, row k was swapped with ipiv[k]).  Returns false if U
+ * has a zero on the diagonal.
+ */
+template <typename T>
+bool
+vcl_lu(viennacl::matrix<T> &A, std::vector<cl_uint> &ipiv)
+{
+    const size_t n = A.size1();
+    const vclLayout la = vcl_matrix_layout(A);
+    bool nonsingular = true;
+
+    ipiv.resize(n);
+
+    for(size_t k = 0; k < n; k += GPUR_FACTOR_BLOCK){
+        const size_t nb = std::min((size_t)GPUR_FACTOR_BLOCK, n - k);
+        const size_t m = n - k;
+        viennacl::range rk(k, k + nb);
+
+        // panel A[k:n, k:k+nb] on the host, column-major
+        viennacl::matrix_range<viennacl::matrix<T> > panel(A, viennacl::range(k, n), rk);
+        std::vector<T> P(m * nb);
+        vcl_read_block(panel, &P[0], m);
+
+        for(size_t j = 0; j < nb; j++){
+            size_t p = j;
+            T amax = std::fabs(P[j + j * m]);
+            for(size_t i = j + 1; i < m; i++){
+                if(std::fabs(P[i + j * m]) > amax){
+                    amax = std::fabs(P[i + j * m]);
+                    p = i;
+                }
+            }
+            ipiv[k + j] = (cl_uint)(k + p);
+
+            if(amax == 0){
+                nonsingular = false;
+                continue;
+            }
+            if(p != j){
+                for(size_t c = 0; c < nb; c++){
+                    std::swap(P[j + c * m], P[p + c * m]);
+                }
+            }
+
+            const T d = P[j + j * m];
+            for(size_t i = j + 1; i < m; i++){
+                P[i + j * m] /= d;
+            }
+            for(size_t c = j + 1; c < nb; c++){
+                const T u = P[j + c * m];
+                for(size_t i = j + 1; i < m; i++){
+                    P[i + c * m] -= P[i + j * m] * u;
+                }
+            }
+        }
+        vcl_write_block(&P[0], m, panel);
+
+        // the panel's interchanges in the columns left and right of it
+        vcl_swap_rows<T>(A.handle().opencl_handle(), la, ipiv, k, nb,
+                         (cl_uint)k, (cl_uint)(k + nb));
+
+        if(k + nb < n){
+            viennacl::range rest(k + nb, n);
+            viennacl::matrix_range<viennacl::matrix<T> > A11(A, rk, rk);
+            viennacl::matrix_range<viennacl::matrix<T> > A12(A, rk, rest);
+            viennacl::matrix_range<viennacl::matrix<T> > A21(A, rest, rk);
+            viennacl::matrix_range<viennacl::matrix<T> > A22(A, rest, rest);
+
+            // U12 = L11^-1 A12, A22 <- A22 - L21 U12
+            viennacl::linalg::inplace_solve(A11, A12, viennacl::linalg::unit_lower_tag());
+            A22 -= viennacl::linalg::prod(A21, A12);
+        }
+    }
+
+    return nonsingular;
+}
+
+/* B <- A^-1 B from the LU factors of A, B a matrix or a vector with
+ * layout lb */
+template <typename T, typename LU, typename MatB>
+void
+vcl_lu_solve(LU &vcl_LU, const std::vector<cl_uint> &ipiv, MatB &B, const vclLayout &lb)
+{
+    vcl_swap_rows<T>(B.handle().opencl_handle(), lb, ipiv, 0, ipiv.size(), 0, 0);
+    viennacl::linalg::inplace_solve(vcl_LU, B, viennacl::linalg::unit_lower_tag());
+    viennacl::linalg::inplace_solve(vcl_LU, B, viennacl::linalg::upper_tag());
+}
+
+/* log of the absolute determinant and its sign from the LU factors */
+template <typename T, typename LU>
+void
+vcl_lu_det(LU &vcl_LU, const std::vector<cl_uint> &ipiv, double &modulus, int &sign)
+{
+    const size_t n = vcl_LU.size1();
+
+    viennacl::vector<T> vcl_d = viennacl::diag(vcl_LU);
+    std::vector<T> d(n);
+    viennacl::copy(vcl_d, d);
+
+    modulus = 0;
+    sign = 1;
+    for(size_t i = 0; i < n; i++){
+        if(d[i] < 0) sign = -sign;
+        if(ipiv[i] != i) sign = -sign;
+        modulus += std::log(std::fabs((double)d[i]));
+    }
+}
+
+/* Householder vector j of a compact QR: zero above row j, 1 at row j */
+template <typename T, typename QR>
+viennacl::vector<T>
+vcl_householder(QR &vcl_QR, size_t j)
+{
+    viennacl::vector<T> v = viennacl::column(vcl_QR, (unsigned int)j);
+    if(j > 0){
+        viennacl::vector_range<viennacl::vector<T> > head(v, viennacl::range(0, j));
+        head.clear();
+    }
+    v[j] = T(1);
+    return v;
+}
+
+/* B <- H_j B for j = first, ..., last in that order (Q^T B when
+ * ascending, Q B when descending), H_j = I - beta_j v_j t(v_j) */
+template <typename T, typename QR, typename MatB>
+void
+vcl_apply_householder(QR &vcl_QR, const std::vector<T> &betas, MatB &B, bool transpose)
+{
+    const size_t k = betas.size();
+
+    for(size_t s = 0; s < k; s++){
+        const size_t j = transpose ? s : k - 1 - s;
+        viennacl::vector<T> v = vcl_householder<T>(vcl_QR, j);
+        viennacl::vector<T> w = viennacl::linalg::prod(viennacl::trans(B), v);
+        B -= betas[j] * viennacl::linalg::outer_prod(v, w);
+    }
+}
+
+/* the thin Q (m x n) of an m x n compact QR */
+template <typename T, typename QR>
+viennacl::matrix<T>
+vcl_thin_q(QR &vcl_QR, const std::vector<T> &betas)
+{
+    const size_t m = vcl_QR.size1();
+    const size_t n = vcl_QR.size2();
+    viennacl::range rn(0, n);
+
+    viennacl::matrix<T> vcl_Q = viennacl::zero_matrix<T>(m, n);
+    viennacl::matrix_range<viennacl::matrix<T> > top(vcl_Q, rn, rn);
+    top = viennacl::matrix<T>(viennacl::identity_matrix<T>(n));
+
+    vcl_apply_householder(vcl_QR, betas, vcl_Q, false);
+
+    return vcl_Q;
+}
+
+/* Y <- an orthonormal basis of its columns, Y has at least as many rows
+ * as columns */
+template <typename T>
+void
+vcl_orthonormalize(viennacl::matrix<T> &Y)
+{
+    std::vector<T> betas = viennacl::linalg::inplace_qr(Y);
+    Y = vcl_thin_q(Y, betas);
+}
+
+#endif
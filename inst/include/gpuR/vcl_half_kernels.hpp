@@ -0,0 +1,339 @@
+#pragma once
+#ifndef VCL_HALF_KERNELS
+#define VCL_HALF_KERNELS
+
+// Use OpenCL with ViennaCL
+#define VIENNACL_WITH_OPENCL 1
+
+// ViennaCL headers
+#include "viennacl/ocl/backend.hpp"
+#include "viennacl/ocl/context.hpp"
+#include "viennacl/ocl/kernel.hpp"
+#include "viennacl/ocl/utils.hpp"
+#include "viennacl/matrix.hpp"
+#include "viennacl/vector.hpp"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+// vclLayout and the launch size of the elementwise kernels
+#include "gpuR/vcl_mask_kernels.hpp"
+
+// the Arith group operators of half precision objects
+#define GPUR_HALF_ADD 0
+#define GPUR_HALF_SUB 1
+#define GPUR_HALF_MUL 2
+#define GPUR_HALF_POW 3
+#define GPUR_HALF_DIV 4
+
+// tile edge of the half GEMM
+#define GPUR_HALF_TILE 16
+
+/* Half precision storage with float compute.
+ *
+ * vload_half and vstore_half are core OpenCL, unlike half arithmetic
+ * (cl_khr_fp16), so they work on every device including the CPU
+ * runtimes.  Every kernel loads halves to float, computes in float and,
+ * for half results, rounds to nearest even on the store.  Sums
+ * accumulate in float.  Half buffers are dense and column-major, float
+ * operands are addressed through a vclLayout.  The GEMM stages tiles of
+ * its operands as float in local memory, so no float copy of a matrix
+ * is ever made on the device.
+ */
+struct vclHalfKernels {
+
+    static std::string program_name(){
+        return "gpuR_half";
+    }
+
+    static std::string source(){
+        std::string src;
+
+        // the launch sizes of the host
+        src += "#define WG " GPUR_STR(GPUR_MASK_WG) "\n";
+        src += "#define TILE " GPUR_STR(GPUR_HALF_TILE) "\n";
+
+        src +=
+            "float half_op(float a, float b, uint op)\n"
+            "{\n"
+            "    switch(op){\n"
+            "        case 0: return a + b;\n"
+            "        case 1: return a - b;\n"
+            "        case 2: return a * b;\n"
+            "        case 3: return pow(a, b);\n"
+            "        default: return a / b;\n"
+            "    }\n"
+            "}\n"
+            "\n"
+            // H <- A, column-major
+            "__kernel void to_half(\n"
+            "    __global const float *A, uint off, uint rs, uint cs,\n"
+            "    uint size1, uint size2,\n"
+            "    __global half *H)\n"
+            "{\n"
+            "    const uint n = size1 * size2;\n"
+            "    for(uint k = get_global_id(0); k < n; k += get_global_size(0)){\n"
+            "        const uint i = k % size1;\n"
+            "        const uint j = k / size1;\n"
+            "        vstore_half_rte(A[off + i * rs + j * cs], k, H);\n"
+            "    }\n"
+            "}\n"
+            "\n"
+            // A <- H
+            "__kernel void from_half(\n"
+            "    __global const half *H,\n"
+            "    __global float *A, uint off, uint rs, uint cs,\n"
+            "    uint size1, uint size2)\n"
+            "{\n"
+            "    const uint n = size1 * size2;\n"
+            "    for(uint k = get_global_id(0); k < n; k += get_global_size(0)){\n"
+            "        const uint i = k % size1;\n"
+            "        const uint j = k / size1;\n"
+            "        A[off + i * rs + j * cs] = vload_half(k, H);\n"
+            "    }\n"
+            "}\n"
+            "\n"
+            // C <- A op B
+            "__kernel void elementwise(\n"
+            "    __global const half *A, __global const half *B,\n"
+            "    __global half *C, uint n, uint op)\n"
+            "{\n"
+            "    for(uint k = get_global_id(0); k < n; k += get_global_size(0)){\n"
+            "        vstore_half_rte(half_op(vload_half(k, A), vload_half(k, B), op), k, C);\n"
+            "    }\n"
+            "}\n"
+            "\n"
+            // C <- A op s, or s op A when left
+            "__kernel void scalar_op(\n"
+            "    __global const half *A, float s, uint left,\n"
+            "    __global half *C, uint n, uint op)\n"
+            "{\n"
+            "    for(uint k = get_global_id(0); k < n; k += get_global_size(0)){\n"
+            "        const float a = vload_half(k, A);\n"
+            "        vstore_half_rte(left ? half_op(s, a, op) : half_op(a, s, op), k, C);\n"
+            "    }\n"
+            "}\n"
+            "\n"
+            // S[j] <- sum of column j, one work-group per contiguous column
+            "__kernel void col_sums(\n"
+            "    __global const half *A, uint size1, uint size2,\n"
+            "    __global float *S, uint off, uint inc)\n"
+            "{\n"
+            "    __local float ls[WG];\n"
+            "    const uint lid = get_local_id(0);\n"
+            "    for(uint j = get_group_id(0); j < size2; j += get_num_groups(0)){\n"
+            "        float acc = 0;\n"
+            "        for(uint i = lid; i < size1; i += WG){\n"
+            "            acc += vload_half(j * size1 + i, A);\n"
+            "        }\n"
+            "        ls[lid] = acc;\n"
+            "        for(uint stride = WG / 2; stride > 0; stride >>= 1){\n"
+            "            barrier(CLK_LOCAL_MEM_FENCE);\n"
+            "            if(lid < stride) ls[lid] += ls[lid + stride];\n"
+            "        }\n"
+            "        if(lid == 0) S[off + j * inc] = ls[0];\n"
+            "        barrier(CLK_LOCAL_MEM_FENCE);\n"
+            "    }\n"
+            "}\n"
+            "\n"
+            // S[i] <- sum of row i, neighbouring work-items read
+            // neighbouring elements of each column
+            "__kernel void row_sums(\n"
+            "    __global const half *A, uint size1, uint size2,\n"
+            "    __global float *S, uint off, uint inc)\n"
+            "{\n"
+            "    for(uint i = get_global_id(0); i < size1; i += get_global_size(0)){\n"
+            "        float acc = 0;\n"
+            "        for(uint j = 0; j < size2; j++){\n"
+            "            acc += vload_half(j * size1 + i, A);\n"
+            "        }\n"
+            "        S[off + i * inc] = acc;\n"
+            "    }\n"
+            "}\n"
+            "\n"
+            // C <- A B over TILE x TILE tiles of float, A is M x K and
+            // B K x N.  Dimension 0 runs down the columns, which are
+            // contiguous, and the product is rounded once on the store.
+            "__kernel void gemm(\n"
+            "    __global const half *A, __global const half *B,\n"
+            "    __global half *C, uint M, uint N, uint K)\n"
+            "{\n"
+            "    __local float As[TILE][TILE];\n"
+            "    __local float Bs[TILE][TILE];\n"
+            "\n"
+            "    const uint li = get_local_id(0);\n"
+            "    const uint lj = get_local_id(1);\n"
+            "    const uint i = get_global_id(0);\n"
+            "    const uint j = get_global_id(1);\n"
+            "\n"
+            "    float acc = 0;\n"
+            "    for(uint t = 0; t < K; t += TILE){\n"
+            "        As[lj][li] = (i < M && t + lj < K) ? vload_half((t + lj) * M + i, A) : 0;\n"
+            "        Bs[lj][li] = (t + li < K && j < N) ? vload_half(j * K + t + li, B) : 0;\n"
+            "        barrier(CLK_LOCAL_MEM_FENCE);\n"
+            "\n"
+            "        for(uint kk = 0; kk < TILE; kk++){\n"
+            "            acc += As[kk][li] * Bs[lj][kk];\n"
+            "        }\n"
+            "        barrier(CLK_LOCAL_MEM_FENCE);\n"
+            "    }\n"
+            "\n"
+            "    if(i < M && j < N){\n"
+            "        vstore_half_rte(acc, j * M + i, C);\n"
+            "    }\n"
+            "}\n"
+            "\n"
+            // P[g] <- the sum of every global size'th element from g
+            "__kernel void partial_sums(\n"
+            "    __global const half *A, uint n,\n"
+            "    __global float *P)\n"
+            "{\n"
+            "    const uint g = get_global_id(0);\n"
+            "    float acc = 0;\n"
+            "    for(uint k = g; k < n; k += get_global_size(0)){\n"
+            "        acc += vload_half(k, A);\n"
+            "    }\n"
+            "    P[g] = acc;\n"
+            "}\n";
+
+        return src;
+    }
+
+    static void init(viennacl::ocl::context &ctx){
+        if(!ctx.has_program(program_name())){
+            ctx.add_program(source(), program_name());
+        }
+    }
+
+    static viennacl::ocl::kernel & get(viennacl::ocl::context &ctx, const std::string &name){
+        init(ctx);
+        return ctx.get_kernel(program_name(), name);
+    }
+};
+
+/* H <- A, A float with n = la.size1 * la.size2 elements */
+inline void
+vcl_to_half(
+    const viennacl::ocl::handle<cl_mem> &A, const vclLayout &la,
+    const viennacl::ocl::handle<cl_mem> &H)
+{
+    viennacl::ocl::context &ctx = viennacl::ocl::current_context();
+    viennacl::ocl::kernel &k = vclHalfKernels::get(ctx, "to_half");
+    vcl_mask_range(k, la.size1 * la.size2);
+
+    viennacl::ocl::enqueue(k(
+        A, la.offset, la.row_stride, la.col_stride, la.size1, la.size2,
+        H));
+}
+
+/* A <- H */
+inline void
+vcl_from_half(
+    const viennacl::ocl::handle<cl_mem> &H,
+    const viennacl::ocl::handle<cl_mem> &A, const vclLayout &la)
+{
+    viennacl::ocl::context &ctx = viennacl::ocl::current_context();
+    viennacl::ocl::kernel &k = vclHalfKernels::get(ctx, "from_half");
+    vcl_mask_range(k, la.size1 * la.size2);
+
+    viennacl::ocl::enqueue(k(
+        H,
+        A, la.offset, la.row_stride, la.col_stride, la.size1, la.size2));
+}
+
+/* C <- A op B, all n halves */
+inline void
+vcl_half_elementwise(
+    const viennacl::ocl::handle<cl_mem> &A,
+    const viennacl::ocl::handle<cl_mem> &B,
+    const viennacl::ocl::handle<cl_mem> &C,
+    unsigned int n, unsigned int op)
+{
+    viennacl::ocl::context &ctx = viennacl::ocl::current_context();
+    viennacl::ocl::kernel &k = vclHalfKernels::get(ctx, "elementwise");
+    vcl_mask_range(k, n);
+
+    viennacl::ocl::enqueue(k(A, B, C, cl_uint(n), cl_uint(op)));
+}
+
+/* C <- A op scalar, or scalar op A when left */
+inline void
+vcl_half_scalar(
+    const viennacl::ocl::handle<cl_mem> &A,
+    float scalar, bool left,
+    const viennacl::ocl::handle<cl_mem> &C,
+    unsigned int n, unsigned int op)
+{
+    viennacl::ocl::context &ctx = viennacl::ocl::current_context();
+    viennacl::ocl::kernel &k = vclHalfKernels::get(ctx, "scalar_op");
+    vcl_mask_range(k, n);
+
+    viennacl::ocl::enqueue(k(A, cl_float(scalar), cl_uint(left), C, cl_uint(n), cl_uint(op)));
+}
+
+/* S <- the column (or row when byRow) sums of the size1 x size2 A */
+inline void
+vcl_half_margin_sums(
+    const viennacl::ocl::handle<cl_mem> &A,
+    unsigned int size1, unsigned int size2, bool byRow,
+    const viennacl::ocl::handle<cl_mem> &S, const vclLayout &ls)
+{
+    viennacl::ocl::context &ctx = viennacl::ocl::current_context();
+    viennacl::ocl::kernel &k = vclHalfKernels::get(ctx, byRow ? "row_sums" : "col_sums");
+
+    if(byRow){
+        vcl_mask_range(k, size1);
+    }else{
+        k.local_work_size(0, GPUR_MASK_WG);
+        k.global_work_size(0, GPUR_MASK_WG * std::max(1u, std::min(size2, 4096u)));
+    }
+
+    viennacl::ocl::enqueue(k(
+        A, cl_uint(size1), cl_uint(size2),
+        S, ls.offset, ls.row_stride));
+}
+
+/* C <- A B for the M x K A and K x N B, C must not be A or B */
+inline void
+vcl_half_gemm(
+    const viennacl::ocl::handle<cl_mem> &A,
+    const viennacl::ocl::handle<cl_mem> &B,
+    const viennacl::ocl::handle<cl_mem> &C,
+    unsigned int M, unsigned int N, unsigned int K)
+{
+    viennacl::ocl::context &ctx = viennacl::ocl::current_context();
+    viennacl::ocl::kernel &k = vclHalfKernels::get(ctx, "gemm");
+
+    k.local_work_size(0, GPUR_HALF_TILE);
+    k.local_work_size(1, GPUR_HALF_TILE);
+    k.global_work_size(0, GPUR_HALF_TILE * std::max(1u, (M + GPUR_HALF_TILE - 1) / GPUR_HALF_TILE));
+    k.global_work_size(1, GPUR_HALF_TILE * std::max(1u, (N + GPUR_HALF_TILE - 1) / GPUR_HALF_TILE));
+
+    viennacl::ocl::enqueue(k(A, B, C, cl_uint(M), cl_uint(N), cl_uint(K)));
+}
+
+/* the sum of all n halves, from float partial sums added on the host */
+inline double
+vcl_half_sum(const viennacl::ocl::handle<cl_mem> &A, unsigned int n)
+{
+    viennacl::ocl::context &ctx = viennacl::ocl::current_context();
+    viennacl::ocl::kernel &k = vclHalfKernels::get(ctx, "partial_sums");
+    vcl_mask_range(k, n);
+
+    const size_t groups = k.global_work_size(0);
+    viennacl::vector<float> partial(groups);
+
+    viennacl::ocl::enqueue(k(A, cl_uint(n), partial.handle().opencl_handle()));
+
+    std::vector<float> host(groups);
+    viennacl::copy(partial, host);
+
+    double total = 0;
+    for(size_t g = 0; g < groups; g++){
+        total += host[g];
+    }
+    return total;
+}
+
+#endif
@@ -0,0 +1,341 @@
+#pragma once
+#ifndef VCL_INDEX_KERNELS
+#define VCL_INDEX_KERNELS
+
+// Use OpenCL with ViennaCL
+#define VIENNACL_WITH_OPENCL 1
+
+// ViennaCL headers
+#include "viennacl/ocl/backend.hpp"
+#include "viennacl/ocl/context.hpp"
+#include "viennacl/ocl/kernel.hpp"
+#include "viennacl/ocl/utils.hpp"
+#include "viennacl/matrix.hpp"
+#include "viennacl/vector.hpp"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+// work-group size and maximum number of work-groups of the index kernels
+#define GPUR_INDEX_WG 128
+#define GPUR_INDEX_MAX_GROUPS 4096
+
+/* OpenCL gather/scatter for indexed access to a vclMatrix (or block)
+ * and vclVector (or slice).
+ *
+ * Indices are zero based and are uploaded in a single buffer so that
+ * an indexed read or write costs one transfer each way and one kernel
+ * launch rather than one blocking transfer per element.  Matrix
+ * results are written in R's column-major order and replacement
+ * values are recycled as in R.  Scatters do not order duplicated
+ * indices, callers drop all but the last occurrence beforehand.
+ */
+template <typename T>
+struct vclIndexKernels {
+
+    static std::string program_name(){
+        return viennacl::ocl::type_to_string<T>::apply() + "_gpuR_index";
+    }
+
+    static std::string source(viennacl::ocl::context &ctx){
+        const std::string type = viennacl::ocl::type_to_string<T>::apply();
+        std::string src;
+
+        if(type == "double"){
+            src += "#pragma OPENCL EXTENSION " + ctx.current_device().double_support_extension() + " : enable\n";
+        }
+        src += "#define T " + type + "\n";
+
+        src +=
+            "\n"
+            "__kernel void gather_2d(\n"
+            "    __global const T *A, uint start1, uint start2, uint internal_size2,\n"
+            "    __global const uint *rows, uint n_rows,\n"
+            "    __global const uint *cols, uint n_cols,\n"
+            "    __global T *out)\n"
+            "{\n"
+            "    const uint n = n_rows * n_cols;\n"
+            "    for(uint k = get_global_id(0); k < n; k += get_global_size(0)){\n"
+            "        const uint i = k % n_rows;\n"
+            "        const uint j = k / n_rows;\n"
+            "        out[k] = A[(start1 + rows[i]) * internal_size2 + start2 + cols[j]];\n"
+            "    }\n"
+            "}\n"
+            "\n"
+            "__kernel void scatter_2d(\n"
+            "    __global T *A, uint start1, uint start2, uint internal_size2,\n"
+            "    __global const uint *rows, uint n_rows,\n"
+            "    __global const uint *cols, uint n_cols,\n"
+            "    __global const T *vals, uint n_vals)\n"
+            "{\n"
+            "    const uint n = n_rows * n_cols;\n"
+            "    for(uint k = get_global_id(0); k < n; k += get_global_size(0)){\n"
+            "        const uint i = k % n_rows;\n"
+            "        const uint j = k / n_rows;\n"
+            "        A[(start1 + rows[i]) * internal_size2 + start2 + cols[j]] = vals[k % n_vals];\n"
+            "    }\n"
+            "}\n"
+            "\n"
+            // linear column-major indices into the matrix
+            "__kernel void gather_1d(\n"
+            "    __global const T *A, uint start1, uint start2, uint internal_size2, uint size1,\n"
+            "    __global const uint *idx, uint n,\n"
+            "    __global T *out)\n"
+            "{\n"
+            "    for(uint k = get_global_id(0); k < n; k += get_global_size(0)){\n"
+            "        const uint i = idx[k] % size1;\n"
+            "        const uint j = idx[k] / size1;\n"
+            "        out[k] = A[(start1 + i) * internal_size2 + start2 + j];\n"
+            "    }\n"
+            "}\n"
+            "\n"
+            "__kernel void scatter_1d(\n"
+            "    __global T *A, uint start1, uint start2, uint internal_size2, uint size1,\n"
+            "    __global const uint *idx, uint n,\n"
+            "    __global const T *vals, uint n_vals)\n"
+            "{\n"
+            "    for(uint k = get_global_id(0); k < n; k += get_global_size(0)){\n"
+            "        const uint i = idx[k] % size1;\n"
+            "        const uint j = idx[k] / size1;\n"
+            "        A[(start1 + i) * internal_size2 + start2 + j] = vals[k % n_vals];\n"
+            "    }\n"
+            "}\n"
+            "\n"
+            // a column is strided in the row-major storage
+            "__kernel void set_col(\n"
+            "    __global T *A, uint start1, uint start2, uint internal_size2, uint size1,\n"
+            "    uint col, __global const T *vals)\n"
+            "{\n"
+            "    for(uint i = get_global_id(0); i < size1; i += get_global_size(0)){\n"
+            "        A[(start1 + i) * internal_size2 + start2 + col] = vals[i];\n"
+            "    }\n"
+            "}\n"
+            "\n"
+            "__kernel void vec_gather(\n"
+            "    __global const T *v, uint start, uint stride,\n"
+            "    __global const uint *idx, uint n,\n"
+            "    __global T *out)\n"
+            "{\n"
+            "    for(uint k = get_global_id(0); k < n; k += get_global_size(0)){\n"
+            "        out[k] = v[start + idx[k] * stride];\n"
+            "    }\n"
+            "}\n"
+            "\n"
+            "__kernel void vec_scatter(\n"
+            "    __global T *v, uint start, uint stride,\n"
+            "    __global const uint *idx, uint n,\n"
+            "    __global const T *vals, uint n_vals)\n"
+            "{\n"
+            "    for(uint k = get_global_id(0); k < n; k += get_global_size(0)){\n"
+            "        v[start + idx[k] * stride] = vals[k % n_vals];\n"
+            "    }\n"
+            "}\n";
+
+        return src;
+    }
+
+    static void init(viennacl::ocl::context &ctx){
+        if(!ctx.has_program(program_name())){
+            ctx.add_program(source(ctx), program_name());
+        }
+    }
+
+    // kernel for n work items on the context of the object
+    static viennacl::ocl::kernel & get(viennacl::ocl::context &ctx, const std::string &name, unsigned int n){
+        init(ctx);
+        viennacl::ocl::kernel &k = ctx.get_kernel(program_name(), name);
+        k.local_work_size(0, GPUR_INDEX_WG);
+        k.global_work_size(0, GPUR_INDEX_WG * std::max(1u, std::min(
+            (n + GPUR_INDEX_WG - 1) / GPUR_INDEX_WG, (unsigned int)GPUR_INDEX_MAX_GROUPS)));
+        return k;
+    }
+};
+
+// the context an object lives on, which need not be the current one
+template <typename V>
+viennacl::ocl::context &
+vcl_index_context(V &vcl_A)
+{
+    return const_cast<viennacl::ocl::context &>(vcl_A.handle().opencl_handle().context());
+}
+
+// copy host data to a new buffer on the context of an object
+template <typename V, typename E>
+void
+vcl_index_upload(V &vcl_A, viennacl::backend::mem_handle &h, const std::vector<E> &host)
+{
+    viennacl::backend::memory_create(h, sizeof(E) * host.size(), viennacl::traits::context(vcl_A), &host[0]);
+}
+
+/* A[rows, cols] into out (column-major, length rows x cols) */
+template <typename T, typename MatA>
+void
+vcl_gather(MatA &vcl_A, const std::vector<cl_uint> &rows, const std::vector<cl_uint> &cols, std::vector<T> &out)
+{
+    const unsigned int n = rows.size() * cols.size();
+    out.resize(n);
+    if(n == 0) return;
+
+    viennacl::backend::mem_handle d_rows, d_cols, d_out;
+    vcl_index_upload(vcl_A, d_rows, rows);
+    vcl_index_upload(vcl_A, d_cols, cols);
+    viennacl::backend::memory_create(d_out, sizeof(T) * n, viennacl::traits::context(vcl_A));
+
+    viennacl::ocl::kernel &k = vclIndexKernels<T>::get(vcl_index_context(vcl_A), "gather_2d", n);
+    viennacl::ocl::enqueue(k(
+        vcl_A.handle().opencl_handle(),
+        cl_uint(viennacl::traits::start1(vcl_A)), cl_uint(viennacl::traits::start2(vcl_A)),
+        cl_uint(viennacl::traits::internal_size2(vcl_A)),
+        d_rows.opencl_handle(), cl_uint(rows.size()),
+        d_cols.opencl_handle(), cl_uint(cols.size()),
+        d_out.opencl_handle()));
+
+    viennacl::backend::memory_read(d_out, 0, sizeof(T) * n, &out[0]);
+}
+
+/* A[rows, cols] <- vals, recycling vals */
+template <typename T, typename MatA>
+void
+vcl_scatter(MatA &vcl_A, const std::vector<cl_uint> &rows, const std::vector<cl_uint> &cols, const std::vector<T> &vals)
+{
+    const unsigned int n = rows.size() * cols.size();
+    if(n == 0 || vals.empty()) return;
+
+    viennacl::backend::mem_handle d_rows, d_cols, d_vals;
+    vcl_index_upload(vcl_A, d_rows, rows);
+    vcl_index_upload(vcl_A, d_cols, cols);
+    vcl_index_upload(vcl_A, d_vals, vals);
+
+    viennacl::ocl::kernel &k = vclIndexKernels<T>::get(vcl_index_context(vcl_A), "scatter_2d", n);
+    viennacl::ocl::enqueue(k(
+        vcl_A.handle().opencl_handle(),
+        cl_uint(viennacl::traits::start1(vcl_A)), cl_uint(viennacl::traits::start2(vcl_A)),
+        cl_uint(viennacl::traits::internal_size2(vcl_A)),
+        d_rows.opencl_handle(), cl_uint(rows.size()),
+        d_cols.opencl_handle(), cl_uint(cols.size()),
+        d_vals.opencl_handle(), cl_uint(vals.size())));
+}
+
+/* A[idx] for column-major linear indices */
+template <typename T, typename MatA>
+void
+vcl_gather_index(MatA &vcl_A, const std::vector<cl_uint> &idx, std::vector<T> &out)
+{
+    const unsigned int n = idx.size();
+    out.resize(n);
+    if(n == 0) return;
+
+    viennacl::backend::mem_handle d_idx, d_out;
+    vcl_index_upload(vcl_A, d_idx, idx);
+    viennacl::backend::memory_create(d_out, sizeof(T) * n, viennacl::traits::context(vcl_A));
+
+    viennacl::ocl::kernel &k = vclIndexKernels<T>::get(vcl_index_context(vcl_A), "gather_1d", n);
+    viennacl::ocl::enqueue(k(
+        vcl_A.handle().opencl_handle(),
+        cl_uint(viennacl::traits::start1(vcl_A)), cl_uint(viennacl::traits::start2(vcl_A)),
+        cl_uint(viennacl::traits::internal_size2(vcl_A)), cl_uint(vcl_A.size1()),
+        d_idx.opencl_handle(), cl_uint(n),
+        d_out.opencl_handle()));
+
+    viennacl::backend::memory_read(d_out, 0, sizeof(T) * n, &out[0]);
+}
+
+/* A[idx] <- vals for column-major linear indices, recycling vals */
+template <typename T, typename MatA>
+void
+vcl_scatter_index(MatA &vcl_A, const std::vector<cl_uint> &idx, const std::vector<T> &vals)
+{
+    const unsigned int n = idx.size();
+    if(n == 0 || vals.empty()) return;
+
+    viennacl::backend::mem_handle d_idx, d_vals;
+    vcl_index_upload(vcl_A, d_idx, idx);
+    vcl_index_upload(vcl_A, d_vals, vals);
+
+    viennacl::ocl::kernel &k = vclIndexKernels<T>::get(vcl_index_context(vcl_A), "scatter_1d", n);
+    viennacl::ocl::enqueue(k(
+        vcl_A.handle().opencl_handle(),
+        cl_uint(viennacl::traits::start1(vcl_A)), cl_uint(viennacl::traits::start2(vcl_A)),
+        cl_uint(viennacl::traits::internal_size2(vcl_A)), cl_uint(vcl_A.size1()),
+        d_idx.opencl_handle(), cl_uint(n),
+        d_vals.opencl_handle(), cl_uint(vals.size())));
+}
+
+/* A[, col] <- vals, one upload and one launch */
+template <typename T, typename MatA>
+void
+vcl_set_col(MatA &vcl_A, unsigned int col, const std::vector<T> &vals)
+{
+    const unsigned int n = vcl_A.size1();
+    if(n == 0) return;
+
+    viennacl::backend::mem_handle d_vals;
+    vcl_index_upload(vcl_A, d_vals, vals);
+
+    viennacl::ocl::kernel &k = vclIndexKernels<T>::get(vcl_index_context(vcl_A), "set_col", n);
+    viennacl::ocl::enqueue(k(
+        vcl_A.handle().opencl_handle(),
+        cl_uint(viennacl::traits::start1(vcl_A)), cl_uint(viennacl::traits::start2(vcl_A)),
+        cl_uint(viennacl::traits::internal_size2(vcl_A)), cl_uint(n),
+        cl_uint(col), d_vals.opencl_handle()));
+}
+
+/* A[row, ] <- vals, a row is contiguous so this is a single write */
+template <typename T, typename MatA>
+void
+vcl_set_row(MatA &vcl_A, unsigned int row, const std::vector<T> &vals)
+{
+    const size_t n = vcl_A.size2();
+    if(n == 0) return;
+
+    const size_t offset = (viennacl::traits::start1(vcl_A) + row) * viennacl::traits::internal_size2(vcl_A) +
+        viennacl::traits::start2(vcl_A);
+
+    viennacl::backend::memory_write(vcl_A.handle(), sizeof(T) * offset, sizeof(T) * n, &vals[0]);
+}
+
+/* v[idx] */
+template <typename T, typename VecA>
+void
+vcl_vec_gather(VecA &vcl_A, const std::vector<cl_uint> &idx, std::vector<T> &out)
+{
+    const unsigned int n = idx.size();
+    out.resize(n);
+    if(n == 0) return;
+
+    viennacl::backend::mem_handle d_idx, d_out;
+    vcl_index_upload(vcl_A, d_idx, idx);
+    viennacl::backend::memory_create(d_out, sizeof(T) * n, viennacl::traits::context(vcl_A));
+
+    viennacl::ocl::kernel &k = vclIndexKernels<T>::get(vcl_index_context(vcl_A), "vec_gather", n);
+    viennacl::ocl::enqueue(k(
+        vcl_A.handle().opencl_handle(),
+        cl_uint(viennacl::traits::start(vcl_A)), cl_uint(viennacl::traits::stride(vcl_A)),
+        d_idx.opencl_handle(), cl_uint(n),
+        d_out.opencl_handle()));
+
+    viennacl::backend::memory_read(d_out, 0, sizeof(T) * n, &out[0]);
+}
+
+/* v[idx] <- vals, recycling vals */
+template <typename T, typename VecA>
+void
+vcl_vec_scatter(VecA &vcl_A, const std::vector<cl_uint> &idx, const std::vector<T> &vals)
+{
+    const unsigned int n = idx.size();
+    if(n == 0 || vals.empty()) return;
+
+    viennacl::backend::mem_handle d_idx, d_vals;
+    vcl_index_upload(vcl_A, d_idx, idx);
+    vcl_index_upload(vcl_A, d_vals, vals);
+
+    viennacl::ocl::kernel &k = vclIndexKernels<T>::get(vcl_index_context(vcl_A), "vec_scatter", n);
+    viennacl::ocl::enqueue(k(
+        vcl_A.handle().opencl_handle(),
+        cl_uint(viennacl::traits::start(vcl_A)), cl_uint(viennacl::traits::stride(vcl_A)),
+        d_idx.opencl_handle(), cl_uint(n),
+        d_vals.opencl_handle(), cl_uint(vals.size())));
+}
+
+#endif
@@ -0,0 +1,119 @@
+#pragma once
+#ifndef VCL_INPLACE_KERNELS
+#define VCL_INPLACE_KERNELS
+
+// Use OpenCL with ViennaCL
+#define VIENNACL_WITH_OPENCL 1
+
+// ViennaCL headers
+#include "viennacl/ocl/backend.hpp"
+#include "viennacl/ocl/context.hpp"
+#include "viennacl/ocl/kernel.hpp"
+#include "viennacl/ocl/utils.hpp"
+
+#include <string>
+
+// vclLayout and the launch size of the elementwise kernels
+#include "gpuR/vcl_mask_kernels.hpp"
+
+// elementwise operators
+#define GPUR_ELEM_ADD 0
+#define GPUR_ELEM_SUB 1
+#define GPUR_ELEM_MULT 2
+#define GPUR_ELEM_DIV 3
+
+/* C <- A op B or C <- A op scalar in one pass for matrices and vectors
+ * of any type.  C may be A or B, each element is read before it is
+ * written, so the operators can update their operands in place
+ * without a result allocation.  Integer NA propagates as in R.  The
+ * elements are visited in storage (row-major) order so neighbouring
+ * work-items touch neighbouring elements.
+ */
+template <typename T>
+struct vclInplaceKernels {
+
+    static std::string program_name(){
+        return viennacl::ocl::type_to_string<T>::apply() + "_gpuR_inplace";
+    }
+
+    static std::string source(viennacl::ocl::context &ctx){
+        const std::string type = viennacl::ocl::type_to_string<T>::apply();
+        std::string src;
+
+        if(type == "double"){
+            src += "#pragma OPENCL EXTENSION " + ctx.current_device().double_support_extension() + " : enable\n";
+        }
+        src += "#define T " + type + "\n";
+        if(type == "int"){
+            src += "#define IS_NA(x) ((x) == INT_MIN)\n";
+        }else{
+            // NaN propagates through the arithmetic itself
+            src += "#define IS_NA(x) 0\n";
+        }
+
+        src +=
+            "#define AT(p, l, i, j) p[l##_off + (i) * l##_rs + (j) * l##_cs]\n"
+            "\n"
+            "__kernel void elementwise(\n"
+            "    __global const T *A, uint a_off, uint a_rs, uint a_cs,\n"
+            "    __global const T *B, uint b_off, uint b_rs, uint b_cs,\n"
+            "    T scalar, uint use_scalar, uint op, uint size1, uint size2,\n"
+            "    __global T *C, uint c_off, uint c_rs, uint c_cs)\n"
+            "{\n"
+            "    const uint n = size1 * size2;\n"
+            "    for(uint k = get_global_id(0); k < n; k += get_global_size(0)){\n"
+            "        const uint i = k / size2;\n"
+            "        const uint j = k % size2;\n"
+            "        const T a = AT(A, a, i, j);\n"
+            "        const T b = use_scalar ? scalar : AT(B, b, i, j);\n"
+            "        T res;\n"
+            "        if(IS_NA(a) || IS_NA(b)){\n"
+            "            res = IS_NA(a) ? a : b;\n"
+            "        }else{\n"
+            "            switch(op){\n"
+            "                case 0: res = a + b; break;\n"
+            "                case 1: res = a - b; break;\n"
+            "                case 2: res = a * b; break;\n"
+            "                default: res = a / b;\n"
+            "            }\n"
+            "        }\n"
+            "        AT(C, c, i, j) = res;\n"
+            "    }\n"
+            "}\n";
+
+        return src;
+    }
+
+    static void init(viennacl::ocl::context &ctx){
+        if(!ctx.has_program(program_name())){
+            ctx.add_program(source(ctx), program_name());
+        }
+    }
+
+    static viennacl::ocl::kernel & get(viennacl::ocl::context &ctx, const std::string &name){
+        init(ctx);
+        return ctx.get_kernel(program_name(), name);
+    }
+};
+
+/* C <- A op B (use_scalar false) or C <- A op scalar */
+template <typename T>
+void
+vcl_elementwise(
+    const viennacl::ocl::handle<cl_mem> &A, const vclLayout &la,
+    const viennacl::ocl::handle<cl_mem> &B, const vclLayout &lb,
+    T scalar, bool use_scalar, unsigned int op,
+    const viennacl::ocl::handle<cl_mem> &C, const vclLayout &lc)
+{
+    viennacl::ocl::context &ctx = viennacl::ocl::current_context();
+    viennacl::ocl::kernel &k = vclInplaceKernels<T>::get(ctx, "elementwise");
+    vcl_mask_range(k, la.size1 * la.size2);
+
+    viennacl::ocl::enqueue(k(
+        A, la.offset, la.row_stride, la.col_stride,
+        B, lb.offset, lb.row_stride, lb.col_stride,
+        scalar, cl_uint(use_scalar), cl_uint(op), la.size1, la.size2,
+        C, lc.offset, lc.row_stride, lc.col_stride));
+}
+
+#endif
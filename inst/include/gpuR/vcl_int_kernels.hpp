@@ -0,0 +1,328 @@
+#pragma once
+#ifndef VCL_INT_KERNELS
+#define VCL_INT_KERNELS
+
+// Use OpenCL with ViennaCL
+#define VIENNACL_WITH_OPENCL 1
+
+// ViennaCL headers
+#include "viennacl/ocl/backend.hpp"
+#include "viennacl/ocl/context.hpp"
+#include "viennacl/ocl/kernel.hpp"
+#include "viennacl/ocl/utils.hpp"
+#include "viennacl/backend/memory.hpp"
+
+#include <algorithm>
+#include <string>
+
+// vclLayout and the launch size of the elementwise kernels
+#include "gpuR/vcl_mask_kernels.hpp"
+
+// integer arithmetic operators
+#define GPUR_INT_ADD 0
+#define GPUR_INT_SUB 1
+#define GPUR_INT_MULT 2
+#define GPUR_INT_INTDIV 3
+#define GPUR_INT_MOD 4
+
+// tile edge of the integer GEMM
+#define GPUR_INT_TILE 16
+
+/* Integer matrix kernels.
+ *
+ * Every result is formed in 64 bit (long) and only narrowed to T on the
+ * store, so products and reductions of count data do not wrap around.
+ * As in R, NA (INT_MIN) propagates, %/% and %% by zero are NA, %/% and
+ * %% round towards minus infinity, and a result outside the range of T
+ * is stored as NA and raises a flag the host turns into a warning.
+ */
+template <typename T>
+struct vclIntKernels {
+
+    static std::string program_name(){
+        return viennacl::ocl::type_to_string<T>::apply() + "_gpuR_int";
+    }
+
+    static std::string source(viennacl::ocl::context &ctx){
+        const std::string type = viennacl::ocl::type_to_string<T>::apply();
+        std::string src;
+
+        src += "#define T " + type + "\n";
+        src += "#define TILE " GPUR_STR(GPUR_INT_TILE) "\n";
+
+        src +=
+            "#define NA_T INT_MIN\n"
+            "#define IS_NA(x) ((x) == NA_T)\n"
+            "#define AT(p, l, i, j) p[l##_off + (i) * l##_rs + (j) * l##_cs]\n"
+            "\n"
+            // narrow a 64 bit result, NA and flag when out of range
+            "inline T narrow(long x, __global int *overflow)\n"
+            "{\n"
+            "    if(x > INT_MAX || x <= INT_MIN){\n"
+            "        *overflow = 1;\n"
+            "        return NA_T;\n"
+            "    }\n"
+            "    return (T)x;\n"
+            "}\n"
+            "\n"
+            // acc += x unless it would leave the 64 bit range
+            "inline int acc_add(long *acc, long x)\n"
+            "{\n"
+            "    if((x > 0 && *acc > LONG_MAX - x) || (x < 0 && *acc < LONG_MIN - x)){\n"
+            "        return 0;\n"
+            "    }\n"
+            "    *acc += x;\n"
+            "    return 1;\n"
+            "}\n"
+            "\n"
+            "__kernel void arith(\n"
+            "    __global const T *A, uint a_off, uint a_rs, uint a_cs,\n"
+            "    __global const T *B, uint b_off, uint b_rs, uint b_cs,\n"
+            "    T scalar, uint use_scalar, uint left, uint op, uint size1, uint size2,\n"
+            "    __global T *C, uint c_off, uint c_rs, uint c_cs,\n"
+            "    __global int *overflow)\n"
+            "{\n"
+            "    const uint n = size1 * size2;\n"
+            "    for(uint k = get_global_id(0); k < n; k += get_global_size(0)){\n"
+            "        const uint i = k / size2;\n"
+            "        const uint j = k % size2;\n"
+            "        T x = AT(A, a, i, j);\n"
+            "        T y = use_scalar ? scalar : AT(B, b, i, j);\n"
+            "        if(left){\n"
+            "            const T t = x; x = y; y = t;\n"
+            "        }\n"
+            "        T res;\n"
+            "        if(IS_NA(x) || IS_NA(y) || (op >= 3 && y == 0)){\n"
+            "            res = NA_T;\n"
+            "        }else{\n"
+            "            const long a = x;\n"
+            "            const long b = y;\n"
+            "            long r;\n"
+            "            switch(op){\n"
+            "                case 0: r = a + b; break;\n"
+            "                case 1: r = a - b; break;\n"
+            "                case 2: r = a * b; break;\n"
+            "                case 3:\n"
+            "                    r = a / b;\n"
+            "                    if(r * b != a && ((a < 0) != (b < 0))) r--;\n"
+            "                    break;\n"
+            "                default:\n"
+            "                    r = a % b;\n"
+            "                    if(r != 0 && ((r < 0) != (b < 0))) r += b;\n"
+            "            }\n"
+            "            res = narrow(r, overflow);\n"
+            "        }\n"
+            "        AT(C, c, i, j) = res;\n"
+            "    }\n"
+            "}\n"
+            "\n"
+            // C <- A B over TILE x TILE tiles, a transposed operand is
+            // passed with its strides swapped.  Dimension 0 runs along
+            // the columns so a tile row is one contiguous load.
+            "__kernel void gemm(\n"
+            "    __global const T *A, uint a_off, uint a_rs, uint a_cs,\n"
+            "    __global const T *B, uint b_off, uint b_rs, uint b_cs,\n"
+            "    uint M, uint N, uint K,\n"
+            "    __global T *C, uint c_off, uint c_rs, uint c_cs,\n"
+            "    __global int *overflow)\n"
+            "{\n"
+            "    __local T As[TILE][TILE];\n"
+            "    __local T Bs[TILE][TILE];\n"
+            "\n"
+            "    const uint lj = get_local_id(0);\n"
+            "    const uint li = get_local_id(1);\n"
+            "    const uint j = get_global_id(0);\n"
+            "    const uint i = get_global_id(1);\n"
+            "\n"
+            "    long acc = 0;\n"
+            "    int na = 0;\n"
+            "    int wide = 0;\n"
+            "\n"
+            "    for(uint t = 0; t < K; t += TILE){\n"
+            "        As[li][lj] = (i < M && t + lj < K) ? AT(A, a, i, t + lj) : 0;\n"
+            "        Bs[li][lj] = (t + li < K && j < N) ? AT(B, b, t + li, j) : 0;\n"
+            "        barrier(CLK_LOCAL_MEM_FENCE);\n"
+            "\n"
+            "        for(uint kk = 0; kk < TILE; kk++){\n"
+            "            const T x = As[li][kk];\n"
+            "            const T y = Bs[kk][lj];\n"
+            "            if(IS_NA(x) || IS_NA(y)){\n"
+            "                na = 1;\n"
+            "            }else if(!acc_add(&acc, (long)x * (long)y)){\n"
+            "                wide = 1;\n"
+            "            }\n"
+            "        }\n"
+            "        barrier(CLK_LOCAL_MEM_FENCE);\n"
+            "    }\n"
+            "\n"
+            "    if(i < M && j < N){\n"
+            "        if(na){\n"
+            "            AT(C, c, i, j) = NA_T;\n"
+            "        }else if(wide){\n"
+            "            *overflow = 1;\n"
+            "            AT(C, c, i, j) = NA_T;\n"
+            "        }else{\n"
+            "            AT(C, c, i, j) = narrow(acc, overflow);\n"
+            "        }\n"
+            "    }\n"
+            "}\n"
+            "\n"
+            // S[i] <- sum_j A[i, j], a column sum is passed transposed
+            "__kernel void row_sums(\n"
+            "    __global const T *A, uint a_off, uint a_rs, uint a_cs,\n"
+            "    uint size1, uint size2,\n"
+            "    __global T *S, uint s_off, uint s_inc,\n"
+            "    __global int *overflow)\n"
+            "{\n"
+            "    for(uint i = get_global_id(0); i < size1; i += get_global_size(0)){\n"
+            "        long acc = 0;\n"
+            "        int na = 0;\n"
+            "        for(uint j = 0; j < size2; j++){\n"
+            "            const T x = AT(A, a, i, j);\n"
+            "            if(IS_NA(x)){\n"
+            "                na = 1;\n"
+            "                break;\n"
+            "            }\n"
+            "            acc += x;\n"
+            "        }\n"
+            "        S[s_off + i * s_inc] = na ? NA_T : narrow(acc, overflow);\n"
+            "    }\n"
+            "}\n";
+
+        return src;
+    }
+
+    static void init(viennacl::ocl::context &ctx){
+        if(!ctx.has_program(program_name())){
+            ctx.add_program(source(ctx), program_name());
+        }
+    }
+
+    static viennacl::ocl::kernel & get(viennacl::ocl::context &ctx, const std::string &name){
+        init(ctx);
+        return ctx.get_kernel(program_name(), name);
+    }
+};
+
+/* the layout of the transpose of l, no data is moved */
+inline vclLayout
+vcl_transpose_layout(const vclLayout &l)
+{
+    vclLayout t;
+    t.offset = l.offset;
+    t.row_stride = l.col_stride;
+    t.col_stride = l.row_stride;
+    t.size1 = l.size2;
+    t.size2 = l.size1;
+    return t;
+}
+
+/* a zeroed device flag for the kernels to raise */
+inline void
+vcl_int_flag_create(viennacl::backend::mem_handle &flag)
+{
+    viennacl::ocl::context &ctx = viennacl::ocl::current_context();
+    cl_int zero = 0;
+    viennacl::backend::memory_create(flag, sizeof(cl_int), viennacl::context(ctx), &zero);
+}
+
+inline bool
+vcl_int_flag_read(const viennacl::backend::mem_handle &flag)
+{
+    cl_int raised = 0;
+    viennacl::backend::memory_read(flag, 0, sizeof(cl_int), &raised);
+    return raised != 0;
+}
+
+/* C <- A op B (use_scalar false) or C <- A op scalar, scalar op A when
+ * left.  True if a result overflowed to NA.
+ */
+template <typename T>
+bool
+vcl_int_arith(
+    const viennacl::ocl::handle<cl_mem> &A, const vclLayout &la,
+    const viennacl::ocl::handle<cl_mem> &B, const vclLayout &lb,
+    T scalar, bool use_scalar, bool left, unsigned int op,
+    const viennacl::ocl::handle<cl_mem> &C, const vclLayout &lc)
+{
+    viennacl::ocl::context &ctx = viennacl::ocl::current_context();
+    viennacl::ocl::kernel &k = vclIntKernels<T>::get(ctx, "arith");
+    vcl_mask_range(k, la.size1 * la.size2);
+
+    viennacl::backend::mem_handle flag;
+    vcl_int_flag_create(flag);
+
+    viennacl::ocl::enqueue(k(
+        A, la.offset, la.row_stride, la.col_stride,
+        B, lb.offset, lb.row_stride, lb.col_stride,
+        scalar, cl_uint(use_scalar), cl_uint(left), cl_uint(op), la.size1, la.size2,
+        C, lc.offset, lc.row_stride, lc.col_stride,
+        flag.opencl_handle()));
+
+    return vcl_int_flag_read(flag);
+}
+
+/* C <- A B, transpose an operand with vcl_transpose_layout.  C must not
+ * overlap A or B.  True if a result overflowed to NA.
+ */
+template <typename T>
+bool
+vcl_int_gemm(
+    const viennacl::ocl::handle<cl_mem> &A, const vclLayout &la,
+    const viennacl::ocl::handle<cl_mem> &B, const vclLayout &lb,
+    const viennacl::ocl::handle<cl_mem> &C, const vclLayout &lc)
+{
+    viennacl::ocl::context &ctx = viennacl::ocl::current_context();
+    viennacl::ocl::kernel &k = vclIntKernels<T>::get(ctx, "gemm");
+
+    const cl_uint M = la.size1;
+    const cl_uint N = lb.size2;
+    const cl_uint K = la.size2;
+
+    k.local_work_size(0, GPUR_INT_TILE);
+    k.local_work_size(1, GPUR_INT_TILE);
+    k.global_work_size(0, GPUR_INT_TILE * std::max(1u, (N + GPUR_INT_TILE - 1) / GPUR_INT_TILE));
+    k.global_work_size(1, GPUR_INT_TILE * std::max(1u, (M + GPUR_INT_TILE - 1) / GPUR_INT_TILE));
+
+    viennacl::backend::mem_handle flag;
+    vcl_int_flag_create(flag);
+
+    viennacl::ocl::enqueue(k(
+        A, la.offset, la.row_stride, la.col_stride,
+        B, lb.offset, lb.row_stride, lb.col_stride,
+        M, N, K,
+        C, lc.offset, lc.row_stride, lc.col_stride,
+        flag.opencl_handle()));
+
+    return vcl_int_flag_read(flag);
+}
+
+/* S <- rowSums(A), or colSums(A) when cols.  True if a sum overflowed
+ * to NA.
+ */
+template <typename T>
+bool
+vcl_int_sums(
+    const viennacl::ocl::handle<cl_mem> &A, const vclLayout &la,
+    const viennacl::ocl::handle<cl_mem> &S, const vclLayout &ls,
+    bool cols)
+{
+    viennacl::ocl::context &ctx = viennacl::ocl::current_context();
+    viennacl::ocl::kernel &k = vclIntKernels<T>::get(ctx, "row_sums");
+
+    const vclLayout l = cols ? vcl_transpose_layout(la) : la;
+    vcl_mask_range(k, l.size1);
+
+    viennacl::backend::mem_handle flag;
+    vcl_int_flag_create(flag);
+
+    viennacl::ocl::enqueue(k(
+        A, l.offset, l.row_stride, l.col_stride,
+        l.size1, l.size2,
+        S, ls.offset, ls.row_stride,
+        flag.opencl_handle()));
+
+    return vcl_int_flag_read(flag);
+}
+
+#endif
@@ -0,0 +1,766 @@
+#pragma once
+#ifndef VCL_MASK_KERNELS
+#define VCL_MASK_KERNELS
+
+// Use OpenCL with ViennaCL
+#define VIENNACL_WITH_OPENCL 1
+
+// ViennaCL headers
+#include "viennacl/ocl/backend.hpp"
+#include "viennacl/ocl/context.hpp"
+#include "viennacl/ocl/kernel.hpp"
+#include "viennacl/ocl/utils.hpp"
+#include "viennacl/matrix.hpp"
+#include "viennacl/vector.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <string>
+#include <vector>
+
+// comparison operators, in the order of R's Compare group
+#define GPUR_CMP_EQ 0
+#define GPUR_CMP_NE 1
+#define GPUR_CMP_LT 2
+#define GPUR_CMP_LE 3
+#define GPUR_CMP_GT 4
+#define GPUR_CMP_GE 5
+
+// logical operators
+#define GPUR_LOGIC_AND 0
+#define GPUR_LOGIC_OR 1
+
+// work-group size and maximum number of work-groups of the mask kernels
+#define GPUR_MASK_WG 128
+#define GPUR_MASK_MAX_GROUPS 1024
+
+// a numeric macro as a string literal, to pass host constants into
+// kernel source
+#ifndef GPUR_STR
+#define GPUR_STR_(x) #x
+#define GPUR_STR(x) GPUR_STR_(x)
+#endif
+
+/* Element addressing shared by matrices and vectors so that one set of
+ * kernels serves both: element (i, j) lives at
+ * offset + i * row_stride + j * col_stride.  A vector is a single
+ * column (col_stride 0).  The elementwise kernels visit a matrix in
+ * storage (row-major) order so neighbouring work-items touch
+ * neighbouring elements, only the compaction kernels follow R's
+ * column-major order, which fixes the order of their output.
+ */
+struct vclLayout {
+    cl_uint offset;
+    cl_uint row_stride;
+    cl_uint col_stride;
+    cl_uint size1;
+    cl_uint size2;
+};
+
+template <typename MatA>
+vclLayout
+vcl_matrix_layout(MatA &vcl_A)
+{
+    vclLayout l;
+    l.offset = viennacl::traits::start1(vcl_A) * viennacl::traits::internal_size2(vcl_A) +
+        viennacl::traits::start2(vcl_A);
+    l.row_stride = viennacl::traits::internal_size2(vcl_A);
+    l.col_stride = 1;
+    l.size1 = vcl_A.size1();
+    l.size2 = vcl_A.size2();
+    return l;
+}
+
+template <typename VecA>
+vclLayout
+vcl_vector_layout(VecA &vcl_A)
+{
+    vclLayout l;
+    l.offset = viennacl::traits::start(vcl_A);
+    l.row_stride = viennacl::traits::stride(vcl_A);
+    l.col_stride = 0;
+    l.size1 = vcl_A.size();
+    l.size2 = 1;
+    return l;
+}
+
+/* Device-resident logical masks.
+ *
+ * gpuR has no logical type so masks are integer objects holding 1, 0
+ * or NA (INT_MIN) as R's logical vectors do.  Comparisons follow R:
+ * any NA/NaN operand gives NA, and & / | use three valued logic.
+ * Comparisons are evaluated in the element type.  For integer data a
+ * fractional or out of range scalar is first folded into an integer
+ * bound on the host (vcl_cmp_scalar) so that e.g. A > 2.5 is exact
+ * without double precision support.
+ *
+ * Compaction (A[mask], which(mask)) is a three kernel prefix scan:
+ * every work-group counts the selected elements of its contiguous
+ * (column-major) chunk, a scan turns the counts into output offsets
+ * and the groups then write their selected elements in order.
+ */
+template <typename T>
+struct vclMaskKernels {
+
+    static std::string program_name(){
+        return viennacl::ocl::type_to_string<T>::apply() + "_gpuR_mask";
+    }
+
+    // type of the conditional means, double where available
+    static std::string mean_type(viennacl::ocl::context &ctx){
+        const std::string type = viennacl::ocl::type_to_string<T>::apply();
+        if(type != "int") return type;
+        return ctx.current_device().double_support() ? "double" : "float";
+    }
+
+    static std::string source(viennacl::ocl::context &ctx){
+        const std::string type = viennacl::ocl::type_to_string<T>::apply();
+        std::string src;
+
+        if(type == "double" || mean_type(ctx) == "double"){
+            src += "#pragma OPENCL EXTENSION " + ctx.current_device().double_support_extension() + " : enable\n";
+        }
+        src += "#define T " + type + "\n";
+        src += "#define MEAN " + mean_type(ctx) + "\n";
+        if(type == "int"){
+            src += "#define IS_NA(x) ((x) == INT_MIN)\n";
+            src += "#define T_NA INT_MIN\n";
+            src += "#define T_SUM(s) (((s) > INT_MAX || (s) < -INT_MAX) ? INT_MIN : (int)(s))\n";
+            src += "#define T_ABS(x) ((int)abs(x))\n";
+        }else{
+            src += "#define IS_NA(x) isnan(x)\n";
+            src += "#define T_NA NAN\n";
+            src += "#define T_SUM(s) (s)\n";
+            src += "#define T_ABS(x) fabs(x)\n";
+        }
+        // accumulator of the conditional sums
+        src += "#define ACC " + std::string(type == "int" ? "long" : type) + "\n";
+
+        // the work-group size the host launches with
+        src += "#define WG " GPUR_STR(GPUR_MASK_WG) "\n";
+
+        src +=
+            "#define NA_LGL INT_MIN\n"
+            "#define AT(p, l, i, j) p[l##_off + (i) * l##_rs + (j) * l##_cs]\n"
+            "\n"
+            "inline int cmp_op(T a, T b, uint op)\n"
+            "{\n"
+            "    switch(op){\n"
+            "        case 0: return a == b;\n"
+            "        case 1: return a != b;\n"
+            "        case 2: return a < b;\n"
+            "        case 3: return a <= b;\n"
+            "        case 4: return a > b;\n"
+            "        default: return a >= b;\n"
+            "    }\n"
+            "}\n"
+            "\n"
+            "inline int as_lgl(T x)\n"
+            "{\n"
+            "    return IS_NA(x) ? NA_LGL : (x != 0);\n"
+            "}\n"
+            "\n"
+            "inline int selected(int m)\n"
+            "{\n"
+            "    return m != 0 && m != NA_LGL;\n"
+            "}\n"
+            "\n"
+            // A op B, or A op scalar
+            "__kernel void compare(\n"
+            "    __global const T *A, uint a_off, uint a_rs, uint a_cs,\n"
+            "    __global const T *B, uint b_off, uint b_rs, uint b_cs,\n"
+            "    T scalar, uint use_scalar, uint op, uint size1, uint size2,\n"
+            "    __global int *M, uint m_off, uint m_rs, uint m_cs)\n"
+            "{\n"
+            "    const uint n = size1 * size2;\n"
+            "    for(uint k = get_global_id(0); k < n; k += get_global_size(0)){\n"
+            "        const uint i = k / size2;\n"
+            "        const uint j = k % size2;\n"
+            "        const T a = AT(A, a, i, j);\n"
+            "        int res;\n"
+            "        if(use_scalar){\n"
+            "            res = (IS_NA(a) || IS_NA(scalar)) ? NA_LGL : cmp_op(a, scalar, op);\n"
+            "        }else{\n"
+            "            const T b = AT(B, b, i, j);\n"
+            "            res = (IS_NA(a) || IS_NA(b)) ? NA_LGL : cmp_op(a, b, op);\n"
+            "        }\n"
+            "        AT(M, m, i, j) = res;\n"
+            "    }\n"
+            "}\n"
+            "\n"
+            // A & B, A | B with R's three valued logic, nonzero is TRUE
+            "__kernel void logic(\n"
+            "    __global const T *A, uint a_off, uint a_rs, uint a_cs,\n"
+            "    __global const T *B, uint b_off, uint b_rs, uint b_cs,\n"
+            "    int scalar, uint use_scalar, uint op, uint size1, uint size2,\n"
+            "    __global int *M, uint m_off, uint m_rs, uint m_cs)\n"
+            "{\n"
+            "    const uint n = size1 * size2;\n"
+            "    for(uint k = get_global_id(0); k < n; k += get_global_size(0)){\n"
+            "        const uint i = k / size2;\n"
+            "        const uint j = k % size2;\n"
+            "        const int a = as_lgl(AT(A, a, i, j));\n"
+            "        const int b = use_scalar ? scalar : as_lgl(AT(B, b, i, j));\n"
+            "        int res;\n"
+            "        if(op == 0){\n"
+            "            res = (a == 0 || b == 0) ? 0 : ((a == NA_LGL || b == NA_LGL) ? NA_LGL : 1);\n"
+            "        }else{\n"
+            "            res = (a == 1 || b == 1) ? 1 : ((a == NA_LGL || b == NA_LGL) ? NA_LGL : 0);\n"
+            "        }\n"
+            "        AT(M, m, i, j) = res;\n"
+            "    }\n"
+            "}\n"
+            "\n"
+            "__kernel void logic_not(\n"
+            "    __global const T *A, uint a_off, uint a_rs, uint a_cs,\n"
+            "    uint size1, uint size2,\n"
+            "    __global int *M, uint m_off, uint m_rs, uint m_cs)\n"
+            "{\n"
+            "    const uint n = size1 * size2;\n"
+            "    for(uint k = get_global_id(0); k < n; k += get_global_size(0)){\n"
+            "        const uint i = k / size2;\n"
+            "        const uint j = k % size2;\n"
+            "        const int a = as_lgl(AT(A, a, i, j));\n"
+            "        AT(M, m, i, j) = (a == NA_LGL) ? NA_LGL : !a;\n"
+            "    }\n"
+            "}\n"
+            "\n"
+            // selected elements in each work-group's chunk
+            "__kernel void compact_count(\n"
+            "    __global const int *M, uint m_off, uint m_rs, uint m_cs,\n"
+            "    uint size1, uint size2, uint chunk,\n"
+            "    __global uint *counts)\n"
+            "{\n"
+            "    __local uint lc[WG];\n"
+            "    const uint lid = get_local_id(0);\n"
+            "    const uint g = get_group_id(0);\n"
+            "    const uint n = size1 * size2;\n"
+            "    const uint begin = g * chunk;\n"
+            "    const uint end = min(n, begin + chunk);\n"
+            "    uint c = 0;\n"
+            "    for(uint k = begin + lid; k < end; k += WG){\n"
+            "        c += selected(AT(M, m, k % size1, k / size1));\n"
+            "    }\n"
+            "    lc[lid] = c;\n"
+            "    barrier(CLK_LOCAL_MEM_FENCE);\n"
+            "    for(uint s = WG / 2; s > 0; s >>= 1){\n"
+            "        if(lid < s) lc[lid] += lc[lid + s];\n"
+            "        barrier(CLK_LOCAL_MEM_FENCE);\n"
+            "    }\n"
+            "    if(lid == 0) counts[g] = lc[0];\n"
+            "}\n"
+            "\n"
+            // exclusive scan of the counts, the total follows them
+            "__kernel void compact_scan(__global uint *counts, uint ngroups)\n"
+            "{\n"
+            "    if(get_global_id(0) == 0){\n"
+            "        uint s = 0;\n"
+            "        for(uint g = 0; g < ngroups; g++){\n"
+            "            const uint c = counts[g];\n"
+            "            counts[g] = s;\n"
+            "            s += c;\n"
+            "        }\n"
+            "        counts[ngroups] = s;\n"
+            "    }\n"
+            "}\n"
+            "\n"
+            // position of each selected element within a tile of WG
+            "inline uint tile_scan(__local uint *ls, uint lid, uint f)\n"
+            "{\n"
+            "    ls[lid] = f;\n"
+            "    barrier(CLK_LOCAL_MEM_FENCE);\n"
+            "    for(uint s = 1; s < WG; s <<= 1){\n"
+            "        const uint v = (lid >= s) ? ls[lid - s] : 0;\n"
+            "        barrier(CLK_LOCAL_MEM_FENCE);\n"
+            "        ls[lid] += v;\n"
+            "        barrier(CLK_LOCAL_MEM_FENCE);\n"
+            "    }\n"
+            "    return ls[lid];\n"
+            "}\n"
+            "\n"
+            "__kernel void compact_values(\n"
+            "    __global const T *A, uint a_off, uint a_rs, uint a_cs,\n"
+            "    __global const int *M, uint m_off, uint m_rs, uint m_cs,\n"
+            "    uint size1, uint size2, uint chunk,\n"
+            "    __global const uint *offsets,\n"
+            "    __global T *out, uint out_off, uint out_stride)\n"
+            "{\n"
+            "    __local uint ls[WG];\n"
+            "    const uint lid = get_local_id(0);\n"
+            "    const uint g = get_group_id(0);\n"
+            "    const uint n = size1 * size2;\n"
+            "    const uint begin = g * chunk;\n"
+            "    const uint end = min(n, begin + chunk);\n"
+            "    uint pos = offsets[g];\n"
+            "    for(uint base = begin; base < end; base += WG){\n"
+            "        const uint k = base + lid;\n"
+            "        const uint i = k % size1;\n"
+            "        const uint j = k / size1;\n"
+            "        const uint f = (k < end) ? selected(AT(M, m, i, j)) : 0;\n"
+            "        const uint p = tile_scan(ls, lid, f);\n"
+            "        if(f) out[out_off + (pos + p - 1) * out_stride] = AT(A, a, i, j);\n"
+            "        pos += ls[WG - 1];\n"
+            "        barrier(CLK_LOCAL_MEM_FENCE);\n"
+            "    }\n"
+            "}\n"
+            "\n"
+            // one based column-major indices of the selected elements
+            "__kernel void compact_index(\n"
+            "    __global const int *M, uint m_off, uint m_rs, uint m_cs,\n"
+            "    uint size1, uint size2, uint chunk,\n"
+            "    __global const uint *offsets,\n"
+            "    __global int *out, uint out_off, uint out_stride)\n"
+            "{\n"
+            "    __local uint ls[WG];\n"
+            "    const uint lid = get_local_id(0);\n"
+            "    const uint g = get_group_id(0);\n"
+            "    const uint n = size1 * size2;\n"
+            "    const uint begin = g * chunk;\n"
+            "    const uint end = min(n, begin + chunk);\n"
+            "    uint pos = offsets[g];\n"
+            "    for(uint base = begin; base < end; base += WG){\n"
+            "        const uint k = base + lid;\n"
+            "        const uint f = (k < end) ? selected(AT(M, m, k % size1, k / size1)) : 0;\n"
+            "        const uint p = tile_scan(ls, lid, f);\n"
+            "        if(f) out[out_off + (pos + p - 1) * out_stride] = (int)(k + 1);\n"
+            "        pos += ls[WG - 1];\n"
+            "        barrier(CLK_LOCAL_MEM_FENCE);\n"
+            "    }\n"
+            "}\n"
+            "\n"
+            // fused predicate reductions, the condition is evaluated and
+            // reduced in the same pass without a mask
+            "inline void where_visit(T a, T scalar, uint op, uint absolute,\n"
+            "                        uint *n, uint *na, ACC *s)\n"
+            "{\n"
+            "    if(IS_NA(a) || IS_NA(scalar)){ (*na)++; return; }\n"
+            "    const T v = absolute ? T_ABS(a) : a;\n"
+            "    if(cmp_op(v, scalar, op)){ (*n)++; *s += a; }\n"
+            "}\n"
+            "\n"
+            "inline void where_local(__local uint *ln, __local uint *lna, __local ACC *ls,\n"
+            "                        uint n, uint na, ACC s)\n"
+            "{\n"
+            "    const uint lid = get_local_id(0);\n"
+            "    ln[lid] = n; lna[lid] = na; ls[lid] = s;\n"
+            "    for(uint stride = WG / 2; stride > 0; stride >>= 1){\n"
+            "        barrier(CLK_LOCAL_MEM_FENCE);\n"
+            "        if(lid < stride){\n"
+            "            ln[lid] += ln[lid + stride];\n"
+            "            lna[lid] += lna[lid + stride];\n"
+            "            ls[lid] += ls[lid + stride];\n"
+            "        }\n"
+            "    }\n"
+            "    barrier(CLK_LOCAL_MEM_FENCE);\n"
+            "}\n"
+            "\n"
+            // count (what = 0), sum (1) or mean (2) of one row or column,
+            // only the output matching 'what' is written
+            "inline void where_store(uint n, uint na, ACC s, uint total, uint what, uint na_rm,\n"
+            "                        __global int *ci, __global T *ct, __global MEAN *cc, uint idx)\n"
+            "{\n"
+            "    const int is_na = !na_rm && na > 0;\n"
+            "    if(what == 0){\n"
+            "        ci[idx] = is_na ? NA_LGL : (int)n;\n"
+            "    }else if(what == 1){\n"
+            "        ct[idx] = is_na ? (T)T_NA : (T)T_SUM(s);\n"
+            "    }else{\n"
+            "        const uint d = na_rm ? total - na : total;\n"
+            "        cc[idx] = (is_na || d == 0) ? (MEAN)NAN : (MEAN)n / (MEAN)d;\n"
+            "    }\n"
+            "}\n"
+            "\n"
+            // one partial count, NA count and sum per work-group
+            "__kernel void where_reduce(\n"
+            "    __global const T *A, uint a_off, uint a_rs, uint a_cs,\n"
+            "    uint size1, uint size2, T scalar, uint op, uint absolute,\n"
+            "    __global uint *counts, __global ACC *sums)\n"
+            "{\n"
+            "    __local uint ln[WG];\n"
+            "    __local uint lna[WG];\n"
+            "    __local ACC ls[WG];\n"
+            "    uint n = 0, na = 0;\n"
+            "    ACC s = 0;\n"
+            "    const uint len = size1 * size2;\n"
+            "    for(uint k = get_global_id(0); k < len; k += get_global_size(0)){\n"
+            "        where_visit(AT(A, a, k / size2, k % size2), scalar, op, absolute, &n, &na, &s);\n"
+            "    }\n"
+            "    where_local(ln, lna, ls, n, na, s);\n"
+            "    if(get_local_id(0) == 0){\n"
+            "        const uint g = get_group_id(0);\n"
+            "        counts[2 * g] = ln[0];\n"
+            "        counts[2 * g + 1] = lna[0];\n"
+            "        sums[g] = ls[0];\n"
+            "    }\n"
+            "}\n"
+            "\n"
+            // one work-group per row
+            "__kernel void where_rows(\n"
+            "    __global const T *A, uint a_off, uint a_rs, uint a_cs,\n"
+            "    uint size1, uint size2, T scalar, uint op, uint absolute,\n"
+            "    uint what, uint na_rm,\n"
+            "    __global int *ci, __global T *ct, __global MEAN *cc, uint c_off, uint c_stride)\n"
+            "{\n"
+            "    __local uint ln[WG];\n"
+            "    __local uint lna[WG];\n"
+            "    __local ACC ls[WG];\n"
+            "    for(uint i = get_group_id(0); i < size1; i += get_num_groups(0)){\n"
+            "        uint n = 0, na = 0;\n"
+            "        ACC s = 0;\n"
+            "        for(uint j = get_local_id(0); j < size2; j += WG){\n"
+            "            where_visit(AT(A, a, i, j), scalar, op, absolute, &n, &na, &s);\n"
+            "        }\n"
+            "        where_local(ln, lna, ls, n, na, s);\n"
+            "        if(get_local_id(0) == 0){\n"
+            "            where_store(ln[0], lna[0], ls[0], size2, what, na_rm,\n"
+            "                        ci, ct, cc, c_off + i * c_stride);\n"
+            "        }\n"
+            "    }\n"
+            "}\n"
+            "\n"
+            // one work-item per column
+            "__kernel void where_cols(\n"
+            "    __global const T *A, uint a_off, uint a_rs, uint a_cs,\n"
+            "    uint size1, uint size2, T scalar, uint op, uint absolute,\n"
+            "    uint what, uint na_rm,\n"
+            "    __global int *ci, __global T *ct, __global MEAN *cc, uint c_off, uint c_stride)\n"
+            "{\n"
+            "    for(uint j = get_global_id(0); j < size2; j += get_global_size(0)){\n"
+            "        uint n = 0, na = 0;\n"
+            "        ACC s = 0;\n"
+            "        for(uint i = 0; i < size1; i++){\n"
+            "            where_visit(AT(A, a, i, j), scalar, op, absolute, &n, &na, &s);\n"
+            "        }\n"
+            "        where_store(n, na, s, size1, what, na_rm, ci, ct, cc, c_off + j * c_stride);\n"
+            "    }\n"
+            "}\n";
+
+        return src;
+    }
+
+    static void init(viennacl::ocl::context &ctx){
+        if(!ctx.has_program(program_name())){
+            ctx.add_program(source(ctx), program_name());
+        }
+    }
+
+    static viennacl::ocl::kernel & get(viennacl::ocl::context &ctx, const std::string &name){
+        init(ctx);
+        return ctx.get_kernel(program_name(), name);
+    }
+};
+
+/* The scalar of a comparison in the element type.  Integers are
+ * compared as integers, so a fractional or out of range scalar is
+ * folded into an integer bound with op adjusted (A > 2.5 is A >= 3,
+ * A == 2.5 never holds).  NaN becomes NA_integer_.
+ */
+template <typename T>
+inline T
+vcl_cmp_scalar(double scalar, unsigned int &op)
+{
+    return static_cast<T>(scalar);
+}
+
+template <>
+inline int
+vcl_cmp_scalar<int>(double scalar, unsigned int &op)
+{
+    // INT_MIN is NA, valid elements lie in [lo, hi]
+    const double lo = -INT_MAX;
+    const double hi = INT_MAX;
+    double t;
+
+    if(std::isnan(scalar)) return INT_MIN;
+
+    switch(op){
+        case GPUR_CMP_EQ:
+        case GPUR_CMP_NE:
+            if(scalar == std::floor(scalar) && scalar >= lo && scalar <= hi){
+                return static_cast<int>(scalar);
+            }
+            // a bound that no element (==) or every element (!=) passes
+            op = (op == GPUR_CMP_EQ) ? GPUR_CMP_LT : GPUR_CMP_GE;
+            return static_cast<int>(lo);
+        case GPUR_CMP_GT:
+            t = std::floor(scalar) + 1;
+            op = GPUR_CMP_GE;
+            break;
+        case GPUR_CMP_GE:
+            t = std::ceil(scalar);
+            break;
+        case GPUR_CMP_LT:
+            t = std::ceil(scalar) - 1;
+            op = GPUR_CMP_LE;
+            break;
+        default:
+            t = std::floor(scalar);
+            break;
+    }
+
+    if(op == GPUR_CMP_GE){
+        if(t > hi){
+            op = GPUR_CMP_GT;
+            return static_cast<int>(hi);
+        }
+        return static_cast<int>(std::max(t, lo));
+    }
+    if(t < lo){
+        op = GPUR_CMP_LT;
+        return static_cast<int>(lo);
+    }
+    return static_cast<int>(std::min(t, hi));
+}
+
+// launch size of the elementwise mask kernels
+inline void
+vcl_mask_range(viennacl::ocl::kernel &k, unsigned int n)
+{
+    k.local_work_size(0, GPUR_MASK_WG);
+    k.global_work_size(0, GPUR_MASK_WG * std::max(1u, std::min(
+        (n + GPUR_MASK_WG - 1) / GPUR_MASK_WG, (unsigned int)GPUR_MASK_MAX_GROUPS)));
+}
+
+/* M <- A op B (use_scalar false) or M <- A op scalar */
+template <typename T>
+void
+vcl_compare(
+    const viennacl::ocl::handle<cl_mem> &A, const vclLayout &la,
+    const viennacl::ocl::handle<cl_mem> &B, const vclLayout &lb,
+    double scalar, bool use_scalar, unsigned int op,
+    const viennacl::ocl::handle<cl_mem> &M, const vclLayout &lm)
+{
+    viennacl::ocl::context &ctx = viennacl::ocl::current_context();
+    viennacl::ocl::kernel &k = vclMaskKernels<T>::get(ctx, "compare");
+    vcl_mask_range(k, la.size1 * la.size2);
+
+    const T s = use_scalar ? vcl_cmp_scalar<T>(scalar, op) : T(0);
+
+    viennacl::ocl::enqueue(k(
+        A, la.offset, la.row_stride, la.col_stride,
+        B, lb.offset, lb.row_stride, lb.col_stride,
+        s, cl_uint(use_scalar), cl_uint(op), la.size1, la.size2,
+        M, lm.offset, lm.row_stride, lm.col_stride));
+}
+
+/* M <- A op B (use_scalar false) or M <- A op scalar, scalar an R logical */
+template <typename T>
+void
+vcl_logic(
+    const viennacl::ocl::handle<cl_mem> &A, const vclLayout &la,
+    const viennacl::ocl::handle<cl_mem> &B, const vclLayout &lb,
+    int scalar, bool use_scalar, unsigned int op,
+    const viennacl::ocl::handle<cl_mem> &M, const vclLayout &lm)
+{
+    viennacl::ocl::context &ctx = viennacl::ocl::current_context();
+    viennacl::ocl::kernel &k = vclMaskKernels<T>::get(ctx, "logic");
+    vcl_mask_range(k, la.size1 * la.size2);
+
+    viennacl::ocl::enqueue(k(
+        A, la.offset, la.row_stride, la.col_stride,
+        B, lb.offset, lb.row_stride, lb.col_stride,
+        cl_int(scalar), cl_uint(use_scalar), cl_uint(op), la.size1, la.size2,
+        M, lm.offset, lm.row_stride, lm.col_stride));
+}
+
+/* M <- !A */
+template <typename T>
+void
+vcl_logic_not(
+    const viennacl::ocl::handle<cl_mem> &A, const vclLayout &la,
+    const viennacl::ocl::handle<cl_mem> &M, const vclLayout &lm)
+{
+    viennacl::ocl::context &ctx = viennacl::ocl::current_context();
+    viennacl::ocl::kernel &k = vclMaskKernels<T>::get(ctx, "logic_not");
+    vcl_mask_range(k, la.size1 * la.size2);
+
+    viennacl::ocl::enqueue(k(
+        A, la.offset, la.row_stride, la.col_stride,
+        la.size1, la.size2,
+        M, lm.offset, lm.row_stride, lm.col_stride));
+}
+
+/* Compaction plan for a mask: the output offset of every work-group
+ * is left in offsets and the number of selected elements returned.
+ */
+struct vclCompactPlan {
+    viennacl::backend::mem_handle offsets;
+    cl_uint ngroups;
+    cl_uint chunk;
+};
+
+template <typename MaskHandle>
+unsigned int
+vcl_compact_plan(
+    const MaskHandle &M, const vclLayout &lm, vclCompactPlan &plan)
+{
+    viennacl::ocl::context &ctx = viennacl::ocl::current_context();
+
+    const unsigned int n = lm.size1 * lm.size2;
+    plan.ngroups = std::max(1u, std::min(
+        (n + GPUR_MASK_WG - 1) / GPUR_MASK_WG, (unsigned int)GPUR_MASK_MAX_GROUPS));
+    plan.chunk = (n + plan.ngroups - 1) / plan.ngroups;
+    plan.chunk = ((plan.chunk + GPUR_MASK_WG - 1) / GPUR_MASK_WG) * GPUR_MASK_WG;
+
+    viennacl::backend::memory_create(plan.offsets, sizeof(cl_uint) * (plan.ngroups + 1),
+                                     viennacl::traits::context(M));
+
+    viennacl::ocl::kernel &k1 = vclMaskKernels<int>::get(ctx, "compact_count");
+    k1.local_work_size(0, GPUR_MASK_WG);
+    k1.global_work_size(0, GPUR_MASK_WG * plan.ngroups);
+    viennacl::ocl::enqueue(k1(
+        M.handle().opencl_handle(), lm.offset, lm.row_stride, lm.col_stride,
+        lm.size1, lm.size2, plan.chunk,
+        plan.offsets.opencl_handle()));
+
+    viennacl::ocl::kernel &k2 = vclMaskKernels<int>::get(ctx, "compact_scan");
+    k2.local_work_size(0, 1);
+    k2.global_work_size(0, 1);
+    viennacl::ocl::enqueue(k2(plan.offsets.opencl_handle(), plan.ngroups));
+
+    // the only value that comes back to the host
+    cl_uint total;
+    viennacl::backend::memory_read(plan.offsets, sizeof(cl_uint) * plan.ngroups, sizeof(cl_uint), &total);
+    return total;
+}
+
+/* out <- A[M] */
+template <typename T, typename MaskHandle, typename VecB>
+void
+vcl_compact_values(
+    const viennacl::ocl::handle<cl_mem> &A, const vclLayout &la,
+    const MaskHandle &M, const vclLayout &lm,
+    vclCompactPlan &plan, VecB &vcl_out)
+{
+    viennacl::ocl::context &ctx = viennacl::ocl::current_context();
+    viennacl::ocl::kernel &k = vclMaskKernels<T>::get(ctx, "compact_values");
+    k.local_work_size(0, GPUR_MASK_WG);
+    k.global_work_size(0, GPUR_MASK_WG * plan.ngroups);
+
+    viennacl::ocl::enqueue(k(
+        A, la.offset, la.row_stride, la.col_stride,
+        M.handle().opencl_handle(), lm.offset, lm.row_stride, lm.col_stride,
+        lm.size1, lm.size2, plan.chunk,
+        plan.offsets.opencl_handle(),
+        vcl_out.handle().opencl_handle(),
+        cl_uint(viennacl::traits::start(vcl_out)), cl_uint(viennacl::traits::stride(vcl_out))));
+}
+
+/* out <- which(M) */
+template <typename MaskHandle, typename VecB>
+void
+vcl_compact_index(
+    const MaskHandle &M, const vclLayout &lm,
+    vclCompactPlan &plan, VecB &vcl_out)
+{
+    viennacl::ocl::context &ctx = viennacl::ocl::current_context();
+    viennacl::ocl::kernel &k = vclMaskKernels<int>::get(ctx, "compact_index");
+    k.local_work_size(0, GPUR_MASK_WG);
+    k.global_work_size(0, GPUR_MASK_WG * plan.ngroups);
+
+    viennacl::ocl::enqueue(k(
+        M.handle().opencl_handle(), lm.offset, lm.row_stride, lm.col_stride,
+        lm.size1, lm.size2, plan.chunk,
+        plan.offsets.opencl_handle(),
+        vcl_out.handle().opencl_handle(),
+        cl_uint(viennacl::traits::start(vcl_out)), cl_uint(viennacl::traits::stride(vcl_out))));
+}
+
+/* Number of elements of A for which A op scalar (or abs(A) op scalar)
+ * holds, their sum and the number of NA comparisons, reduced in one
+ * pass over A without a mask.
+ */
+struct vclWhere {
+    double n;
+    double na;
+    double sum;
+};
+
+template <typename T>
+void
+vcl_where_reduce(
+    const viennacl::ocl::handle<cl_mem> &A, const vclLayout &la,
+    double scalar, unsigned int op, bool absolute,
+    vclWhere &out)
+{
+    viennacl::ocl::context &ctx = viennacl::ocl::current_context();
+
+    const bool int_acc = (viennacl::ocl::type_to_string<T>::apply() == "int");
+    const size_t acc_size = int_acc ? sizeof(cl_long) : sizeof(T);
+
+    const unsigned int n = la.size1 * la.size2;
+    const unsigned int ngroups = std::max(1u, std::min(
+        (n + GPUR_MASK_WG - 1) / GPUR_MASK_WG, (unsigned int)GPUR_MASK_WG));
+
+    viennacl::backend::mem_handle counts, sums;
+    viennacl::backend::memory_create(counts, sizeof(cl_uint) * 2 * ngroups, viennacl::context(ctx));
+    viennacl::backend::memory_create(sums, acc_size * ngroups, viennacl::context(ctx));
+
+    viennacl::ocl::kernel &k = vclMaskKernels<T>::get(ctx, "where_reduce");
+    k.local_work_size(0, GPUR_MASK_WG);
+    k.global_work_size(0, GPUR_MASK_WG * ngroups);
+
+    const T s = vcl_cmp_scalar<T>(scalar, op);
+
+    viennacl::ocl::enqueue(k(
+        A, la.offset, la.row_stride, la.col_stride, la.size1, la.size2,
+        s, cl_uint(op), cl_uint(absolute),
+        counts.opencl_handle(), sums.opencl_handle()));
+
+    // partial results of each work-group, combined on the host
+    std::vector<cl_uint> h_counts(2 * ngroups);
+    std::vector<char> h_sums(acc_size * ngroups);
+
+    viennacl::backend::memory_read(counts, 0, sizeof(cl_uint) * 2 * ngroups, &h_counts[0], true);
+    viennacl::backend::memory_read(sums, 0, acc_size * ngroups, &h_sums[0]);
+
+    cl_long isum = 0;
+    out.n = out.na = out.sum = 0;
+    for(unsigned int g = 0; g < ngroups; g++){
+        out.n += h_counts[2 * g];
+        out.na += h_counts[2 * g + 1];
+        if(int_acc){
+            isum += reinterpret_cast<cl_long *>(&h_sums[0])[g];
+        }else{
+            out.sum += reinterpret_cast<T *>(&h_sums[0])[g];
+        }
+    }
+    if(int_acc){
+        out.sum = static_cast<double>(isum);
+    }
+}
+
+/* C[i] <- count (what = 0), sum (1) or mean (2) of the row (byRow) or
+ * column i of A over the elements for which A op scalar holds.  C is
+ * integer for counts, T for sums and of mean_type for means.
+ */
+template <typename T>
+void
+vcl_where_margin(
+    const viennacl::ocl::handle<cl_mem> &A, const vclLayout &la,
+    double scalar, unsigned int op, bool absolute,
+    unsigned int what, bool na_rm, bool byRow,
+    const viennacl::ocl::handle<cl_mem> &C, const vclLayout &lc)
+{
+    viennacl::ocl::context &ctx = viennacl::ocl::current_context();
+    viennacl::ocl::kernel &k = vclMaskKernels<T>::get(ctx, byRow ? "where_rows" : "where_cols");
+
+    if(byRow){
+        k.local_work_size(0, GPUR_MASK_WG);
+        k.global_work_size(0, GPUR_MASK_WG * std::max(1u, std::min(la.size1, 4096u)));
+    }else{
+        vcl_mask_range(k, la.size2);
+    }
+
+    const T s = vcl_cmp_scalar<T>(scalar, op);
+
+    // only the output of type 'what' is written, C is passed for all three
+    viennacl::ocl::enqueue(k(
+        A, la.offset, la.row_stride, la.col_stride, la.size1, la.size2,
+        s, cl_uint(op), cl_uint(absolute),
+        cl_uint(what), cl_uint(na_rm),
+        C, C, C, lc.offset, lc.row_stride));
+}
+
+#endif
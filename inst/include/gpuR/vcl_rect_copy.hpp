@@ -0,0 +1,206 @@
+#pragma once
+#ifndef VCL_RECT_COPY
+#define VCL_RECT_COPY
+
+// Use OpenCL with ViennaCL
+#define VIENNACL_WITH_OPENCL 1
+
+// ViennaCL headers
+#include "viennacl/ocl/backend.hpp"
+#include "viennacl/ocl/context.hpp"
+#include "viennacl/ocl/kernel.hpp"
+#include "viennacl/ocl/utils.hpp"
+#include "viennacl/ocl/error.hpp"
+#include "viennacl/matrix.hpp"
+
+#include <string>
+
+// vclLayout and the launch size of the elementwise kernels
+#include "gpuR/vcl_mask_kernels.hpp"
+
+/* Host <-> device copies of matrix blocks.
+ *
+ * The host side is a column-major block with a leading dimension, e.g.
+ * a block of a gpuMatrix or an R matrix, and crosses the bus in one
+ * clEnqueue{Read,Write}BufferRect so the strides are walked by the
+ * transfer itself instead of the host packing the block first.  A rect
+ * copy cannot transpose, so a block of a row-major device matrix moves
+ * through a column-major scratch buffer and a single kernel converts
+ * between that and the padded device layout.  Column-major device
+ * blocks are copied in place.
+ */
+template <typename T>
+struct vclRectKernels {
+
+    static std::string program_name(){
+        return viennacl::ocl::type_to_string<T>::apply() + "_gpuR_rect";
+    }
+
+    static std::string source(viennacl::ocl::context &ctx){
+        const std::string type = viennacl::ocl::type_to_string<T>::apply();
+        std::string src;
+
+        if(type == "double"){
+            src += "#pragma OPENCL EXTENSION " + ctx.current_device().double_support_extension() + " : enable\n";
+        }
+        src += "#define T " + type + "\n";
+
+        src +=
+            "__kernel void repack(\n"
+            "    __global const T *A, uint a_off, uint a_rs, uint a_cs,\n"
+            "    uint size1, uint size2,\n"
+            "    __global T *C, uint c_off, uint c_rs, uint c_cs)\n"
+            "{\n"
+            "    const uint n = size1 * size2;\n"
+            "    for(uint k = get_global_id(0); k < n; k += get_global_size(0)){\n"
+            "        const uint i = k % size1;\n"
+            "        const uint j = k / size1;\n"
+            "        C[c_off + i * c_rs + j * c_cs] = A[a_off + i * a_rs + j * a_cs];\n"
+            "    }\n"
+            "}\n";
+
+        return src;
+    }
+
+    static void init(viennacl::ocl::context &ctx){
+        if(!ctx.has_program(program_name())){
+            ctx.add_program(source(ctx), program_name());
+        }
+    }
+
+    static viennacl::ocl::kernel & get(viennacl::ocl::context &ctx, const std::string &name){
+        init(ctx);
+        return ctx.get_kernel(program_name(), name);
+    }
+};
+
+// column-major block of size1 x size2 elements starting at element
+// 'offset' of buf, columns 'ld' elements apart
+struct vclRect {
+    size_t offset;
+    size_t ld;
+    size_t size1;
+    size_t size2;
+};
+
+// the rect transfer itself, blocking so the host block may go out of
+// scope on return
+template <typename T>
+void
+vcl_rect_transfer(
+    viennacl::ocl::context &ctx, bool write,
+    const viennacl::ocl::handle<cl_mem> &buf, const vclRect &r,
+    T *host, size_t host_ld)
+{
+    // a single column has no column pitch to honor
+    const size_t ld = r.size2 == 1 ? r.size1 : r.ld;
+    host_ld = r.size2 == 1 ? r.size1 : host_ld;
+
+    size_t buffer_origin[3] = {(r.offset % ld) * sizeof(T), r.offset / ld, 0};
+    size_t host_origin[3] = {0, 0, 0};
+    size_t region[3] = {r.size1 * sizeof(T), r.size2, 1};
+
+    cl_int err;
+    if(write){
+        err = clEnqueueWriteBufferRect(
+            ctx.get_queue().handle().get(), buf.get(), CL_TRUE,
+            buffer_origin, host_origin, region,
+            ld * sizeof(T), 0, host_ld * sizeof(T), 0,
+            host, 0, NULL, NULL);
+    }else{
+        err = clEnqueueReadBufferRect(
+            ctx.get_queue().handle().get(), buf.get(), CL_TRUE,
+            buffer_origin, host_origin, region,
+            ld * sizeof(T), 0, host_ld * sizeof(T), 0,
+            host, 0, NULL, NULL);
+    }
+    VIENNACL_ERR_CHECK(err);
+}
+
+// device block as a rect if its layout is column-major
+inline
+bool
+vcl_rect_of(const vclLayout &l, vclRect &r)
+{
+    if(l.row_stride != 1 && l.size1 != 1){
+        return false;
+    }
+    if(l.size2 > 1 && l.col_stride < l.size1){
+        return false;
+    }
+    r.offset = l.offset;
+    r.ld = l.col_stride;
+    r.size1 = l.size1;
+    r.size2 = l.size2;
+    return true;
+}
+
+// C <- A between two layouts of the same shape
+template <typename T>
+void
+vcl_repack(
+    viennacl::ocl::context &ctx,
+    const viennacl::ocl::handle<cl_mem> &A, const vclLayout &la,
+    const viennacl::ocl::handle<cl_mem> &C, const vclLayout &lc)
+{
+    viennacl::ocl::kernel &k = vclRectKernels<T>::get(ctx, "repack");
+    vcl_mask_range(k, la.size1 * la.size2);
+
+    viennacl::ocl::enqueue(k(
+        A, la.offset, la.row_stride, la.col_stride,
+        la.size1, la.size2,
+        C, lc.offset, lc.row_stride, lc.col_stride));
+}
+
+/* vcl_A <- host block (column-major, leading dimension ld) */
+template <typename T, typename MatA>
+void
+vcl_write_block(const T *host, size_t ld, MatA &vcl_A)
+{
+    const vclLayout l = vcl_matrix_layout(vcl_A);
+    if(l.size1 == 0 || l.size2 == 0) return;
+
+    viennacl::ocl::context &ctx = const_cast<viennacl::ocl::context &>(vcl_A.handle().opencl_handle().context());
+    T *src = const_cast<T *>(host);
+
+    vclRect r;
+    if(vcl_rect_of(l, r)){
+        vcl_rect_transfer<T>(ctx, true, vcl_A.handle().opencl_handle(), r, src, ld);
+        return;
+    }
+
+    viennacl::backend::mem_handle scratch;
+    viennacl::backend::memory_create(scratch, sizeof(T) * l.size1 * l.size2, viennacl::traits::context(vcl_A));
+
+    const vclRect packed = {0, l.size1, l.size1, l.size2};
+    const vclLayout lp = {0, 1, l.size1, l.size1, l.size2};
+    vcl_rect_transfer<T>(ctx, true, scratch.opencl_handle(), packed, src, ld);
+    vcl_repack<T>(ctx, scratch.opencl_handle(), lp, vcl_A.handle().opencl_handle(), l);
+}
+
+/* host block (column-major, leading dimension ld) <- vcl_A */
+template <typename T, typename MatA>
+void
+vcl_read_block(MatA &vcl_A, T *host, size_t ld)
+{
+    const vclLayout l = vcl_matrix_layout(vcl_A);
+    if(l.size1 == 0 || l.size2 == 0) return;
+
+    viennacl::ocl::context &ctx = const_cast<viennacl::ocl::context &>(vcl_A.handle().opencl_handle().context());
+
+    vclRect r;
+    if(vcl_rect_of(l, r)){
+        vcl_rect_transfer<T>(ctx, false, vcl_A.handle().opencl_handle(), r, host, ld);
+        return;
+    }
+
+    viennacl::backend::mem_handle scratch;
+    viennacl::backend::memory_create(scratch, sizeof(T) * l.size1 * l.size2, viennacl::traits::context(vcl_A));
+
+    const vclRect packed = {0, l.size1, l.size1, l.size2};
+    const vclLayout lp = {0, 1, l.size1, l.size1, l.size2};
+    vcl_repack<T>(ctx, vcl_A.handle().opencl_handle(), l, scratch.opencl_handle(), lp);
+    vcl_rect_transfer<T>(ctx, false, scratch.opencl_handle(), packed, host, ld);
+}
+
+#endif
@@ -0,0 +1,451 @@
+#pragma once
+#ifndef VCL_REDUCE_KERNELS
+#define VCL_REDUCE_KERNELS
+
+// Use OpenCL with ViennaCL
+#define VIENNACL_WITH_OPENCL 1
+
+// ViennaCL headers
+#include "viennacl/ocl/backend.hpp"
+#include "viennacl/ocl/context.hpp"
+#include "viennacl/ocl/kernel.hpp"
+#include "viennacl/ocl/utils.hpp"
+#include "viennacl/matrix.hpp"
+#include "viennacl/vector.hpp"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+// flags for the reductions
+#define GPUR_REDUCE_MAX 1
+#define GPUR_REDUCE_SKIP_NA 2
+
+// work-group size of the reduction kernels
+#define GPUR_REDUCE_WG 128
+
+// sentinel index for an empty partial result
+#define GPUR_REDUCE_EMPTY 0xFFFFFFFFu
+
+// a numeric macro as a string literal, to pass host constants into
+// kernel source
+#ifndef GPUR_STR
+#define GPUR_STR_(x) #x
+#define GPUR_STR(x) GPUR_STR_(x)
+#endif
+
+/* OpenCL reductions over a vclMatrix (or block) in a single kernel
+ * launch per stage instead of a launch and blocking read per column.
+ *
+ * Elements are visited in storage (row-major) order but indices are
+ * reported in R's column-major order and ties are broken towards the
+ * smallest index, so which.max/which.min return the first occurrence
+ * as in R.  NaN (NA_integer_ for integers) wins a max/min unless
+ * GPUR_REDUCE_SKIP_NA is set, in which case it is ignored.
+ */
+template <typename T>
+struct vclReduceKernels {
+
+    static std::string program_name(){
+        return viennacl::ocl::type_to_string<T>::apply() + "_gpuR_reduce";
+    }
+
+    // integer and float products are accumulated in double where available
+    static std::string prod_type(viennacl::ocl::context &ctx){
+        const std::string type = viennacl::ocl::type_to_string<T>::apply();
+        if(type == "double") return type;
+        return ctx.current_device().double_support() ? "double" : "float";
+    }
+
+    // integer sums are accumulated in 64 bit, float sums as the products
+    static std::string acc_type(viennacl::ocl::context &ctx){
+        const std::string type = viennacl::ocl::type_to_string<T>::apply();
+        if(type == "int") return "long";
+        return prod_type(ctx);
+    }
+
+    static std::string source(viennacl::ocl::context &ctx){
+        const std::string type = viennacl::ocl::type_to_string<T>::apply();
+        std::string src;
+
+        if(type == "double" || prod_type(ctx) == "double"){
+            src += "#pragma OPENCL EXTENSION " + ctx.current_device().double_support_extension() + " : enable\n";
+        }
+        src += "#define T " + type + "\n";
+        if(type == "int"){
+            src += "#define IS_NA(x) ((x) == INT_MIN)\n";
+            src += "#define T_LOWEST INT_MIN\n";
+            src += "#define T_HIGHEST INT_MAX\n";
+        }else{
+            src += "#define IS_NA(x) isnan(x)\n";
+            src += "#define T_LOWEST (-INFINITY)\n";
+            src += "#define T_HIGHEST INFINITY\n";
+        }
+        // accumulators for sum and prod
+        src += "#define ACC " + acc_type(ctx) + "\n";
+        src += "#define PROD " + prod_type(ctx) + "\n";
+
+        // the work-group size the host launches with
+        src += "#define WG " GPUR_STR(GPUR_REDUCE_WG) "\n";
+        src += "#define EMPTY " GPUR_STR(GPUR_REDUCE_EMPTY) "\n";
+
+        src +=
+            "\n"
+            "inline int arg_better(T v, uint i, T bv, uint bi, uint flags)\n"
+            "{\n"
+            "    if(i == EMPTY) return 0;\n"
+            "    if(bi == EMPTY) return 1;\n"
+            "    int vn = IS_NA(v), bn = IS_NA(bv);\n"
+            "    if(vn || bn) return (vn && bn) ? i < bi : vn;\n"
+            "    if(v == bv) return i < bi;\n"
+            "    return (flags & 1) ? v > bv : v < bv;\n"
+            "}\n"
+            "\n"
+            // local tree reduction, result left in lv[0]/li[0]
+            "inline void arg_reduce_local(__local T *lv, __local uint *li, T bv, uint bi, uint flags)\n"
+            "{\n"
+            "    uint lid = get_local_id(0);\n"
+            "    lv[lid] = bv;\n"
+            "    li[lid] = bi;\n"
+            "    for(uint s = get_local_size(0) / 2; s > 0; s >>= 1){\n"
+            "        barrier(CLK_LOCAL_MEM_FENCE);\n"
+            "        if(lid < s && arg_better(lv[lid + s], li[lid + s], bv, bi, flags)){\n"
+            "            bv = lv[lid + s];\n"
+            "            bi = li[lid + s];\n"
+            "            lv[lid] = bv;\n"
+            "            li[lid] = bi;\n"
+            "        }\n"
+            "    }\n"
+            "    barrier(CLK_LOCAL_MEM_FENCE);\n"
+            "}\n"
+            "\n"
+            // first stage, one partial result per work-group
+            "__kernel void arg_reduce_2d(\n"
+            "    __global const T *A, uint start1, uint start2, uint internal_size2,\n"
+            "    uint size1, uint size2, uint flags,\n"
+            "    __global T *vals, __global uint *idx)\n"
+            "{\n"
+            "    __local T lv[WG];\n"
+            "    __local uint li[WG];\n"
+            "    T bv = 0;\n"
+            "    uint bi = EMPTY;\n"
+            "    uint n = size1 * size2;\n"
+            "    for(uint k = get_global_id(0); k < n; k += get_global_size(0)){\n"
+            "        uint i = k / size2;\n"
+            "        uint j = k % size2;\n"
+            "        T v = A[(start1 + i) * internal_size2 + start2 + j];\n"
+            "        if((flags & 2) && IS_NA(v)) continue;\n"
+            "        uint r = i + j * size1;\n"
+            "        if(arg_better(v, r, bv, bi, flags)){ bv = v; bi = r; }\n"
+            "    }\n"
+            "    arg_reduce_local(lv, li, bv, bi, flags);\n"
+            "    if(get_local_id(0) == 0){\n"
+            "        vals[get_group_id(0)] = lv[0];\n"
+            "        idx[get_group_id(0)] = li[0];\n"
+            "    }\n"
+            "}\n"
+            "\n"
+            // second stage, a single work-group over the partial results
+            "__kernel void arg_reduce_1d(\n"
+            "    __global const T *vals_in, __global const uint *idx_in, uint n, uint flags,\n"
+            "    __global T *vals, __global uint *idx)\n"
+            "{\n"
+            "    __local T lv[WG];\n"
+            "    __local uint li[WG];\n"
+            "    T bv = 0;\n"
+            "    uint bi = EMPTY;\n"
+            "    for(uint k = get_local_id(0); k < n; k += get_local_size(0)){\n"
+            "        if(arg_better(vals_in[k], idx_in[k], bv, bi, flags)){ bv = vals_in[k]; bi = idx_in[k]; }\n"
+            "    }\n"
+            "    arg_reduce_local(lv, li, bv, bi, flags);\n"
+            "    if(get_local_id(0) == 0){\n"
+            "        vals[0] = lv[0];\n"
+            "        idx[0] = li[0];\n"
+            "    }\n"
+            "}\n"
+            "\n"
+            // one work-group per row, rows are contiguous in memory
+            "__kernel void row_reduce_2d(\n"
+            "    __global const T *A, uint start1, uint start2, uint internal_size2,\n"
+            "    uint size1, uint size2, uint flags,\n"
+            "    __global T *out, uint out_start)\n"
+            "{\n"
+            "    __local T lv[WG];\n"
+            "    __local uint li[WG];\n"
+            "    for(uint i = get_group_id(0); i < size1; i += get_num_groups(0)){\n"
+            "        __global const T *row = A + (start1 + i) * internal_size2 + start2;\n"
+            "        T bv = 0;\n"
+            "        uint bi = EMPTY;\n"
+            "        for(uint j = get_local_id(0); j < size2; j += get_local_size(0)){\n"
+            "            T v = row[j];\n"
+            "            if((flags & 2) && IS_NA(v)) continue;\n"
+            "            if(arg_better(v, j, bv, bi, flags)){ bv = v; bi = j; }\n"
+            "        }\n"
+            "        arg_reduce_local(lv, li, bv, bi, flags);\n"
+            "        if(get_local_id(0) == 0){\n"
+            "            out[out_start + i] = lv[0];\n"
+            "        }\n"
+            "    }\n"
+            "}\n"
+            "\n"
+            // one work-item per column, neighbouring work-items read
+            // neighbouring elements of each row
+            "__kernel void col_reduce_2d(\n"
+            "    __global const T *A, uint start1, uint start2, uint internal_size2,\n"
+            "    uint size1, uint size2, uint flags,\n"
+            "    __global T *out, uint out_start)\n"
+            "{\n"
+            "    for(uint j = get_global_id(0); j < size2; j += get_global_size(0)){\n"
+            "        T bv = 0;\n"
+            "        uint bi = EMPTY;\n"
+            "        for(uint i = 0; i < size1; i++){\n"
+            "            T v = A[(start1 + i) * internal_size2 + start2 + j];\n"
+            "            if((flags & 2) && IS_NA(v)) continue;\n"
+            "            if(arg_better(v, i, bv, bi, flags)){ bv = v; bi = i; }\n"
+            "        }\n"
+            "        out[out_start + j] = bv;\n"
+            "    }\n"
+            "}\n"
+            "\n"
+            // every statistic of the Summary group in one pass, one partial
+            // result per work-group; counts holds the number of valid, NA
+            // and non-zero elements
+            "__kernel void summary_2d(\n"
+            "    __global const T *A, uint start1, uint start2, uint internal_size2,\n"
+            "    uint size1, uint size2,\n"
+            "    __global ACC *sums, __global PROD *prods,\n"
+            "    __global T *mins, __global T *maxs, __global uint *counts)\n"
+            "{\n"
+            "    __local ACC ls[WG];\n"
+            "    __local PROD lp[WG];\n"
+            "    __local T lmin[WG];\n"
+            "    __local T lmax[WG];\n"
+            "    __local uint ln[WG];\n"
+            "    __local uint lna[WG];\n"
+            "    __local uint lnz[WG];\n"
+            "    uint lid = get_local_id(0);\n"
+            "    ACC s = 0;\n"
+            "    PROD p = 1;\n"
+            "    T mn = T_HIGHEST;\n"
+            "    T mx = T_LOWEST;\n"
+            "    uint n = 0, na = 0, nz = 0;\n"
+            "    uint len = size1 * size2;\n"
+            "    for(uint k = get_global_id(0); k < len; k += get_global_size(0)){\n"
+            "        T v = A[(start1 + k / size2) * internal_size2 + start2 + k % size2];\n"
+            "        if(IS_NA(v)){ na++; continue; }\n"
+            "        s += v;\n"
+            "        p *= v;\n"
+            "        mn = v < mn ? v : mn;\n"
+            "        mx = v > mx ? v : mx;\n"
+            "        n++;\n"
+            "        nz += (v != 0);\n"
+            "    }\n"
+            "    ls[lid] = s; lp[lid] = p; lmin[lid] = mn; lmax[lid] = mx;\n"
+            "    ln[lid] = n; lna[lid] = na; lnz[lid] = nz;\n"
+            "    for(uint stride = get_local_size(0) / 2; stride > 0; stride >>= 1){\n"
+            "        barrier(CLK_LOCAL_MEM_FENCE);\n"
+            "        if(lid < stride){\n"
+            "            uint o = lid + stride;\n"
+            "            ls[lid] += ls[o];\n"
+            "            lp[lid] *= lp[o];\n"
+            "            lmin[lid] = lmin[o] < lmin[lid] ? lmin[o] : lmin[lid];\n"
+            "            lmax[lid] = lmax[o] > lmax[lid] ? lmax[o] : lmax[lid];\n"
+            "            ln[lid] += ln[o];\n"
+            "            lna[lid] += lna[o];\n"
+            "            lnz[lid] += lnz[o];\n"
+            "        }\n"
+            "    }\n"
+            "    if(lid == 0){\n"
+            "        uint g = get_group_id(0);\n"
+            "        sums[g] = ls[0];\n"
+            "        prods[g] = lp[0];\n"
+            "        mins[g] = lmin[0];\n"
+            "        maxs[g] = lmax[0];\n"
+            "        counts[3 * g] = ln[0];\n"
+            "        counts[3 * g + 1] = lna[0];\n"
+            "        counts[3 * g + 2] = lnz[0];\n"
+            "    }\n"
+            "}\n";
+
+        return src;
+    }
+
+    static void init(viennacl::ocl::context &ctx){
+        if(!ctx.has_program(program_name())){
+            ctx.add_program(source(ctx), program_name());
+        }
+    }
+
+    static viennacl::ocl::kernel & get(viennacl::ocl::context &ctx, const std::string &name){
+        init(ctx);
+        return ctx.get_kernel(program_name(), name);
+    }
+};
+
+/* Every statistic of the R Summary group for a matrix (range).
+ * min/max are only meaningful when n > 0.
+ */
+template <typename T>
+struct vclSummary {
+    double sum;
+    double prod;
+    T min;
+    T max;
+    double n;
+    double na;
+    double nonzero;
+};
+
+template <typename T, typename MatA>
+void
+vcl_summary(MatA &vcl_A, vclSummary<T> &out)
+{
+    viennacl::ocl::context &ctx = viennacl::ocl::current_context();
+
+    const std::string acc = vclReduceKernels<T>::acc_type(ctx);
+    const bool int_acc = (acc == "long");
+    const bool dbl_acc = (acc == "double");
+    const bool dbl_prod = (vclReduceKernels<T>::prod_type(ctx) == "double");
+    const size_t acc_size = int_acc ? sizeof(cl_long) : (dbl_acc ? sizeof(cl_double) : sizeof(cl_float));
+    const size_t prod_size = dbl_prod ? sizeof(cl_double) : sizeof(cl_float);
+
+    const unsigned int n = vcl_A.size1() * vcl_A.size2();
+    const unsigned int ngroups = std::max(1u, std::min(
+        (unsigned int)GPUR_REDUCE_WG, (n + GPUR_REDUCE_WG - 1) / GPUR_REDUCE_WG));
+
+    viennacl::backend::mem_handle sums, prods, mins, maxs, counts;
+    viennacl::backend::memory_create(sums, acc_size * ngroups, viennacl::traits::context(vcl_A));
+    viennacl::backend::memory_create(prods, prod_size * ngroups, viennacl::traits::context(vcl_A));
+    viennacl::backend::memory_create(mins, sizeof(T) * ngroups, viennacl::traits::context(vcl_A));
+    viennacl::backend::memory_create(maxs, sizeof(T) * ngroups, viennacl::traits::context(vcl_A));
+    viennacl::backend::memory_create(counts, sizeof(cl_uint) * 3 * ngroups, viennacl::traits::context(vcl_A));
+
+    viennacl::ocl::kernel &k = vclReduceKernels<T>::get(ctx, "summary_2d");
+    k.local_work_size(0, GPUR_REDUCE_WG);
+    k.global_work_size(0, GPUR_REDUCE_WG * ngroups);
+
+    viennacl::ocl::enqueue(k(
+        vcl_A.handle().opencl_handle(),
+        cl_uint(viennacl::traits::start1(vcl_A)), cl_uint(viennacl::traits::start2(vcl_A)),
+        cl_uint(viennacl::traits::internal_size2(vcl_A)),
+        cl_uint(vcl_A.size1()), cl_uint(vcl_A.size2()),
+        sums.opencl_handle(), prods.opencl_handle(),
+        mins.opencl_handle(), maxs.opencl_handle(), counts.opencl_handle()));
+
+    // partial results of each work-group, combined on the host
+    std::vector<char> h_sums(acc_size * ngroups), h_prods(prod_size * ngroups);
+    std::vector<T> h_mins(ngroups), h_maxs(ngroups);
+    std::vector<cl_uint> h_counts(3 * ngroups);
+
+    viennacl::backend::memory_read(sums, 0, acc_size * ngroups, &h_sums[0], true);
+    viennacl::backend::memory_read(prods, 0, prod_size * ngroups, &h_prods[0], true);
+    viennacl::backend::memory_read(mins, 0, sizeof(T) * ngroups, &h_mins[0], true);
+    viennacl::backend::memory_read(maxs, 0, sizeof(T) * ngroups, &h_maxs[0], true);
+    viennacl::backend::memory_read(counts, 0, sizeof(cl_uint) * 3 * ngroups, &h_counts[0]);
+
+    cl_long isum = 0;
+    out.sum = 0;
+    out.prod = 1;
+    out.n = out.na = out.nonzero = 0;
+    out.min = h_mins[0];
+    out.max = h_maxs[0];
+
+    for(unsigned int g = 0; g < ngroups; g++){
+        if(int_acc){
+            isum += reinterpret_cast<cl_long *>(&h_sums[0])[g];
+        }else if(dbl_acc){
+            out.sum += reinterpret_cast<cl_double *>(&h_sums[0])[g];
+        }else{
+            out.sum += reinterpret_cast<cl_float *>(&h_sums[0])[g];
+        }
+        if(dbl_prod){
+            out.prod *= reinterpret_cast<cl_double *>(&h_prods[0])[g];
+        }else{
+            out.prod *= reinterpret_cast<cl_float *>(&h_prods[0])[g];
+        }
+        out.min = std::min(out.min, h_mins[g]);
+        out.max = std::max(out.max, h_maxs[g]);
+        out.n += h_counts[3 * g];
+        out.na += h_counts[3 * g + 1];
+        out.nonzero += h_counts[3 * g + 2];
+    }
+
+    if(int_acc){
+        out.sum = static_cast<double>(isum);
+    }
+}
+
+/* max/min of a matrix (range) and the column-major index of its first
+ * occurrence.  index is GPUR_REDUCE_EMPTY if no element qualified.
+ */
+template <typename T, typename MatA>
+void
+vcl_arg_reduce(MatA &vcl_A, unsigned int flags, T &value, unsigned int &index)
+{
+    viennacl::ocl::context &ctx = viennacl::ocl::current_context();
+
+    const unsigned int n = vcl_A.size1() * vcl_A.size2();
+    const unsigned int ngroups = std::max(1u, std::min(
+        (unsigned int)GPUR_REDUCE_WG, (n + GPUR_REDUCE_WG - 1) / GPUR_REDUCE_WG));
+
+    viennacl::backend::mem_handle part_vals, part_idx, vals, idx;
+    viennacl::backend::memory_create(part_vals, sizeof(T) * ngroups, viennacl::traits::context(vcl_A));
+    viennacl::backend::memory_create(part_idx, sizeof(cl_uint) * ngroups, viennacl::traits::context(vcl_A));
+    viennacl::backend::memory_create(vals, sizeof(T), viennacl::traits::context(vcl_A));
+    viennacl::backend::memory_create(idx, sizeof(cl_uint), viennacl::traits::context(vcl_A));
+
+    viennacl::ocl::kernel &k1 = vclReduceKernels<T>::get(ctx, "arg_reduce_2d");
+    k1.local_work_size(0, GPUR_REDUCE_WG);
+    k1.global_work_size(0, GPUR_REDUCE_WG * ngroups);
+
+    viennacl::ocl::enqueue(k1(
+        vcl_A.handle().opencl_handle(),
+        cl_uint(viennacl::traits::start1(vcl_A)), cl_uint(viennacl::traits::start2(vcl_A)),
+        cl_uint(viennacl::traits::internal_size2(vcl_A)),
+        cl_uint(vcl_A.size1()), cl_uint(vcl_A.size2()), cl_uint(flags),
+        part_vals.opencl_handle(), part_idx.opencl_handle()));
+
+    viennacl::ocl::kernel &k2 = vclReduceKernels<T>::get(ctx, "arg_reduce_1d");
+    k2.local_work_size(0, GPUR_REDUCE_WG);
+    k2.global_work_size(0, GPUR_REDUCE_WG);
+
+    viennacl::ocl::enqueue(k2(
+        part_vals.opencl_handle(), part_idx.opencl_handle(),
+        cl_uint(ngroups), cl_uint(flags),
+        vals.opencl_handle(), idx.opencl_handle()));
+
+    cl_uint idx_out;
+    viennacl::backend::memory_read(vals, 0, sizeof(T), &value, true);
+    viennacl::backend::memory_read(idx, 0, sizeof(cl_uint), &idx_out);
+    index = idx_out;
+}
+
+/* max/min of each row (byRow = true) or column of a matrix (range)
+ * written to a vector (range) on the same context
+ */
+template <typename T, typename MatA, typename VecB>
+void
+vcl_margin_reduce(MatA &vcl_A, VecB &vcl_B, unsigned int flags, bool byRow)
+{
+    viennacl::ocl::context &ctx = viennacl::ocl::current_context();
+
+    viennacl::ocl::kernel &k = vclReduceKernels<T>::get(ctx, byRow ? "row_reduce_2d" : "col_reduce_2d");
+
+    const unsigned int n = byRow ? vcl_A.size1() : vcl_A.size2();
+    if(byRow){
+        k.local_work_size(0, GPUR_REDUCE_WG);
+        k.global_work_size(0, GPUR_REDUCE_WG * std::max(1u, std::min(n, 4096u)));
+    }else{
+        k.local_work_size(0, GPUR_REDUCE_WG);
+        k.global_work_size(0, GPUR_REDUCE_WG * std::max(1u, std::min((n + GPUR_REDUCE_WG - 1) / GPUR_REDUCE_WG, 4096u)));
+    }
+
+    viennacl::ocl::enqueue(k(
+        vcl_A.handle().opencl_handle(),
+        cl_uint(viennacl::traits::start1(vcl_A)), cl_uint(viennacl::traits::start2(vcl_A)),
+        cl_uint(viennacl::traits::internal_size2(vcl_A)),
+        cl_uint(vcl_A.size1()), cl_uint(vcl_A.size2()), cl_uint(flags),
+        vcl_B.handle().opencl_handle(), cl_uint(viennacl::traits::start(vcl_B))));
+}
+
+#endif
@@ -0,0 +1,167 @@
+#pragma once
+#ifndef VCL_STATS_HELPERS
+#define VCL_STATS_HELPERS
+
+// Device side statistics shared by the gpuMatrix/vclMatrix functions
+// and the standalone benchmarks (inst/benchmarks/cpp).  These only
+// depend on ViennaCL so they can be used without R.
+
+// Use OpenCL with ViennaCL
+#define VIENNACL_WITH_OPENCL 1
+
+// ViennaCL headers
+#include "viennacl/matrix.hpp"
+#include "viennacl/vector.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/sum.hpp"
+
+#include <algorithm>
+#include <vector>
+
+// pearson covariance of the columns of A written to B
+template <typename T, typename MatA, typename MatB>
+void
+vcl_pmcc(MatA &vcl_A, MatB &vcl_B)
+{
+    const int M = vcl_A.size2();
+    const int K = vcl_A.size1();
+
+    viennacl::vector<T> ones = viennacl::scalar_vector<T>(K, 1);
+    viennacl::vector<T> vcl_meanVec(M);
+    viennacl::matrix<T> vcl_meanMat(K,M);
+
+    // vector of column means
+    vcl_meanVec = viennacl::linalg::column_sum(vcl_A);
+    vcl_meanVec *= (T)(1)/(T)(K);
+
+    // matrix of means
+    vcl_meanMat = viennacl::linalg::outer_prod(ones, vcl_meanVec);
+
+    viennacl::matrix<T> tmp = vcl_A - vcl_meanMat;
+
+    // calculate pearson covariance
+    vcl_B = viennacl::linalg::prod(trans(tmp), tmp);
+    vcl_B *= (T)(1)/(T)(K-1);
+}
+
+// euclidean distance between the rows of A written to D
+template <typename T, typename MatA, typename MatD>
+void
+vcl_eucl(MatA &vcl_A, MatD &vcl_D, bool squareDist)
+{
+    viennacl::vector<T> vcl_sqrt;
+
+    // this will definitely need to be updated with the next ViennaCL release
+    // currently doesn't support the single scalar operation with
+    // element_pow below
+    {
+        viennacl::matrix<T> twos = viennacl::scalar_matrix<T>(vcl_A.size1(), vcl_A.size2(), 2);
+
+        viennacl::matrix<T> square_A = viennacl::linalg::element_pow(vcl_A, twos);
+        vcl_sqrt = viennacl::linalg::row_sum(square_A);
+    }
+
+    {
+        viennacl::vector<T> row_ones = viennacl::scalar_vector<T>(vcl_A.size1(), 1);
+        vcl_D = viennacl::linalg::outer_prod(vcl_sqrt, row_ones);
+    }
+
+    vcl_D += trans(vcl_D);
+
+    vcl_D -= 2 * (viennacl::linalg::prod(vcl_A, trans(vcl_A)));
+
+    if(!squareDist){
+        vcl_D = viennacl::linalg::element_sqrt(vcl_D);
+    }
+
+    for(unsigned int i=0; i < vcl_D.size1(); i++){
+        vcl_D(i,i) = 0;
+    }
+}
+
+// euclidean distance between the rows of A and the rows of B written to D
+template <typename T, typename MatA, typename MatB, typename MatD>
+void
+vcl_peucl(MatA &vcl_A, MatB &vcl_B, MatD &vcl_D, bool squareDist)
+{
+    viennacl::matrix<T> square_A;
+    viennacl::matrix<T> square_B;
+
+    // this will definitely need to be updated with the next ViennaCL release
+    // currently doesn't support the single scalar operation with
+    // element_pow below
+    {
+        viennacl::matrix<T> twos = viennacl::scalar_matrix<T>(
+            std::max(vcl_A.size1(), vcl_B.size1()),
+            std::max(vcl_A.size2(), vcl_B.size2()), 2);
+
+        square_A = viennacl::linalg::element_pow(vcl_A, twos);
+        square_B = viennacl::linalg::element_pow(vcl_B, twos);
+    }
+
+    {
+        viennacl::vector<T> x_row_ones = viennacl::scalar_vector<T>(vcl_A.size1(), 1);
+        viennacl::vector<T> y_row_ones = viennacl::scalar_vector<T>(vcl_B.size1(), 1);
+
+        viennacl::vector<T> vcl_A_rowsum = viennacl::zero_vector<T>(vcl_A.size1());
+        viennacl::vector<T> vcl_B_rowsum = viennacl::zero_vector<T>(vcl_B.size1());
+
+        vcl_A_rowsum = viennacl::linalg::row_sum(square_A);
+        vcl_B_rowsum = viennacl::linalg::row_sum(square_B);
+
+        viennacl::matrix<T> vclXX = viennacl::linalg::outer_prod(vcl_A_rowsum, y_row_ones);
+        viennacl::matrix<T> vclYY = viennacl::linalg::outer_prod(x_row_ones, vcl_B_rowsum);
+
+        vcl_D = vclXX + vclYY;
+    }
+
+    vcl_D -= 2 * (viennacl::linalg::prod(vcl_A, trans(vcl_B)));
+
+    if(!squareDist){
+        vcl_D = viennacl::linalg::element_sqrt(vcl_D);
+    }
+}
+
+// columns of A centered by their means mu and divided by their root mean
+// squares sigma (the standard deviations once centered) as base scale()
+// does.  False, with A only centered, if a column can not be scaled.
+template <typename T>
+bool
+vcl_center_scale(
+    viennacl::matrix<T> &vcl_A, bool center, bool scale,
+    viennacl::vector<T> &vcl_mu, viennacl::vector<T> &vcl_sigma)
+{
+    const int M = vcl_A.size2();
+    const int K = vcl_A.size1();
+
+    viennacl::vector<T> ones = viennacl::scalar_vector<T>(K, 1);
+
+    if(center){
+        vcl_mu = viennacl::linalg::column_sum(vcl_A);
+        vcl_mu *= (T)(1)/(T)(K);
+
+        vcl_A -= viennacl::linalg::outer_prod(ones, vcl_mu);
+    }
+
+    if(scale){
+        {
+            viennacl::matrix<T> square_A = viennacl::linalg::element_prod(vcl_A, vcl_A);
+            vcl_sigma = viennacl::linalg::column_sum(square_A);
+        }
+        vcl_sigma *= (T)(1)/(T)(std::max(1, K-1));
+        vcl_sigma = viennacl::linalg::element_sqrt(vcl_sigma);
+
+        std::vector<T> sigma(M);
+        viennacl::copy(vcl_sigma, sigma);
+        if(std::find(sigma.begin(), sigma.end(), (T)(0)) != sigma.end()){
+            return false;
+        }
+
+        viennacl::matrix<T> vcl_sigmaMat = viennacl::linalg::outer_prod(ones, vcl_sigma);
+        vcl_A = viennacl::linalg::element_div(vcl_A, vcl_sigmaMat);
+    }
+
+    return true;
+}
+
+#endif
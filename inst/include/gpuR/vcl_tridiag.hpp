@@ -0,0 +1,271 @@
+#pragma once
+#ifndef VCL_TRIDIAG
+#define VCL_TRIDIAG
+
+// Use OpenCL with ViennaCL
+#define VIENNACL_WITH_OPENCL 1
+
+// ViennaCL headers
+#include "viennacl/ocl/backend.hpp"
+#include "viennacl/ocl/context.hpp"
+#include "viennacl/ocl/kernel.hpp"
+#include "viennacl/ocl/utils.hpp"
+#include "viennacl/matrix.hpp"
+#include "viennacl/matrix_proxy.hpp"
+#include "viennacl/vector_proxy.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/inner_prod.hpp"
+#include "viennacl/linalg/norm_2.hpp"
+
+#include <cmath>
+#include <limits>
+#include <string>
+#include <vector>
+
+// vclLayout and the launch size of the elementwise kernels
+#include "gpuR/vcl_mask_kernels.hpp"
+
+/* Symmetric eigenvalues without eigenvectors.
+ *
+ * The matrix is reduced to tridiagonal form on the device by Householder
+ * reflections applied from both sides as a symmetric rank 2 update, the
+ * reflections themselves are not kept.  The tridiagonal eigenvalues are
+ * found on the host by implicit QL, O(n^2) work against the O(n^3) of
+ * the reduction.  Eigenvalues are sorted decreasingly on the device by
+ * rank, NaN last, and the same order permutes the eigenvectors when
+ * there are any.
+ */
+template <typename T>
+struct vclTridiagKernels {
+
+    static std::string program_name(){
+        return viennacl::ocl::type_to_string<T>::apply() + "_gpuR_tridiag";
+    }
+
+    static std::string source(viennacl::ocl::context &ctx){
+        const std::string type = viennacl::ocl::type_to_string<T>::apply();
+        std::string src;
+
+        if(type == "double"){
+            src += "#pragma OPENCL EXTENSION " + ctx.current_device().double_support_extension() + " : enable\n";
+        }
+        src += "#define T " + type + "\n";
+
+        src +=
+            // whether v[j] sorts before v[i]: decreasing, NaN last and
+            // ties in index order, a total order so every rank is unique
+            "inline int rank_before(T vj, uint j, T vi, uint i)\n"
+            "{\n"
+            "    const int nj = isnan(vj), ni = isnan(vi);\n"
+            "    if(nj || ni) return (nj && ni) ? j < i : ni;\n"
+            "    return vj > vi || (vj == vi && j < i);\n"
+            "}\n"
+            "\n"
+            // order[r] is the index of the value of rank r
+            "__kernel void sort_rank(\n"
+            "    __global const T *v, uint off, uint inc, uint n,\n"
+            "    __global uint *order)\n"
+            "{\n"
+            "    for(uint i = get_global_id(0); i < n; i += get_global_size(0)){\n"
+            "        const T vi = v[off + i * inc];\n"
+            "        uint rank = 0;\n"
+            "        for(uint j = 0; j < n; j++){\n"
+            "            const T vj = v[off + j * inc];\n"
+            "            if(rank_before(vj, j, vi, i)) rank++;\n"
+            "        }\n"
+            "        order[rank] = i;\n"
+            "    }\n"
+            "}\n"
+            "\n"
+            // B[, j] <- A[, order[j]]
+            "__kernel void gather_cols(\n"
+            "    __global const T *A, uint off, uint rs, uint cs,\n"
+            "    __global T *B, uint boff, uint brs, uint bcs,\n"
+            "    __global const uint *order, uint size1, uint size2)\n"
+            "{\n"
+            "    const uint n = size1 * size2;\n"
+            "    for(uint k = get_global_id(0); k < n; k += get_global_size(0)){\n"
+            "        const uint i = k % size1;\n"
+            "        const uint j = k / size1;\n"
+            "        B[boff + i * brs + j * bcs] = A[off + i * rs + order[j] * cs];\n"
+            "    }\n"
+            "}\n";
+
+        return src;
+    }
+
+    static void init(viennacl::ocl::context &ctx){
+        if(!ctx.has_program(program_name())){
+            ctx.add_program(source(ctx), program_name());
+        }
+    }
+
+    static viennacl::ocl::kernel & get(viennacl::ocl::context &ctx, const std::string &name){
+        init(ctx);
+        return ctx.get_kernel(program_name(), name);
+    }
+};
+
+/* a vector layout seen as a single row, so its elements are columns */
+inline vclLayout
+vcl_row_layout(const vclLayout &lv)
+{
+    vclLayout l;
+    l.offset = lv.offset;
+    l.row_stride = 0;
+    l.col_stride = lv.row_stride;
+    l.size1 = 1;
+    l.size2 = lv.size1;
+    return l;
+}
+
+/* order <- the indices of the vector v by decreasing value */
+template <typename T>
+void
+vcl_sort_order(
+    const viennacl::ocl::handle<cl_mem> &v, const vclLayout &lv,
+    viennacl::backend::mem_handle &order)
+{
+    viennacl::ocl::context &ctx = viennacl::ocl::current_context();
+    viennacl::ocl::kernel &k = vclTridiagKernels<T>::get(ctx, "sort_rank");
+    vcl_mask_range(k, lv.size1);
+
+    viennacl::backend::memory_create(order, sizeof(cl_uint) * lv.size1,
+                                     viennacl::context(ctx));
+
+    viennacl::ocl::enqueue(k(
+        v, lv.offset, lv.row_stride, lv.size1,
+        order.opencl_handle()));
+}
+
+/* B[, j] <- A[, order[j]], A and B must not overlap */
+template <typename T>
+void
+vcl_gather_cols(
+    const viennacl::ocl::handle<cl_mem> &A, const vclLayout &la,
+    const viennacl::ocl::handle<cl_mem> &B, const vclLayout &lb,
+    const viennacl::backend::mem_handle &order)
+{
+    viennacl::ocl::context &ctx = viennacl::ocl::current_context();
+    viennacl::ocl::kernel &k = vclTridiagKernels<T>::get(ctx, "gather_cols");
+    vcl_mask_range(k, la.size1 * la.size2);
+
+    viennacl::ocl::enqueue(k(
+        A, la.offset, la.row_stride, la.col_stride,
+        B, lb.offset, lb.row_stride, lb.col_stride,
+        order.opencl_handle(), la.size1, la.size2));
+}
+
+/* d, e <- the diagonal and off-diagonal (e[i] couples i and i + 1,
+ * e[n - 1] is 0) of a tridiagonal matrix similar to the symmetric A.  A
+ * is overwritten.
+ */
+template <typename T>
+void
+vcl_tridiagonalize(viennacl::matrix<T> &A, std::vector<double> &d, std::vector<double> &e)
+{
+    const size_t n = A.size1();
+
+    d.assign(n, 0);
+    e.assign(n, 0);
+
+    for(size_t k = 0; k + 1 < n; k++){
+        const size_t m = n - k - 1;
+        viennacl::range rest(k + 1, n);
+
+        // x = A[k+1:n, k], v = x - alpha e_1 with |alpha| = |x|
+        viennacl::vector<T> col = viennacl::column(A, (unsigned int)k);
+        viennacl::vector<T> v = viennacl::project(col, rest);
+
+        const T x0 = v[0];
+        const T nrm = viennacl::linalg::norm_2(v);
+        if(nrm == 0){
+            continue;
+        }
+        const T alpha = x0 > 0 ? -nrm : nrm;
+        e[k] = alpha;
+
+        if(m == 1){
+            // a 1 x 1 reflection only flips the sign of e[k]
+            continue;
+        }
+
+        v[0] = x0 - alpha;
+        const T beta = T(1) / (nrm * (nrm + std::fabs(x0)));
+
+        // A22 <- H A22 H = A22 - v t(w) - w t(v)
+        viennacl::matrix_range<viennacl::matrix<T> > A22(A, rest, rest);
+        viennacl::vector<T> w = viennacl::linalg::prod(A22, v);
+        w *= beta;
+        const T K = beta * T(0.5) * viennacl::linalg::inner_prod(w, v);
+        w -= K * v;
+
+        A22 -= viennacl::linalg::outer_prod(v, w);
+        A22 -= viennacl::linalg::outer_prod(w, v);
+    }
+
+    viennacl::vector<T> vcl_d = viennacl::diag(A);
+    std::vector<T> dT(n);
+    viennacl::copy(vcl_d, dT);
+    d.assign(dT.begin(), dT.end());
+}
+
+/* d <- the eigenvalues of the symmetric tridiagonal (d, e) by implicit
+ * QL with Wilkinson shifts, e is destroyed.  False if an eigenvalue does
+ * not converge.
+ */
+inline bool
+tridiag_ql_values(std::vector<double> &d, std::vector<double> &e)
+{
+    const int n = (int)d.size();
+    const int maxit = 30;
+    const double eps = std::numeric_limits<double>::epsilon();
+
+    for(int l = 0; l < n; l++){
+        int iter = 0;
+        int m;
+        do{
+            for(m = l; m < n - 1; m++){
+                const double dd = std::fabs(d[m]) + std::fabs(d[m + 1]);
+                if(std::fabs(e[m]) <= eps * dd) break;
+            }
+            if(m != l){
+                if(iter++ == maxit) return false;
+
+                double g = (d[l + 1] - d[l]) / (2.0 * e[l]);
+                double r = std::sqrt(g * g + 1.0);
+                g = d[m] - d[l] + e[l] / (g + (g >= 0 ? r : -r));
+
+                double s = 1.0, c = 1.0, p = 0.0;
+                int i;
+                for(i = m - 1; i >= l; i--){
+                    double f = s * e[i];
+                    const double b = c * e[i];
+                    r = std::sqrt(f * f + g * g);
+                    e[i + 1] = r;
+                    if(r == 0){
+                        // underflow, deflate and start again
+                        d[i + 1] -= p;
+                        e[m] = 0;
+                        break;
+                    }
+                    s = f / r;
+                    c = g / r;
+                    g = d[i + 1] - p;
+                    r = (d[i] - g) * s + 2.0 * c * b;
+                    p = s * r;
+                    d[i + 1] = g + p;
+                    g = c * r - b;
+                }
+                if(r == 0 && i >= l) continue;
+                d[l] -= p;
+                e[l] = g;
+                e[m] = 0;
+            }
+        }while(m != l);
+    }
+
+    return true;
+}
+
+#endif
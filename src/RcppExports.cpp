@@ -114,6 +114,29 @@ BEGIN_RCPP
     return __result;
 END_RCPP
 }
+// cpp_share_gpuMatrix
+SEXP cpp_share_gpuMatrix(SEXP ptrA, const int type_flag);
+RcppExport SEXP gpuR_cpp_share_gpuMatrix(SEXP ptrASEXP, SEXP type_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject __result;
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
+    Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
+    __result = Rcpp::wrap(cpp_share_gpuMatrix(ptrA, type_flag));
+    return __result;
+END_RCPP
+}
+// cpp_gpuMatrix_detach
+void cpp_gpuMatrix_detach(SEXP ptrA, const int type_flag);
+RcppExport SEXP gpuR_cpp_gpuMatrix_detach(SEXP ptrASEXP, SEXP type_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
+    Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
+    cpp_gpuMatrix_detach(ptrA, type_flag);
+    return R_NilValue;
+END_RCPP
+}
 // cpp_cbind_gpuMatrix
 SEXP cpp_cbind_gpuMatrix(SEXP ptrA, SEXP ptrB, const int type_flag);
 RcppExport SEXP gpuR_cpp_cbind_gpuMatrix(SEXP ptrASEXP, SEXP ptrBSEXP, SEXP type_flagSEXP) {
@@ -140,6 +163,18 @@ BEGIN_RCPP
     return __result;
 END_RCPP
 }
+// cpp_gpuMatrix_append_rows
+void cpp_gpuMatrix_append_rows(SEXP ptrA, SEXP B, const int type_flag);
+RcppExport SEXP gpuR_cpp_gpuMatrix_append_rows(SEXP ptrASEXP, SEXP BSEXP, SEXP type_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
+    Rcpp::traits::input_parameter< SEXP >::type B(BSEXP);
+    Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
+    cpp_gpuMatrix_append_rows(ptrA, B, type_flag);
+    return R_NilValue;
+END_RCPP
+}
 // cpp_deepcopy_gpuVector
 SEXP cpp_deepcopy_gpuVector(SEXP ptrA, const int type_flag);
 RcppExport SEXP gpuR_cpp_deepcopy_gpuVector(SEXP ptrASEXP, SEXP type_flagSEXP) {
@@ -416,34 +451,6 @@ BEGIN_RCPP
     return __result;
 END_RCPP
 }
-// cpp_gpuMatrix_iaxpy
-void cpp_gpuMatrix_iaxpy(SEXP alpha_, SEXP ptrA_, SEXP ptrB_, SEXP sourceCode_, int device_type);
-RcppExport SEXP gpuR_cpp_gpuMatrix_iaxpy(SEXP alpha_SEXP, SEXP ptrA_SEXP, SEXP ptrB_SEXP, SEXP sourceCode_SEXP, SEXP device_typeSEXP) {
-BEGIN_RCPP
-    Rcpp::RNGScope __rngScope;
-    Rcpp::traits::input_parameter< SEXP >::type alpha_(alpha_SEXP);
-    Rcpp::traits::input_parameter< SEXP >::type ptrA_(ptrA_SEXP);
-    Rcpp::traits::input_parameter< SEXP >::type ptrB_(ptrB_SEXP);
-    Rcpp::traits::input_parameter< SEXP >::type sourceCode_(sourceCode_SEXP);
-    Rcpp::traits::input_parameter< int >::type device_type(device_typeSEXP);
-    cpp_gpuMatrix_iaxpy(alpha_, ptrA_, ptrB_, sourceCode_, device_type);
-    return R_NilValue;
-END_RCPP
-}
-// cpp_gpuMatrix_igemm
-void cpp_gpuMatrix_igemm(SEXP ptrA_, SEXP ptrB_, SEXP ptrC_, SEXP sourceCode_, int device_type);
-RcppExport SEXP gpuR_cpp_gpuMatrix_igemm(SEXP ptrA_SEXP, SEXP ptrB_SEXP, SEXP ptrC_SEXP, SEXP sourceCode_SEXP, SEXP device_typeSEXP) {
-BEGIN_RCPP
-    Rcpp::RNGScope __rngScope;
-    Rcpp::traits::input_parameter< SEXP >::type ptrA_(ptrA_SEXP);
-    Rcpp::traits::input_parameter< SEXP >::type ptrB_(ptrB_SEXP);
-    Rcpp::traits::input_parameter< SEXP >::type ptrC_(ptrC_SEXP);
-    Rcpp::traits::input_parameter< SEXP >::type sourceCode_(sourceCode_SEXP);
-    Rcpp::traits::input_parameter< int >::type device_type(device_typeSEXP);
-    cpp_gpuMatrix_igemm(ptrA_, ptrB_, ptrC_, sourceCode_, device_type);
-    return R_NilValue;
-END_RCPP
-}
 // cpp_gpu_two_vec
 void cpp_gpu_two_vec(SEXP ptrA_, SEXP ptrB_, SEXP ptrC_, SEXP sourceCode_, SEXP kernel_function_);
 RcppExport SEXP gpuR_cpp_gpu_two_vec(SEXP ptrA_SEXP, SEXP ptrB_SEXP, SEXP ptrC_SEXP, SEXP sourceCode_SEXP, SEXP kernel_function_SEXP) {
@@ -503,6 +510,54 @@ BEGIN_RCPP
     return __result;
 END_RCPP
 }
+// cpp_trace_start
+void cpp_trace_start();
+RcppExport SEXP gpuR_cpp_trace_start() {
+BEGIN_RCPP
+    Rcpp::RNGScope __rngScope;
+    cpp_trace_start();
+    return R_NilValue;
+END_RCPP
+}
+// cpp_trace_stop
+SEXP cpp_trace_stop();
+RcppExport SEXP gpuR_cpp_trace_stop() {
+BEGIN_RCPP
+    Rcpp::RObject __result;
+    Rcpp::RNGScope __rngScope;
+    __result = Rcpp::wrap(cpp_trace_stop());
+    return __result;
+END_RCPP
+}
+// cpp_trace_enabled
+bool cpp_trace_enabled();
+RcppExport SEXP gpuR_cpp_trace_enabled() {
+BEGIN_RCPP
+    Rcpp::RObject __result;
+    Rcpp::RNGScope __rngScope;
+    __result = Rcpp::wrap(cpp_trace_enabled());
+    return __result;
+END_RCPP
+}
+// cpp_trace_begin
+void cpp_trace_begin(SEXP name);
+RcppExport SEXP gpuR_cpp_trace_begin(SEXP nameSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type name(nameSEXP);
+    cpp_trace_begin(name);
+    return R_NilValue;
+END_RCPP
+}
+// cpp_trace_end
+void cpp_trace_end();
+RcppExport SEXP gpuR_cpp_trace_end() {
+BEGIN_RCPP
+    Rcpp::RNGScope __rngScope;
+    cpp_trace_end();
+    return R_NilValue;
+END_RCPP
+}
 // truncIntgpuMat
 SEXP truncIntgpuMat(SEXP ptrA_, int nr, int nc);
 RcppExport SEXP gpuR_truncIntgpuMat(SEXP ptrA_SEXP, SEXP nrSEXP, SEXP ncSEXP) {
@@ -641,27 +696,15 @@ BEGIN_RCPP
     return __result;
 END_RCPP
 }
-// cpp_gpuMatrix_max
-SEXP cpp_gpuMatrix_max(SEXP ptrA, const int type_flag);
-RcppExport SEXP gpuR_cpp_gpuMatrix_max(SEXP ptrASEXP, SEXP type_flagSEXP) {
-BEGIN_RCPP
-    Rcpp::RObject __result;
-    Rcpp::RNGScope __rngScope;
-    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
-    Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
-    __result = Rcpp::wrap(cpp_gpuMatrix_max(ptrA, type_flag));
-    return __result;
-END_RCPP
-}
-// cpp_gpuMatrix_min
-SEXP cpp_gpuMatrix_min(SEXP ptrA, const int type_flag);
-RcppExport SEXP gpuR_cpp_gpuMatrix_min(SEXP ptrASEXP, SEXP type_flagSEXP) {
+// cpp_gpuMatrix_extrema
+SEXP cpp_gpuMatrix_extrema(SEXP ptrA, const int type_flag);
+RcppExport SEXP gpuR_cpp_gpuMatrix_extrema(SEXP ptrASEXP, SEXP type_flagSEXP) {
 BEGIN_RCPP
     Rcpp::RObject __result;
     Rcpp::RNGScope __rngScope;
     Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
     Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
-    __result = Rcpp::wrap(cpp_gpuMatrix_min(ptrA, type_flag));
+    __result = Rcpp::wrap(cpp_gpuMatrix_extrema(ptrA, type_flag));
     return __result;
 END_RCPP
 }
@@ -776,6 +819,42 @@ BEGIN_RCPP
     return __result;
 END_RCPP
 }
+// cpp_share_vclMatrix
+SEXP cpp_share_vclMatrix(SEXP ptrA, const int type_flag);
+RcppExport SEXP gpuR_cpp_share_vclMatrix(SEXP ptrASEXP, SEXP type_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject __result;
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
+    Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
+    __result = Rcpp::wrap(cpp_share_vclMatrix(ptrA, type_flag));
+    return __result;
+END_RCPP
+}
+// cpp_vclMatrix_detach
+void cpp_vclMatrix_detach(SEXP ptrA, const int type_flag);
+RcppExport SEXP gpuR_cpp_vclMatrix_detach(SEXP ptrASEXP, SEXP type_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
+    Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
+    cpp_vclMatrix_detach(ptrA, type_flag);
+    return R_NilValue;
+END_RCPP
+}
+// cpp_vclMatrix_overlap
+bool cpp_vclMatrix_overlap(SEXP ptrA, SEXP ptrB, const int type_flag);
+RcppExport SEXP gpuR_cpp_vclMatrix_overlap(SEXP ptrASEXP, SEXP ptrBSEXP, SEXP type_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject __result;
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrB(ptrBSEXP);
+    Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
+    __result = Rcpp::wrap(cpp_vclMatrix_overlap(ptrA, ptrB, type_flag));
+    return __result;
+END_RCPP
+}
 // cpp_deepcopy_vclVector
 SEXP cpp_deepcopy_vclVector(SEXP ptrA, const int type_flag);
 RcppExport SEXP gpuR_cpp_deepcopy_vclVector(SEXP ptrASEXP, SEXP type_flagSEXP) {
@@ -818,6 +897,20 @@ BEGIN_RCPP
     return __result;
 END_RCPP
 }
+// cpp_bind_vclMatrix
+SEXP cpp_bind_vclMatrix(Rcpp::List ptrs, bool byRow, int type_flag, int device_flag);
+RcppExport SEXP gpuR_cpp_bind_vclMatrix(SEXP ptrsSEXP, SEXP byRowSEXP, SEXP type_flagSEXP, SEXP device_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject __result;
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< Rcpp::List >::type ptrs(ptrsSEXP);
+    Rcpp::traits::input_parameter< bool >::type byRow(byRowSEXP);
+    Rcpp::traits::input_parameter< int >::type type_flag(type_flagSEXP);
+    Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
+    __result = Rcpp::wrap(cpp_bind_vclMatrix(ptrs, byRow, type_flag, device_flag));
+    return __result;
+END_RCPP
+}
 // cpp_cbind_vclMatrix
 SEXP cpp_cbind_vclMatrix(SEXP ptrA, SEXP ptrB, int type_flag, int device_flag);
 RcppExport SEXP gpuR_cpp_cbind_vclMatrix(SEXP ptrASEXP, SEXP ptrBSEXP, SEXP type_flagSEXP, SEXP device_flagSEXP) {
@@ -846,6 +939,19 @@ BEGIN_RCPP
     return __result;
 END_RCPP
 }
+// cpp_vclMatrix_append_rows
+void cpp_vclMatrix_append_rows(SEXP ptrA, SEXP B, bool device, int type_flag);
+RcppExport SEXP gpuR_cpp_vclMatrix_append_rows(SEXP ptrASEXP, SEXP BSEXP, SEXP deviceSEXP, SEXP type_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
+    Rcpp::traits::input_parameter< SEXP >::type B(BSEXP);
+    Rcpp::traits::input_parameter< bool >::type device(deviceSEXP);
+    Rcpp::traits::input_parameter< int >::type type_flag(type_flagSEXP);
+    cpp_vclMatrix_append_rows(ptrA, B, device, type_flag);
+    return R_NilValue;
+END_RCPP
+}
 // cpp_sexp_mat_to_vclMatrix
 SEXP cpp_sexp_mat_to_vclMatrix(SEXP ptrA, const int type_flag, int device_flag);
 RcppExport SEXP gpuR_cpp_sexp_mat_to_vclMatrix(SEXP ptrASEXP, SEXP type_flagSEXP, SEXP device_flagSEXP) {
@@ -1006,6 +1112,86 @@ BEGIN_RCPP
     return R_NilValue;
 END_RCPP
 }
+// cpp_vclMatrix_gather
+SEXP cpp_vclMatrix_gather(SEXP ptrA, SEXP rows, SEXP cols, const int type_flag);
+RcppExport SEXP gpuR_cpp_vclMatrix_gather(SEXP ptrASEXP, SEXP rowsSEXP, SEXP colsSEXP, SEXP type_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject __result;
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
+    Rcpp::traits::input_parameter< SEXP >::type rows(rowsSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type cols(colsSEXP);
+    Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
+    __result = Rcpp::wrap(cpp_vclMatrix_gather(ptrA, rows, cols, type_flag));
+    return __result;
+END_RCPP
+}
+// cpp_vclMatrix_scatter
+void cpp_vclMatrix_scatter(SEXP ptrA, SEXP rows, SEXP cols, SEXP newdata, const int type_flag);
+RcppExport SEXP gpuR_cpp_vclMatrix_scatter(SEXP ptrASEXP, SEXP rowsSEXP, SEXP colsSEXP, SEXP newdataSEXP, SEXP type_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
+    Rcpp::traits::input_parameter< SEXP >::type rows(rowsSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type cols(colsSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type newdata(newdataSEXP);
+    Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
+    cpp_vclMatrix_scatter(ptrA, rows, cols, newdata, type_flag);
+    return R_NilValue;
+END_RCPP
+}
+// cpp_vclMatrix_gather_index
+SEXP cpp_vclMatrix_gather_index(SEXP ptrA, SEXP idx, const int type_flag);
+RcppExport SEXP gpuR_cpp_vclMatrix_gather_index(SEXP ptrASEXP, SEXP idxSEXP, SEXP type_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject __result;
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
+    Rcpp::traits::input_parameter< SEXP >::type idx(idxSEXP);
+    Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
+    __result = Rcpp::wrap(cpp_vclMatrix_gather_index(ptrA, idx, type_flag));
+    return __result;
+END_RCPP
+}
+// cpp_vclMatrix_scatter_index
+void cpp_vclMatrix_scatter_index(SEXP ptrA, SEXP idx, SEXP newdata, const int type_flag);
+RcppExport SEXP gpuR_cpp_vclMatrix_scatter_index(SEXP ptrASEXP, SEXP idxSEXP, SEXP newdataSEXP, SEXP type_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
+    Rcpp::traits::input_parameter< SEXP >::type idx(idxSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type newdata(newdataSEXP);
+    Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
+    cpp_vclMatrix_scatter_index(ptrA, idx, newdata, type_flag);
+    return R_NilValue;
+END_RCPP
+}
+// cpp_vclVector_gather
+SEXP cpp_vclVector_gather(SEXP ptrA, SEXP idx, const int type_flag);
+RcppExport SEXP gpuR_cpp_vclVector_gather(SEXP ptrASEXP, SEXP idxSEXP, SEXP type_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject __result;
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
+    Rcpp::traits::input_parameter< SEXP >::type idx(idxSEXP);
+    Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
+    __result = Rcpp::wrap(cpp_vclVector_gather(ptrA, idx, type_flag));
+    return __result;
+END_RCPP
+}
+// cpp_vclVector_scatter
+void cpp_vclVector_scatter(SEXP ptrA, SEXP idx, SEXP newdata, const int type_flag);
+RcppExport SEXP gpuR_cpp_vclVector_scatter(SEXP ptrASEXP, SEXP idxSEXP, SEXP newdataSEXP, SEXP type_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
+    Rcpp::traits::input_parameter< SEXP >::type idx(idxSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type newdata(newdataSEXP);
+    Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
+    cpp_vclVector_scatter(ptrA, idx, newdata, type_flag);
+    return R_NilValue;
+END_RCPP
+}
 // vectorToVCL
 SEXP vectorToVCL(SEXP ptrA, const int type_flag, int device_flag);
 RcppExport SEXP gpuR_vectorToVCL(SEXP ptrASEXP, SEXP type_flagSEXP, SEXP device_flagSEXP) {
@@ -1059,6 +1245,19 @@ BEGIN_RCPP
     return __result;
 END_RCPP
 }
+// cpp_gpuMatrix_summary
+SEXP cpp_gpuMatrix_summary(SEXP ptrA, int device_flag, const int type_flag);
+RcppExport SEXP gpuR_cpp_gpuMatrix_summary(SEXP ptrASEXP, SEXP device_flagSEXP, SEXP type_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject __result;
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
+    Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
+    Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
+    __result = Rcpp::wrap(cpp_gpuMatrix_summary(ptrA, device_flag, type_flag));
+    return __result;
+END_RCPP
+}
 // cpp_gpuMatrix_elem_prod
 void cpp_gpuMatrix_elem_prod(SEXP ptrA, SEXP ptrB, SEXP ptrC, int device_flag, const int type_flag);
 RcppExport SEXP gpuR_cpp_gpuMatrix_elem_prod(SEXP ptrASEXP, SEXP ptrBSEXP, SEXP ptrCSEXP, SEXP device_flagSEXP, SEXP type_flagSEXP) {
@@ -1641,29 +1840,42 @@ BEGIN_RCPP
     return R_NilValue;
 END_RCPP
 }
-// cpp_vclMatrix_max
-SEXP cpp_vclMatrix_max(SEXP ptrA, int device_flag, const int type_flag);
-RcppExport SEXP gpuR_cpp_vclMatrix_max(SEXP ptrASEXP, SEXP device_flagSEXP, SEXP type_flagSEXP) {
+// cpp_vclMatrix_summary
+SEXP cpp_vclMatrix_summary(SEXP ptrA, int device_flag, const int type_flag);
+RcppExport SEXP gpuR_cpp_vclMatrix_summary(SEXP ptrASEXP, SEXP device_flagSEXP, SEXP type_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject __result;
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
+    Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
+    Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
+    __result = Rcpp::wrap(cpp_vclMatrix_summary(ptrA, device_flag, type_flag));
+    return __result;
+END_RCPP
+}
+// cpp_vclMatrix_which_max
+SEXP cpp_vclMatrix_which_max(SEXP ptrA, int device_flag, const int type_flag);
+RcppExport SEXP gpuR_cpp_vclMatrix_which_max(SEXP ptrASEXP, SEXP device_flagSEXP, SEXP type_flagSEXP) {
 BEGIN_RCPP
     Rcpp::RObject __result;
     Rcpp::RNGScope __rngScope;
     Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
     Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
     Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
-    __result = Rcpp::wrap(cpp_vclMatrix_max(ptrA, device_flag, type_flag));
+    __result = Rcpp::wrap(cpp_vclMatrix_which_max(ptrA, device_flag, type_flag));
     return __result;
 END_RCPP
 }
-// cpp_vclMatrix_min
-SEXP cpp_vclMatrix_min(SEXP ptrA, int device_flag, const int type_flag);
-RcppExport SEXP gpuR_cpp_vclMatrix_min(SEXP ptrASEXP, SEXP device_flagSEXP, SEXP type_flagSEXP) {
+// cpp_vclMatrix_which_min
+SEXP cpp_vclMatrix_which_min(SEXP ptrA, int device_flag, const int type_flag);
+RcppExport SEXP gpuR_cpp_vclMatrix_which_min(SEXP ptrASEXP, SEXP device_flagSEXP, SEXP type_flagSEXP) {
 BEGIN_RCPP
     Rcpp::RObject __result;
     Rcpp::RNGScope __rngScope;
     Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
     Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
     Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
-    __result = Rcpp::wrap(cpp_vclMatrix_min(ptrA, device_flag, type_flag));
+    __result = Rcpp::wrap(cpp_vclMatrix_which_min(ptrA, device_flag, type_flag));
     return __result;
 END_RCPP
 }
@@ -2466,155 +2678,1160 @@ BEGIN_RCPP
 END_RCPP
 }
 // cpp_gpu_eigen
-void cpp_gpu_eigen(SEXP Am, SEXP Qm, SEXP eigenvalues, const bool symmetric, const int type_flag, int device_flag);
-RcppExport SEXP gpuR_cpp_gpu_eigen(SEXP AmSEXP, SEXP QmSEXP, SEXP eigenvaluesSEXP, SEXP symmetricSEXP, SEXP type_flagSEXP, SEXP device_flagSEXP) {
+void cpp_gpu_eigen(SEXP Am, SEXP Qm, SEXP eigenvalues, const bool symmetric, const bool only_values, const int type_flag, int device_flag);
+RcppExport SEXP gpuR_cpp_gpu_eigen(SEXP AmSEXP, SEXP QmSEXP, SEXP eigenvaluesSEXP, SEXP symmetricSEXP, SEXP only_valuesSEXP, SEXP type_flagSEXP, SEXP device_flagSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope __rngScope;
     Rcpp::traits::input_parameter< SEXP >::type Am(AmSEXP);
     Rcpp::traits::input_parameter< SEXP >::type Qm(QmSEXP);
     Rcpp::traits::input_parameter< SEXP >::type eigenvalues(eigenvaluesSEXP);
     Rcpp::traits::input_parameter< const bool >::type symmetric(symmetricSEXP);
+    Rcpp::traits::input_parameter< const bool >::type only_values(only_valuesSEXP);
     Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
     Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
-    cpp_gpu_eigen(Am, Qm, eigenvalues, symmetric, type_flag, device_flag);
+    cpp_gpu_eigen(Am, Qm, eigenvalues, symmetric, only_values, type_flag, device_flag);
     return R_NilValue;
 END_RCPP
 }
 // cpp_vcl_eigen
-void cpp_vcl_eigen(SEXP Am, SEXP Qm, SEXP eigenvalues, const bool symmetric, const int type_flag, int device_flag);
-RcppExport SEXP gpuR_cpp_vcl_eigen(SEXP AmSEXP, SEXP QmSEXP, SEXP eigenvaluesSEXP, SEXP symmetricSEXP, SEXP type_flagSEXP, SEXP device_flagSEXP) {
+void cpp_vcl_eigen(SEXP Am, SEXP Qm, SEXP eigenvalues, const bool symmetric, const bool only_values, const int type_flag, int device_flag);
+RcppExport SEXP gpuR_cpp_vcl_eigen(SEXP AmSEXP, SEXP QmSEXP, SEXP eigenvaluesSEXP, SEXP symmetricSEXP, SEXP only_valuesSEXP, SEXP type_flagSEXP, SEXP device_flagSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope __rngScope;
     Rcpp::traits::input_parameter< SEXP >::type Am(AmSEXP);
     Rcpp::traits::input_parameter< SEXP >::type Qm(QmSEXP);
     Rcpp::traits::input_parameter< SEXP >::type eigenvalues(eigenvaluesSEXP);
     Rcpp::traits::input_parameter< const bool >::type symmetric(symmetricSEXP);
+    Rcpp::traits::input_parameter< const bool >::type only_values(only_valuesSEXP);
     Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
     Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
-    cpp_vcl_eigen(Am, Qm, eigenvalues, symmetric, type_flag, device_flag);
+    cpp_vcl_eigen(Am, Qm, eigenvalues, symmetric, only_values, type_flag, device_flag);
     return R_NilValue;
 END_RCPP
 }
-// cpp_gpuMatrix_pmcc
-void cpp_gpuMatrix_pmcc(SEXP ptrA, SEXP ptrB, int device_flag, const int type_flag);
-RcppExport SEXP gpuR_cpp_gpuMatrix_pmcc(SEXP ptrASEXP, SEXP ptrBSEXP, SEXP device_flagSEXP, SEXP type_flagSEXP) {
+// cpp_gpuMatrix_chol
+int cpp_gpuMatrix_chol(SEXP ptrA, SEXP ptrR, int device_flag, const int type_flag);
+RcppExport SEXP gpuR_cpp_gpuMatrix_chol(SEXP ptrASEXP, SEXP ptrRSEXP, SEXP device_flagSEXP, SEXP type_flagSEXP) {
 BEGIN_RCPP
+    Rcpp::RObject __result;
     Rcpp::RNGScope __rngScope;
     Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
-    Rcpp::traits::input_parameter< SEXP >::type ptrB(ptrBSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrR(ptrRSEXP);
     Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
     Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
-    cpp_gpuMatrix_pmcc(ptrA, ptrB, device_flag, type_flag);
-    return R_NilValue;
+    __result = Rcpp::wrap(cpp_gpuMatrix_chol(ptrA, ptrR, device_flag, type_flag));
+    return __result;
 END_RCPP
 }
-// cpp_vclMatrix_pmcc
-void cpp_vclMatrix_pmcc(SEXP ptrA, SEXP ptrB, int device_flag, const int type_flag);
-RcppExport SEXP gpuR_cpp_vclMatrix_pmcc(SEXP ptrASEXP, SEXP ptrBSEXP, SEXP device_flagSEXP, SEXP type_flagSEXP) {
+// cpp_gpuMatrix_solve
+bool cpp_gpuMatrix_solve(SEXP ptrA, SEXP ptrB, SEXP ptrX, bool identity, bool vec, int device_flag, const int type_flag);
+RcppExport SEXP gpuR_cpp_gpuMatrix_solve(SEXP ptrASEXP, SEXP ptrBSEXP, SEXP ptrXSEXP, SEXP identitySEXP, SEXP vecSEXP, SEXP device_flagSEXP, SEXP type_flagSEXP) {
 BEGIN_RCPP
+    Rcpp::RObject __result;
     Rcpp::RNGScope __rngScope;
     Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
     Rcpp::traits::input_parameter< SEXP >::type ptrB(ptrBSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrX(ptrXSEXP);
+    Rcpp::traits::input_parameter< bool >::type identity(identitySEXP);
+    Rcpp::traits::input_parameter< bool >::type vec(vecSEXP);
     Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
     Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
-    cpp_vclMatrix_pmcc(ptrA, ptrB, device_flag, type_flag);
-    return R_NilValue;
+    __result = Rcpp::wrap(cpp_gpuMatrix_solve(ptrA, ptrB, ptrX, identity, vec, device_flag, type_flag));
+    return __result;
 END_RCPP
 }
-// cpp_vclMatrix_eucl
-void cpp_vclMatrix_eucl(SEXP ptrA, SEXP ptrD, bool squareDist, int device_flag, const int type_flag);
-RcppExport SEXP gpuR_cpp_vclMatrix_eucl(SEXP ptrASEXP, SEXP ptrDSEXP, SEXP squareDistSEXP, SEXP device_flagSEXP, SEXP type_flagSEXP) {
+// cpp_gpuMatrix_det
+List cpp_gpuMatrix_det(SEXP ptrA, int device_flag, const int type_flag);
+RcppExport SEXP gpuR_cpp_gpuMatrix_det(SEXP ptrASEXP, SEXP device_flagSEXP, SEXP type_flagSEXP) {
 BEGIN_RCPP
+    Rcpp::RObject __result;
     Rcpp::RNGScope __rngScope;
     Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
-    Rcpp::traits::input_parameter< SEXP >::type ptrD(ptrDSEXP);
-    Rcpp::traits::input_parameter< bool >::type squareDist(squareDistSEXP);
     Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
     Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
-    cpp_vclMatrix_eucl(ptrA, ptrD, squareDist, device_flag, type_flag);
-    return R_NilValue;
+    __result = Rcpp::wrap(cpp_gpuMatrix_det(ptrA, device_flag, type_flag));
+    return __result;
 END_RCPP
 }
-// cpp_vclMatrix_peucl
-void cpp_vclMatrix_peucl(SEXP ptrA, SEXP ptrB, SEXP ptrD, bool squareDist, int device_flag, const int type_flag);
-RcppExport SEXP gpuR_cpp_vclMatrix_peucl(SEXP ptrASEXP, SEXP ptrBSEXP, SEXP ptrDSEXP, SEXP squareDistSEXP, SEXP device_flagSEXP, SEXP type_flagSEXP) {
+// cpp_gpuMatrix_qr
+NumericVector cpp_gpuMatrix_qr(SEXP ptrA, SEXP ptrQR, int device_flag, const int type_flag);
+RcppExport SEXP gpuR_cpp_gpuMatrix_qr(SEXP ptrASEXP, SEXP ptrQRSEXP, SEXP device_flagSEXP, SEXP type_flagSEXP) {
 BEGIN_RCPP
+    Rcpp::RObject __result;
     Rcpp::RNGScope __rngScope;
     Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
-    Rcpp::traits::input_parameter< SEXP >::type ptrB(ptrBSEXP);
-    Rcpp::traits::input_parameter< SEXP >::type ptrD(ptrDSEXP);
-    Rcpp::traits::input_parameter< bool >::type squareDist(squareDistSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrQR(ptrQRSEXP);
     Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
     Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
-    cpp_vclMatrix_peucl(ptrA, ptrB, ptrD, squareDist, device_flag, type_flag);
-    return R_NilValue;
+    __result = Rcpp::wrap(cpp_gpuMatrix_qr(ptrA, ptrQR, device_flag, type_flag));
+    return __result;
 END_RCPP
 }
-// cpp_gpuMatrix_eucl
-void cpp_gpuMatrix_eucl(SEXP ptrA, SEXP ptrD, bool squareDist, int device_flag, const int type_flag);
-RcppExport SEXP gpuR_cpp_gpuMatrix_eucl(SEXP ptrASEXP, SEXP ptrDSEXP, SEXP squareDistSEXP, SEXP device_flagSEXP, SEXP type_flagSEXP) {
+// cpp_gpuMatrix_lu
+List cpp_gpuMatrix_lu(SEXP ptrA, SEXP ptrLU, int device_flag, const int type_flag);
+RcppExport SEXP gpuR_cpp_gpuMatrix_lu(SEXP ptrASEXP, SEXP ptrLUSEXP, SEXP device_flagSEXP, SEXP type_flagSEXP) {
 BEGIN_RCPP
+    Rcpp::RObject __result;
     Rcpp::RNGScope __rngScope;
     Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
-    Rcpp::traits::input_parameter< SEXP >::type ptrD(ptrDSEXP);
-    Rcpp::traits::input_parameter< bool >::type squareDist(squareDistSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrLU(ptrLUSEXP);
     Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
     Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
-    cpp_gpuMatrix_eucl(ptrA, ptrD, squareDist, device_flag, type_flag);
-    return R_NilValue;
+    __result = Rcpp::wrap(cpp_gpuMatrix_lu(ptrA, ptrLU, device_flag, type_flag));
+    return __result;
 END_RCPP
 }
-// cpp_gpuMatrix_peucl
-void cpp_gpuMatrix_peucl(SEXP ptrA, SEXP ptrB, SEXP ptrD, bool squareDist, int device_flag, const int type_flag);
-RcppExport SEXP gpuR_cpp_gpuMatrix_peucl(SEXP ptrASEXP, SEXP ptrBSEXP, SEXP ptrDSEXP, SEXP squareDistSEXP, SEXP device_flagSEXP, SEXP type_flagSEXP) {
+// cpp_vclMatrix_chol
+int cpp_vclMatrix_chol(SEXP ptrA, SEXP ptrR, int device_flag, const int type_flag);
+RcppExport SEXP gpuR_cpp_vclMatrix_chol(SEXP ptrASEXP, SEXP ptrRSEXP, SEXP device_flagSEXP, SEXP type_flagSEXP) {
 BEGIN_RCPP
+    Rcpp::RObject __result;
     Rcpp::RNGScope __rngScope;
     Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
-    Rcpp::traits::input_parameter< SEXP >::type ptrB(ptrBSEXP);
-    Rcpp::traits::input_parameter< SEXP >::type ptrD(ptrDSEXP);
-    Rcpp::traits::input_parameter< bool >::type squareDist(squareDistSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrR(ptrRSEXP);
     Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
     Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
-    cpp_gpuMatrix_peucl(ptrA, ptrB, ptrD, squareDist, device_flag, type_flag);
-    return R_NilValue;
+    __result = Rcpp::wrap(cpp_vclMatrix_chol(ptrA, ptrR, device_flag, type_flag));
+    return __result;
 END_RCPP
 }
-// cpp_gpuMatrix_colmean
-void cpp_gpuMatrix_colmean(SEXP ptrA, SEXP ptrB, int device_flag, const int type_flag);
-RcppExport SEXP gpuR_cpp_gpuMatrix_colmean(SEXP ptrASEXP, SEXP ptrBSEXP, SEXP device_flagSEXP, SEXP type_flagSEXP) {
+// cpp_vclMatrix_lu
+List cpp_vclMatrix_lu(SEXP ptrA, SEXP ptrLU, int device_flag, const int type_flag);
+RcppExport SEXP gpuR_cpp_vclMatrix_lu(SEXP ptrASEXP, SEXP ptrLUSEXP, SEXP device_flagSEXP, SEXP type_flagSEXP) {
 BEGIN_RCPP
+    Rcpp::RObject __result;
     Rcpp::RNGScope __rngScope;
     Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
-    Rcpp::traits::input_parameter< SEXP >::type ptrB(ptrBSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrLU(ptrLUSEXP);
     Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
     Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
-    cpp_gpuMatrix_colmean(ptrA, ptrB, device_flag, type_flag);
-    return R_NilValue;
+    __result = Rcpp::wrap(cpp_vclMatrix_lu(ptrA, ptrLU, device_flag, type_flag));
+    return __result;
 END_RCPP
 }
-// cpp_gpuMatrix_colsum
-void cpp_gpuMatrix_colsum(SEXP ptrA, SEXP ptrB, int device_flag, const int type_flag);
-RcppExport SEXP gpuR_cpp_gpuMatrix_colsum(SEXP ptrASEXP, SEXP ptrBSEXP, SEXP device_flagSEXP, SEXP type_flagSEXP) {
+// cpp_vclLU_solve
+void cpp_vclLU_solve(SEXP ptrLU, IntegerVector pivot, SEXP ptrX, bool identity, bool vec, int device_flag, const int type_flag);
+RcppExport SEXP gpuR_cpp_vclLU_solve(SEXP ptrLUSEXP, SEXP pivotSEXP, SEXP ptrXSEXP, SEXP identitySEXP, SEXP vecSEXP, SEXP device_flagSEXP, SEXP type_flagSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope __rngScope;
-    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
-    Rcpp::traits::input_parameter< SEXP >::type ptrB(ptrBSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrLU(ptrLUSEXP);
+    Rcpp::traits::input_parameter< IntegerVector >::type pivot(pivotSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrX(ptrXSEXP);
+    Rcpp::traits::input_parameter< bool >::type identity(identitySEXP);
+    Rcpp::traits::input_parameter< bool >::type vec(vecSEXP);
     Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
     Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
-    cpp_gpuMatrix_colsum(ptrA, ptrB, device_flag, type_flag);
+    cpp_vclLU_solve(ptrLU, pivot, ptrX, identity, vec, device_flag, type_flag);
     return R_NilValue;
 END_RCPP
 }
-// cpp_gpuMatrix_rowmean
-void cpp_gpuMatrix_rowmean(SEXP ptrA, SEXP ptrB, int device_flag, const int type_flag);
-RcppExport SEXP gpuR_cpp_gpuMatrix_rowmean(SEXP ptrASEXP, SEXP ptrBSEXP, SEXP device_flagSEXP, SEXP type_flagSEXP) {
+// cpp_vclLU_det
+List cpp_vclLU_det(SEXP ptrLU, IntegerVector pivot, int device_flag, const int type_flag);
+RcppExport SEXP gpuR_cpp_vclLU_det(SEXP ptrLUSEXP, SEXP pivotSEXP, SEXP device_flagSEXP, SEXP type_flagSEXP) {
 BEGIN_RCPP
+    Rcpp::RObject __result;
     Rcpp::RNGScope __rngScope;
-    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
-    Rcpp::traits::input_parameter< SEXP >::type ptrB(ptrBSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrLU(ptrLUSEXP);
+    Rcpp::traits::input_parameter< IntegerVector >::type pivot(pivotSEXP);
     Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
     Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
-    cpp_gpuMatrix_rowmean(ptrA, ptrB, device_flag, type_flag);
+    __result = Rcpp::wrap(cpp_vclLU_det(ptrLU, pivot, device_flag, type_flag));
+    return __result;
+END_RCPP
+}
+// cpp_vclMatrix_qr
+NumericVector cpp_vclMatrix_qr(SEXP ptrA, SEXP ptrQR, int device_flag, const int type_flag);
+RcppExport SEXP gpuR_cpp_vclMatrix_qr(SEXP ptrASEXP, SEXP ptrQRSEXP, SEXP device_flagSEXP, SEXP type_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject __result;
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrQR(ptrQRSEXP);
+    Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
+    Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
+    __result = Rcpp::wrap(cpp_vclMatrix_qr(ptrA, ptrQR, device_flag, type_flag));
+    return __result;
+END_RCPP
+}
+// cpp_vclQR_QR
+void cpp_vclQR_QR(SEXP ptrQR, NumericVector beta, SEXP ptrOut, bool Q, int device_flag, const int type_flag);
+RcppExport SEXP gpuR_cpp_vclQR_QR(SEXP ptrQRSEXP, SEXP betaSEXP, SEXP ptrOutSEXP, SEXP QSEXP, SEXP device_flagSEXP, SEXP type_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrQR(ptrQRSEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type beta(betaSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrOut(ptrOutSEXP);
+    Rcpp::traits::input_parameter< bool >::type Q(QSEXP);
+    Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
+    Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
+    cpp_vclQR_QR(ptrQR, beta, ptrOut, Q, device_flag, type_flag);
+    return R_NilValue;
+END_RCPP
+}
+// cpp_vclQR_coef
+void cpp_vclQR_coef(SEXP ptrQR, NumericVector beta, SEXP ptrB, SEXP ptrX, bool vec, int device_flag, const int type_flag);
+RcppExport SEXP gpuR_cpp_vclQR_coef(SEXP ptrQRSEXP, SEXP betaSEXP, SEXP ptrBSEXP, SEXP ptrXSEXP, SEXP vecSEXP, SEXP device_flagSEXP, SEXP type_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrQR(ptrQRSEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type beta(betaSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrB(ptrBSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrX(ptrXSEXP);
+    Rcpp::traits::input_parameter< bool >::type vec(vecSEXP);
+    Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
+    Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
+    cpp_vclQR_coef(ptrQR, beta, ptrB, ptrX, vec, device_flag, type_flag);
+    return R_NilValue;
+END_RCPP
+}
+// cpp_matrix_file_create
+void cpp_matrix_file_create(std::string file, double nrow, double ncol, const int type_flag);
+RcppExport SEXP gpuR_cpp_matrix_file_create(SEXP fileSEXP, SEXP nrowSEXP, SEXP ncolSEXP, SEXP type_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< std::string >::type file(fileSEXP);
+    Rcpp::traits::input_parameter< double >::type nrow(nrowSEXP);
+    Rcpp::traits::input_parameter< double >::type ncol(ncolSEXP);
+    Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
+    cpp_matrix_file_create(file, nrow, ncol, type_flag);
+    return R_NilValue;
+END_RCPP
+}
+// cpp_gpuFileMatrix_dim
+NumericVector cpp_gpuFileMatrix_dim(SEXP ptrA, const int type_flag);
+RcppExport SEXP gpuR_cpp_gpuFileMatrix_dim(SEXP ptrASEXP, SEXP type_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject __result;
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
+    Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
+    __result = Rcpp::wrap(cpp_gpuFileMatrix_dim(ptrA, type_flag));
+    return __result;
+END_RCPP
+}
+// cpp_gpuFileMatrix_open
+SEXP cpp_gpuFileMatrix_open(std::string file, bool writable, const int type_flag);
+RcppExport SEXP gpuR_cpp_gpuFileMatrix_open(SEXP fileSEXP, SEXP writableSEXP, SEXP type_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject __result;
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< std::string >::type file(fileSEXP);
+    Rcpp::traits::input_parameter< bool >::type writable(writableSEXP);
+    Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
+    __result = Rcpp::wrap(cpp_gpuFileMatrix_open(file, writable, type_flag));
+    return __result;
+END_RCPP
+}
+// cpp_gpuFileMatrix_get
+SEXP cpp_gpuFileMatrix_get(SEXP ptrA, NumericVector rows, NumericVector cols, bool all_rows, bool all_cols, const int type_flag);
+RcppExport SEXP gpuR_cpp_gpuFileMatrix_get(SEXP ptrASEXP, SEXP rowsSEXP, SEXP colsSEXP, SEXP all_rowsSEXP, SEXP all_colsSEXP, SEXP type_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject __result;
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type rows(rowsSEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type cols(colsSEXP);
+    Rcpp::traits::input_parameter< bool >::type all_rows(all_rowsSEXP);
+    Rcpp::traits::input_parameter< bool >::type all_cols(all_colsSEXP);
+    Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
+    __result = Rcpp::wrap(cpp_gpuFileMatrix_get(ptrA, rows, cols, all_rows, all_cols, type_flag));
+    return __result;
+END_RCPP
+}
+// cpp_gpuFileMatrix_set
+void cpp_gpuFileMatrix_set(SEXP ptrA, NumericVector rows, NumericVector cols, bool all_rows, bool all_cols, NumericVector values, const int type_flag);
+RcppExport SEXP gpuR_cpp_gpuFileMatrix_set(SEXP ptrASEXP, SEXP rowsSEXP, SEXP colsSEXP, SEXP all_rowsSEXP, SEXP all_colsSEXP, SEXP valuesSEXP, SEXP type_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type rows(rowsSEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type cols(colsSEXP);
+    Rcpp::traits::input_parameter< bool >::type all_rows(all_rowsSEXP);
+    Rcpp::traits::input_parameter< bool >::type all_cols(all_colsSEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type values(valuesSEXP);
+    Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
+    cpp_gpuFileMatrix_set(ptrA, rows, cols, all_rows, all_cols, values, type_flag);
+    return R_NilValue;
+END_RCPP
+}
+// cpp_gpuFileMatrix_sums
+void cpp_gpuFileMatrix_sums(SEXP ptrA, SEXP ptrS, bool rows, int device_flag, const int type_flag);
+RcppExport SEXP gpuR_cpp_gpuFileMatrix_sums(SEXP ptrASEXP, SEXP ptrSSEXP, SEXP rowsSEXP, SEXP device_flagSEXP, SEXP type_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrS(ptrSSEXP);
+    Rcpp::traits::input_parameter< bool >::type rows(rowsSEXP);
+    Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
+    Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
+    cpp_gpuFileMatrix_sums(ptrA, ptrS, rows, device_flag, type_flag);
+    return R_NilValue;
+END_RCPP
+}
+// cpp_gpuFileMatrix_crossprod
+void cpp_gpuFileMatrix_crossprod(SEXP ptrA, SEXP ptrB, SEXP ptrC, bool same, int device_flag, const int type_flag);
+RcppExport SEXP gpuR_cpp_gpuFileMatrix_crossprod(SEXP ptrASEXP, SEXP ptrBSEXP, SEXP ptrCSEXP, SEXP sameSEXP, SEXP device_flagSEXP, SEXP type_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrB(ptrBSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrC(ptrCSEXP);
+    Rcpp::traits::input_parameter< bool >::type same(sameSEXP);
+    Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
+    Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
+    cpp_gpuFileMatrix_crossprod(ptrA, ptrB, ptrC, same, device_flag, type_flag);
+    return R_NilValue;
+END_RCPP
+}
+// cpp_gpuFileMatrix_peuclidean
+void cpp_gpuFileMatrix_peuclidean(SEXP ptrA, SEXP ptrB, SEXP ptrD, bool squareDist, int device_flag, const int type_flag);
+RcppExport SEXP gpuR_cpp_gpuFileMatrix_peuclidean(SEXP ptrASEXP, SEXP ptrBSEXP, SEXP ptrDSEXP, SEXP squareDistSEXP, SEXP device_flagSEXP, SEXP type_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrB(ptrBSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrD(ptrDSEXP);
+    Rcpp::traits::input_parameter< bool >::type squareDist(squareDistSEXP);
+    Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
+    Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
+    cpp_gpuFileMatrix_peuclidean(ptrA, ptrB, ptrD, squareDist, device_flag, type_flag);
+    return R_NilValue;
+END_RCPP
+}
+// cpp_hvcl_empty
+SEXP cpp_hvcl_empty(int nr, int nc, int device_flag);
+RcppExport SEXP gpuR_cpp_hvcl_empty(SEXP nrSEXP, SEXP ncSEXP, SEXP device_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject __result;
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< int >::type nr(nrSEXP);
+    Rcpp::traits::input_parameter< int >::type nc(ncSEXP);
+    Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
+    __result = Rcpp::wrap(cpp_hvcl_empty(nr, nc, device_flag));
+    return __result;
+END_RCPP
+}
+// cpp_hvcl_from_host
+SEXP cpp_hvcl_from_host(SEXP data, int nr, int nc, int device_flag);
+RcppExport SEXP gpuR_cpp_hvcl_from_host(SEXP dataSEXP, SEXP nrSEXP, SEXP ncSEXP, SEXP device_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject __result;
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type data(dataSEXP);
+    Rcpp::traits::input_parameter< int >::type nr(nrSEXP);
+    Rcpp::traits::input_parameter< int >::type nc(ncSEXP);
+    Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
+    __result = Rcpp::wrap(cpp_hvcl_from_host(data, nr, nc, device_flag));
+    return __result;
+END_RCPP
+}
+// cpp_hvcl_to_host
+NumericVector cpp_hvcl_to_host(SEXP ptrH, int device_flag);
+RcppExport SEXP gpuR_cpp_hvcl_to_host(SEXP ptrHSEXP, SEXP device_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject __result;
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrH(ptrHSEXP);
+    Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
+    __result = Rcpp::wrap(cpp_hvcl_to_host(ptrH, device_flag));
+    return __result;
+END_RCPP
+}
+// cpp_hvcl_dim
+IntegerVector cpp_hvcl_dim(SEXP ptrH);
+RcppExport SEXP gpuR_cpp_hvcl_dim(SEXP ptrHSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject __result;
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrH(ptrHSEXP);
+    __result = Rcpp::wrap(cpp_hvcl_dim(ptrH));
+    return __result;
+END_RCPP
+}
+// cpp_hvclMatrix_from_fvcl
+SEXP cpp_hvclMatrix_from_fvcl(SEXP ptrF, int device_flag);
+RcppExport SEXP gpuR_cpp_hvclMatrix_from_fvcl(SEXP ptrFSEXP, SEXP device_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject __result;
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrF(ptrFSEXP);
+    Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
+    __result = Rcpp::wrap(cpp_hvclMatrix_from_fvcl(ptrF, device_flag));
+    return __result;
+END_RCPP
+}
+// cpp_hvclVector_from_fvcl
+SEXP cpp_hvclVector_from_fvcl(SEXP ptrF, int device_flag);
+RcppExport SEXP gpuR_cpp_hvclVector_from_fvcl(SEXP ptrFSEXP, SEXP device_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject __result;
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrF(ptrFSEXP);
+    Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
+    __result = Rcpp::wrap(cpp_hvclVector_from_fvcl(ptrF, device_flag));
+    return __result;
+END_RCPP
+}
+// cpp_hvclMatrix_to_fvcl
+void cpp_hvclMatrix_to_fvcl(SEXP ptrH, SEXP ptrF, int device_flag);
+RcppExport SEXP gpuR_cpp_hvclMatrix_to_fvcl(SEXP ptrHSEXP, SEXP ptrFSEXP, SEXP device_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrH(ptrHSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrF(ptrFSEXP);
+    Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
+    cpp_hvclMatrix_to_fvcl(ptrH, ptrF, device_flag);
+    return R_NilValue;
+END_RCPP
+}
+// cpp_hvclVector_to_fvcl
+void cpp_hvclVector_to_fvcl(SEXP ptrH, SEXP ptrF, int device_flag);
+RcppExport SEXP gpuR_cpp_hvclVector_to_fvcl(SEXP ptrHSEXP, SEXP ptrFSEXP, SEXP device_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrH(ptrHSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrF(ptrFSEXP);
+    Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
+    cpp_hvclVector_to_fvcl(ptrH, ptrF, device_flag);
+    return R_NilValue;
+END_RCPP
+}
+// cpp_hvcl_gemm
+void cpp_hvcl_gemm(SEXP ptrA, SEXP ptrB, SEXP ptrC, int device_flag);
+RcppExport SEXP gpuR_cpp_hvcl_gemm(SEXP ptrASEXP, SEXP ptrBSEXP, SEXP ptrCSEXP, SEXP device_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrB(ptrBSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrC(ptrCSEXP);
+    Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
+    cpp_hvcl_gemm(ptrA, ptrB, ptrC, device_flag);
+    return R_NilValue;
+END_RCPP
+}
+// cpp_hvcl_elementwise
+void cpp_hvcl_elementwise(SEXP ptrA, SEXP ptrB, SEXP ptrC, int op, int device_flag);
+RcppExport SEXP gpuR_cpp_hvcl_elementwise(SEXP ptrASEXP, SEXP ptrBSEXP, SEXP ptrCSEXP, SEXP opSEXP, SEXP device_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrB(ptrBSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrC(ptrCSEXP);
+    Rcpp::traits::input_parameter< int >::type op(opSEXP);
+    Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
+    cpp_hvcl_elementwise(ptrA, ptrB, ptrC, op, device_flag);
+    return R_NilValue;
+END_RCPP
+}
+// cpp_hvcl_scalar
+void cpp_hvcl_scalar(SEXP ptrA, double scalar, bool left, SEXP ptrC, int op, int device_flag);
+RcppExport SEXP gpuR_cpp_hvcl_scalar(SEXP ptrASEXP, SEXP scalarSEXP, SEXP leftSEXP, SEXP ptrCSEXP, SEXP opSEXP, SEXP device_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
+    Rcpp::traits::input_parameter< double >::type scalar(scalarSEXP);
+    Rcpp::traits::input_parameter< bool >::type left(leftSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrC(ptrCSEXP);
+    Rcpp::traits::input_parameter< int >::type op(opSEXP);
+    Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
+    cpp_hvcl_scalar(ptrA, scalar, left, ptrC, op, device_flag);
+    return R_NilValue;
+END_RCPP
+}
+// cpp_hvcl_margin_sums
+void cpp_hvcl_margin_sums(SEXP ptrA, SEXP ptrS, bool byRow, int device_flag);
+RcppExport SEXP gpuR_cpp_hvcl_margin_sums(SEXP ptrASEXP, SEXP ptrSSEXP, SEXP byRowSEXP, SEXP device_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrS(ptrSSEXP);
+    Rcpp::traits::input_parameter< bool >::type byRow(byRowSEXP);
+    Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
+    cpp_hvcl_margin_sums(ptrA, ptrS, byRow, device_flag);
+    return R_NilValue;
+END_RCPP
+}
+// cpp_hvcl_sum
+double cpp_hvcl_sum(SEXP ptrA, int device_flag);
+RcppExport SEXP gpuR_cpp_hvcl_sum(SEXP ptrASEXP, SEXP device_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject __result;
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
+    Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
+    __result = Rcpp::wrap(cpp_hvcl_sum(ptrA, device_flag));
+    return __result;
+END_RCPP
+}
+// cpp_vclMatrix_elementwise
+void cpp_vclMatrix_elementwise(SEXP ptrA, SEXP ptrB, double scalar, bool use_scalar, int op, SEXP ptrC, int device_flag, const int type_flag);
+RcppExport SEXP gpuR_cpp_vclMatrix_elementwise(SEXP ptrASEXP, SEXP ptrBSEXP, SEXP scalarSEXP, SEXP use_scalarSEXP, SEXP opSEXP, SEXP ptrCSEXP, SEXP device_flagSEXP, SEXP type_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrB(ptrBSEXP);
+    Rcpp::traits::input_parameter< double >::type scalar(scalarSEXP);
+    Rcpp::traits::input_parameter< bool >::type use_scalar(use_scalarSEXP);
+    Rcpp::traits::input_parameter< int >::type op(opSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrC(ptrCSEXP);
+    Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
+    Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
+    cpp_vclMatrix_elementwise(ptrA, ptrB, scalar, use_scalar, op, ptrC, device_flag, type_flag);
+    return R_NilValue;
+END_RCPP
+}
+// cpp_vclVector_elementwise
+void cpp_vclVector_elementwise(SEXP ptrA, SEXP ptrB, double scalar, bool use_scalar, int op, SEXP ptrC, int device_flag, const int type_flag);
+RcppExport SEXP gpuR_cpp_vclVector_elementwise(SEXP ptrASEXP, SEXP ptrBSEXP, SEXP scalarSEXP, SEXP use_scalarSEXP, SEXP opSEXP, SEXP ptrCSEXP, SEXP device_flagSEXP, SEXP type_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrB(ptrBSEXP);
+    Rcpp::traits::input_parameter< double >::type scalar(scalarSEXP);
+    Rcpp::traits::input_parameter< bool >::type use_scalar(use_scalarSEXP);
+    Rcpp::traits::input_parameter< int >::type op(opSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrC(ptrCSEXP);
+    Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
+    Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
+    cpp_vclVector_elementwise(ptrA, ptrB, scalar, use_scalar, op, ptrC, device_flag, type_flag);
+    return R_NilValue;
+END_RCPP
+}
+// cpp_gpuMatrix_int_arith
+bool cpp_gpuMatrix_int_arith(SEXP ptrA, SEXP ptrB, double scalar, bool use_scalar, bool left, int op, SEXP ptrC, int device_flag, const int type_flag);
+RcppExport SEXP gpuR_cpp_gpuMatrix_int_arith(SEXP ptrASEXP, SEXP ptrBSEXP, SEXP scalarSEXP, SEXP use_scalarSEXP, SEXP leftSEXP, SEXP opSEXP, SEXP ptrCSEXP, SEXP device_flagSEXP, SEXP type_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject __result;
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrB(ptrBSEXP);
+    Rcpp::traits::input_parameter< double >::type scalar(scalarSEXP);
+    Rcpp::traits::input_parameter< bool >::type use_scalar(use_scalarSEXP);
+    Rcpp::traits::input_parameter< bool >::type left(leftSEXP);
+    Rcpp::traits::input_parameter< int >::type op(opSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrC(ptrCSEXP);
+    Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
+    Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
+    __result = Rcpp::wrap(cpp_gpuMatrix_int_arith(ptrA, ptrB, scalar, use_scalar, left, op, ptrC, device_flag, type_flag));
+    return __result;
+END_RCPP
+}
+// cpp_gpuMatrix_int_gemm
+bool cpp_gpuMatrix_int_gemm(SEXP ptrA, SEXP ptrB, SEXP ptrC, bool transA, bool transB, int device_flag, const int type_flag);
+RcppExport SEXP gpuR_cpp_gpuMatrix_int_gemm(SEXP ptrASEXP, SEXP ptrBSEXP, SEXP ptrCSEXP, SEXP transASEXP, SEXP transBSEXP, SEXP device_flagSEXP, SEXP type_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject __result;
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrB(ptrBSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrC(ptrCSEXP);
+    Rcpp::traits::input_parameter< bool >::type transA(transASEXP);
+    Rcpp::traits::input_parameter< bool >::type transB(transBSEXP);
+    Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
+    Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
+    __result = Rcpp::wrap(cpp_gpuMatrix_int_gemm(ptrA, ptrB, ptrC, transA, transB, device_flag, type_flag));
+    return __result;
+END_RCPP
+}
+// cpp_gpuMatrix_int_sums
+bool cpp_gpuMatrix_int_sums(SEXP ptrA, SEXP ptrS, bool cols, int device_flag, const int type_flag);
+RcppExport SEXP gpuR_cpp_gpuMatrix_int_sums(SEXP ptrASEXP, SEXP ptrSSEXP, SEXP colsSEXP, SEXP device_flagSEXP, SEXP type_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject __result;
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrS(ptrSSEXP);
+    Rcpp::traits::input_parameter< bool >::type cols(colsSEXP);
+    Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
+    Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
+    __result = Rcpp::wrap(cpp_gpuMatrix_int_sums(ptrA, ptrS, cols, device_flag, type_flag));
+    return __result;
+END_RCPP
+}
+// cpp_vclMatrix_int_arith
+bool cpp_vclMatrix_int_arith(SEXP ptrA, SEXP ptrB, double scalar, bool use_scalar, bool left, int op, SEXP ptrC, int device_flag, const int type_flag);
+RcppExport SEXP gpuR_cpp_vclMatrix_int_arith(SEXP ptrASEXP, SEXP ptrBSEXP, SEXP scalarSEXP, SEXP use_scalarSEXP, SEXP leftSEXP, SEXP opSEXP, SEXP ptrCSEXP, SEXP device_flagSEXP, SEXP type_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject __result;
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrB(ptrBSEXP);
+    Rcpp::traits::input_parameter< double >::type scalar(scalarSEXP);
+    Rcpp::traits::input_parameter< bool >::type use_scalar(use_scalarSEXP);
+    Rcpp::traits::input_parameter< bool >::type left(leftSEXP);
+    Rcpp::traits::input_parameter< int >::type op(opSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrC(ptrCSEXP);
+    Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
+    Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
+    __result = Rcpp::wrap(cpp_vclMatrix_int_arith(ptrA, ptrB, scalar, use_scalar, left, op, ptrC, device_flag, type_flag));
+    return __result;
+END_RCPP
+}
+// cpp_vclMatrix_int_gemm
+bool cpp_vclMatrix_int_gemm(SEXP ptrA, SEXP ptrB, SEXP ptrC, bool transA, bool transB, int device_flag, const int type_flag);
+RcppExport SEXP gpuR_cpp_vclMatrix_int_gemm(SEXP ptrASEXP, SEXP ptrBSEXP, SEXP ptrCSEXP, SEXP transASEXP, SEXP transBSEXP, SEXP device_flagSEXP, SEXP type_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject __result;
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrB(ptrBSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrC(ptrCSEXP);
+    Rcpp::traits::input_parameter< bool >::type transA(transASEXP);
+    Rcpp::traits::input_parameter< bool >::type transB(transBSEXP);
+    Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
+    Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
+    __result = Rcpp::wrap(cpp_vclMatrix_int_gemm(ptrA, ptrB, ptrC, transA, transB, device_flag, type_flag));
+    return __result;
+END_RCPP
+}
+// cpp_vclMatrix_int_sums
+bool cpp_vclMatrix_int_sums(SEXP ptrA, SEXP ptrS, bool cols, int device_flag, const int type_flag);
+RcppExport SEXP gpuR_cpp_vclMatrix_int_sums(SEXP ptrASEXP, SEXP ptrSSEXP, SEXP colsSEXP, SEXP device_flagSEXP, SEXP type_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject __result;
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrS(ptrSSEXP);
+    Rcpp::traits::input_parameter< bool >::type cols(colsSEXP);
+    Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
+    Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
+    __result = Rcpp::wrap(cpp_vclMatrix_int_sums(ptrA, ptrS, cols, device_flag, type_flag));
+    return __result;
+END_RCPP
+}
+// cpp_matrix_file_header
+List cpp_matrix_file_header(std::string file);
+RcppExport SEXP gpuR_cpp_matrix_file_header(SEXP fileSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject __result;
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< std::string >::type file(fileSEXP);
+    __result = Rcpp::wrap(cpp_matrix_file_header(file));
+    return __result;
+END_RCPP
+}
+// cpp_gpuMatrix_save
+void cpp_gpuMatrix_save(SEXP ptrA, std::string file, const int type_flag);
+RcppExport SEXP gpuR_cpp_gpuMatrix_save(SEXP ptrASEXP, SEXP fileSEXP, SEXP type_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
+    Rcpp::traits::input_parameter< std::string >::type file(fileSEXP);
+    Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
+    cpp_gpuMatrix_save(ptrA, file, type_flag);
+    return R_NilValue;
+END_RCPP
+}
+// cpp_gpuMatrix_load
+void cpp_gpuMatrix_load(SEXP ptrA, std::string file, const int type_flag);
+RcppExport SEXP gpuR_cpp_gpuMatrix_load(SEXP ptrASEXP, SEXP fileSEXP, SEXP type_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
+    Rcpp::traits::input_parameter< std::string >::type file(fileSEXP);
+    Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
+    cpp_gpuMatrix_load(ptrA, file, type_flag);
+    return R_NilValue;
+END_RCPP
+}
+// cpp_vclMatrix_save
+void cpp_vclMatrix_save(SEXP ptrA, std::string file, const int type_flag);
+RcppExport SEXP gpuR_cpp_vclMatrix_save(SEXP ptrASEXP, SEXP fileSEXP, SEXP type_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
+    Rcpp::traits::input_parameter< std::string >::type file(fileSEXP);
+    Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
+    cpp_vclMatrix_save(ptrA, file, type_flag);
+    return R_NilValue;
+END_RCPP
+}
+// cpp_vclMatrix_load
+void cpp_vclMatrix_load(SEXP ptrA, std::string file, const int type_flag);
+RcppExport SEXP gpuR_cpp_vclMatrix_load(SEXP ptrASEXP, SEXP fileSEXP, SEXP type_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
+    Rcpp::traits::input_parameter< std::string >::type file(fileSEXP);
+    Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
+    cpp_vclMatrix_load(ptrA, file, type_flag);
+    return R_NilValue;
+END_RCPP
+}
+// cpp_vclMatrix_krylov
+List cpp_vclMatrix_krylov(SEXP ptrA, SEXP ptrB, SEXP ptrX, bool guess, int method, int precond, double tol, int maxit, int restart, int device_flag, const int type_flag);
+RcppExport SEXP gpuR_cpp_vclMatrix_krylov(SEXP ptrASEXP, SEXP ptrBSEXP, SEXP ptrXSEXP, SEXP guessSEXP, SEXP methodSEXP, SEXP precondSEXP, SEXP tolSEXP, SEXP maxitSEXP, SEXP restartSEXP, SEXP device_flagSEXP, SEXP type_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject __result;
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrB(ptrBSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrX(ptrXSEXP);
+    Rcpp::traits::input_parameter< bool >::type guess(guessSEXP);
+    Rcpp::traits::input_parameter< int >::type method(methodSEXP);
+    Rcpp::traits::input_parameter< int >::type precond(precondSEXP);
+    Rcpp::traits::input_parameter< double >::type tol(tolSEXP);
+    Rcpp::traits::input_parameter< int >::type maxit(maxitSEXP);
+    Rcpp::traits::input_parameter< int >::type restart(restartSEXP);
+    Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
+    Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
+    __result = Rcpp::wrap(cpp_vclMatrix_krylov(ptrA, ptrB, ptrX, guess, method, precond, tol, maxit, restart, device_flag, type_flag));
+    return __result;
+END_RCPP
+}
+// cpp_vclSparseMatrix_krylov
+List cpp_vclSparseMatrix_krylov(SEXP ptrA, SEXP ptrB, SEXP ptrX, bool guess, int method, int precond, double tol, int maxit, int restart, int device_flag, const int type_flag);
+RcppExport SEXP gpuR_cpp_vclSparseMatrix_krylov(SEXP ptrASEXP, SEXP ptrBSEXP, SEXP ptrXSEXP, SEXP guessSEXP, SEXP methodSEXP, SEXP precondSEXP, SEXP tolSEXP, SEXP maxitSEXP, SEXP restartSEXP, SEXP device_flagSEXP, SEXP type_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject __result;
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrB(ptrBSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrX(ptrXSEXP);
+    Rcpp::traits::input_parameter< bool >::type guess(guessSEXP);
+    Rcpp::traits::input_parameter< int >::type method(methodSEXP);
+    Rcpp::traits::input_parameter< int >::type precond(precondSEXP);
+    Rcpp::traits::input_parameter< double >::type tol(tolSEXP);
+    Rcpp::traits::input_parameter< int >::type maxit(maxitSEXP);
+    Rcpp::traits::input_parameter< int >::type restart(restartSEXP);
+    Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
+    Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
+    __result = Rcpp::wrap(cpp_vclSparseMatrix_krylov(ptrA, ptrB, ptrX, guess, method, precond, tol, maxit, restart, device_flag, type_flag));
+    return __result;
+END_RCPP
+}
+// cpp_vclMatrix_lobpcg
+List cpp_vclMatrix_lobpcg(SEXP ptrA, SEXP ptrX0, SEXP ptrValues, SEXP ptrVectors, int k, bool largest, double tol, int maxit, int device_flag, const int type_flag);
+RcppExport SEXP gpuR_cpp_vclMatrix_lobpcg(SEXP ptrASEXP, SEXP ptrX0SEXP, SEXP ptrValuesSEXP, SEXP ptrVectorsSEXP, SEXP kSEXP, SEXP largestSEXP, SEXP tolSEXP, SEXP maxitSEXP, SEXP device_flagSEXP, SEXP type_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject __result;
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrX0(ptrX0SEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrValues(ptrValuesSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrVectors(ptrVectorsSEXP);
+    Rcpp::traits::input_parameter< int >::type k(kSEXP);
+    Rcpp::traits::input_parameter< bool >::type largest(largestSEXP);
+    Rcpp::traits::input_parameter< double >::type tol(tolSEXP);
+    Rcpp::traits::input_parameter< int >::type maxit(maxitSEXP);
+    Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
+    Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
+    __result = Rcpp::wrap(cpp_vclMatrix_lobpcg(ptrA, ptrX0, ptrValues, ptrVectors, k, largest, tol, maxit, device_flag, type_flag));
+    return __result;
+END_RCPP
+}
+// cpp_vclSparseMatrix_lobpcg
+List cpp_vclSparseMatrix_lobpcg(SEXP ptrA, SEXP ptrX0, SEXP ptrValues, SEXP ptrVectors, int k, bool largest, double tol, int maxit, int device_flag, const int type_flag);
+RcppExport SEXP gpuR_cpp_vclSparseMatrix_lobpcg(SEXP ptrASEXP, SEXP ptrX0SEXP, SEXP ptrValuesSEXP, SEXP ptrVectorsSEXP, SEXP kSEXP, SEXP largestSEXP, SEXP tolSEXP, SEXP maxitSEXP, SEXP device_flagSEXP, SEXP type_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject __result;
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrX0(ptrX0SEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrValues(ptrValuesSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrVectors(ptrVectorsSEXP);
+    Rcpp::traits::input_parameter< int >::type k(kSEXP);
+    Rcpp::traits::input_parameter< bool >::type largest(largestSEXP);
+    Rcpp::traits::input_parameter< double >::type tol(tolSEXP);
+    Rcpp::traits::input_parameter< int >::type maxit(maxitSEXP);
+    Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
+    Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
+    __result = Rcpp::wrap(cpp_vclSparseMatrix_lobpcg(ptrA, ptrX0, ptrValues, ptrVectors, k, largest, tol, maxit, device_flag, type_flag));
+    return __result;
+END_RCPP
+}
+// cpp_vclMatrix_compare
+void cpp_vclMatrix_compare(SEXP ptrA, SEXP ptrB, double scalar, bool use_scalar, int op, SEXP ptrC, int device_flag, const int type_flag);
+RcppExport SEXP gpuR_cpp_vclMatrix_compare(SEXP ptrASEXP, SEXP ptrBSEXP, SEXP scalarSEXP, SEXP use_scalarSEXP, SEXP opSEXP, SEXP ptrCSEXP, SEXP device_flagSEXP, SEXP type_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrB(ptrBSEXP);
+    Rcpp::traits::input_parameter< double >::type scalar(scalarSEXP);
+    Rcpp::traits::input_parameter< bool >::type use_scalar(use_scalarSEXP);
+    Rcpp::traits::input_parameter< int >::type op(opSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrC(ptrCSEXP);
+    Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
+    Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
+    cpp_vclMatrix_compare(ptrA, ptrB, scalar, use_scalar, op, ptrC, device_flag, type_flag);
+    return R_NilValue;
+END_RCPP
+}
+// cpp_vclMatrix_logic
+void cpp_vclMatrix_logic(SEXP ptrA, SEXP ptrB, int scalar, bool use_scalar, int op, SEXP ptrC, int device_flag, const int type_flag);
+RcppExport SEXP gpuR_cpp_vclMatrix_logic(SEXP ptrASEXP, SEXP ptrBSEXP, SEXP scalarSEXP, SEXP use_scalarSEXP, SEXP opSEXP, SEXP ptrCSEXP, SEXP device_flagSEXP, SEXP type_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrB(ptrBSEXP);
+    Rcpp::traits::input_parameter< int >::type scalar(scalarSEXP);
+    Rcpp::traits::input_parameter< bool >::type use_scalar(use_scalarSEXP);
+    Rcpp::traits::input_parameter< int >::type op(opSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrC(ptrCSEXP);
+    Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
+    Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
+    cpp_vclMatrix_logic(ptrA, ptrB, scalar, use_scalar, op, ptrC, device_flag, type_flag);
+    return R_NilValue;
+END_RCPP
+}
+// cpp_vclMatrix_not
+void cpp_vclMatrix_not(SEXP ptrA, SEXP ptrC, int device_flag, const int type_flag);
+RcppExport SEXP gpuR_cpp_vclMatrix_not(SEXP ptrASEXP, SEXP ptrCSEXP, SEXP device_flagSEXP, SEXP type_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrC(ptrCSEXP);
+    Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
+    Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
+    cpp_vclMatrix_not(ptrA, ptrC, device_flag, type_flag);
+    return R_NilValue;
+END_RCPP
+}
+// cpp_vclMatrix_compact
+SEXP cpp_vclMatrix_compact(SEXP ptrA, SEXP ptrM, int device_flag, const int type_flag);
+RcppExport SEXP gpuR_cpp_vclMatrix_compact(SEXP ptrASEXP, SEXP ptrMSEXP, SEXP device_flagSEXP, SEXP type_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject __result;
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrM(ptrMSEXP);
+    Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
+    Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
+    __result = Rcpp::wrap(cpp_vclMatrix_compact(ptrA, ptrM, device_flag, type_flag));
+    return __result;
+END_RCPP
+}
+// cpp_vclMatrix_which
+SEXP cpp_vclMatrix_which(SEXP ptrM, int device_flag);
+RcppExport SEXP gpuR_cpp_vclMatrix_which(SEXP ptrMSEXP, SEXP device_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject __result;
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrM(ptrMSEXP);
+    Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
+    __result = Rcpp::wrap(cpp_vclMatrix_which(ptrM, device_flag));
+    return __result;
+END_RCPP
+}
+// cpp_vclMatrix_where
+SEXP cpp_vclMatrix_where(SEXP ptrA, double scalar, int op, bool absolute, int device_flag, const int type_flag);
+RcppExport SEXP gpuR_cpp_vclMatrix_where(SEXP ptrASEXP, SEXP scalarSEXP, SEXP opSEXP, SEXP absoluteSEXP, SEXP device_flagSEXP, SEXP type_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject __result;
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
+    Rcpp::traits::input_parameter< double >::type scalar(scalarSEXP);
+    Rcpp::traits::input_parameter< int >::type op(opSEXP);
+    Rcpp::traits::input_parameter< bool >::type absolute(absoluteSEXP);
+    Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
+    Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
+    __result = Rcpp::wrap(cpp_vclMatrix_where(ptrA, scalar, op, absolute, device_flag, type_flag));
+    return __result;
+END_RCPP
+}
+// cpp_vclMatrix_where_margin
+void cpp_vclMatrix_where_margin(SEXP ptrA, double scalar, int op, bool absolute, int what, bool na_rm, bool byRow, SEXP ptrC, int out_flag, int device_flag, const int type_flag);
+RcppExport SEXP gpuR_cpp_vclMatrix_where_margin(SEXP ptrASEXP, SEXP scalarSEXP, SEXP opSEXP, SEXP absoluteSEXP, SEXP whatSEXP, SEXP na_rmSEXP, SEXP byRowSEXP, SEXP ptrCSEXP, SEXP out_flagSEXP, SEXP device_flagSEXP, SEXP type_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
+    Rcpp::traits::input_parameter< double >::type scalar(scalarSEXP);
+    Rcpp::traits::input_parameter< int >::type op(opSEXP);
+    Rcpp::traits::input_parameter< bool >::type absolute(absoluteSEXP);
+    Rcpp::traits::input_parameter< int >::type what(whatSEXP);
+    Rcpp::traits::input_parameter< bool >::type na_rm(na_rmSEXP);
+    Rcpp::traits::input_parameter< bool >::type byRow(byRowSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrC(ptrCSEXP);
+    Rcpp::traits::input_parameter< int >::type out_flag(out_flagSEXP);
+    Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
+    Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
+    cpp_vclMatrix_where_margin(ptrA, scalar, op, absolute, what, na_rm, byRow, ptrC, out_flag, device_flag, type_flag);
+    return R_NilValue;
+END_RCPP
+}
+// cpp_vclVector_compare
+void cpp_vclVector_compare(SEXP ptrA, SEXP ptrB, double scalar, bool use_scalar, int op, SEXP ptrC, int device_flag, const int type_flag);
+RcppExport SEXP gpuR_cpp_vclVector_compare(SEXP ptrASEXP, SEXP ptrBSEXP, SEXP scalarSEXP, SEXP use_scalarSEXP, SEXP opSEXP, SEXP ptrCSEXP, SEXP device_flagSEXP, SEXP type_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrB(ptrBSEXP);
+    Rcpp::traits::input_parameter< double >::type scalar(scalarSEXP);
+    Rcpp::traits::input_parameter< bool >::type use_scalar(use_scalarSEXP);
+    Rcpp::traits::input_parameter< int >::type op(opSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrC(ptrCSEXP);
+    Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
+    Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
+    cpp_vclVector_compare(ptrA, ptrB, scalar, use_scalar, op, ptrC, device_flag, type_flag);
+    return R_NilValue;
+END_RCPP
+}
+// cpp_vclVector_logic
+void cpp_vclVector_logic(SEXP ptrA, SEXP ptrB, int scalar, bool use_scalar, int op, SEXP ptrC, int device_flag, const int type_flag);
+RcppExport SEXP gpuR_cpp_vclVector_logic(SEXP ptrASEXP, SEXP ptrBSEXP, SEXP scalarSEXP, SEXP use_scalarSEXP, SEXP opSEXP, SEXP ptrCSEXP, SEXP device_flagSEXP, SEXP type_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrB(ptrBSEXP);
+    Rcpp::traits::input_parameter< int >::type scalar(scalarSEXP);
+    Rcpp::traits::input_parameter< bool >::type use_scalar(use_scalarSEXP);
+    Rcpp::traits::input_parameter< int >::type op(opSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrC(ptrCSEXP);
+    Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
+    Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
+    cpp_vclVector_logic(ptrA, ptrB, scalar, use_scalar, op, ptrC, device_flag, type_flag);
+    return R_NilValue;
+END_RCPP
+}
+// cpp_vclVector_not
+void cpp_vclVector_not(SEXP ptrA, SEXP ptrC, int device_flag, const int type_flag);
+RcppExport SEXP gpuR_cpp_vclVector_not(SEXP ptrASEXP, SEXP ptrCSEXP, SEXP device_flagSEXP, SEXP type_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrC(ptrCSEXP);
+    Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
+    Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
+    cpp_vclVector_not(ptrA, ptrC, device_flag, type_flag);
+    return R_NilValue;
+END_RCPP
+}
+// cpp_vclVector_compact
+SEXP cpp_vclVector_compact(SEXP ptrA, SEXP ptrM, int device_flag, const int type_flag);
+RcppExport SEXP gpuR_cpp_vclVector_compact(SEXP ptrASEXP, SEXP ptrMSEXP, SEXP device_flagSEXP, SEXP type_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject __result;
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrM(ptrMSEXP);
+    Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
+    Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
+    __result = Rcpp::wrap(cpp_vclVector_compact(ptrA, ptrM, device_flag, type_flag));
+    return __result;
+END_RCPP
+}
+// cpp_vclVector_which
+SEXP cpp_vclVector_which(SEXP ptrM, int device_flag);
+RcppExport SEXP gpuR_cpp_vclVector_which(SEXP ptrMSEXP, SEXP device_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject __result;
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrM(ptrMSEXP);
+    Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
+    __result = Rcpp::wrap(cpp_vclVector_which(ptrM, device_flag));
+    return __result;
+END_RCPP
+}
+// cpp_vclVector_where
+SEXP cpp_vclVector_where(SEXP ptrA, double scalar, int op, bool absolute, int device_flag, const int type_flag);
+RcppExport SEXP gpuR_cpp_vclVector_where(SEXP ptrASEXP, SEXP scalarSEXP, SEXP opSEXP, SEXP absoluteSEXP, SEXP device_flagSEXP, SEXP type_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject __result;
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
+    Rcpp::traits::input_parameter< double >::type scalar(scalarSEXP);
+    Rcpp::traits::input_parameter< int >::type op(opSEXP);
+    Rcpp::traits::input_parameter< bool >::type absolute(absoluteSEXP);
+    Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
+    Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
+    __result = Rcpp::wrap(cpp_vclVector_where(ptrA, scalar, op, absolute, device_flag, type_flag));
+    return __result;
+END_RCPP
+}
+// cpp_vclSparseMatrix
+SEXP cpp_vclSparseMatrix(SEXP i, SEXP p, SEXP x, int nr, int nc, int format, int device_flag, const int type_flag);
+RcppExport SEXP gpuR_cpp_vclSparseMatrix(SEXP iSEXP, SEXP pSEXP, SEXP xSEXP, SEXP nrSEXP, SEXP ncSEXP, SEXP formatSEXP, SEXP device_flagSEXP, SEXP type_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject __result;
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type i(iSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type p(pSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type x(xSEXP);
+    Rcpp::traits::input_parameter< int >::type nr(nrSEXP);
+    Rcpp::traits::input_parameter< int >::type nc(ncSEXP);
+    Rcpp::traits::input_parameter< int >::type format(formatSEXP);
+    Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
+    Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
+    __result = Rcpp::wrap(cpp_vclSparseMatrix(i, p, x, nr, nc, format, device_flag, type_flag));
+    return __result;
+END_RCPP
+}
+// cpp_vclSparseMatrix_dim
+IntegerVector cpp_vclSparseMatrix_dim(SEXP ptrA, const int type_flag);
+RcppExport SEXP gpuR_cpp_vclSparseMatrix_dim(SEXP ptrASEXP, SEXP type_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject __result;
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
+    Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
+    __result = Rcpp::wrap(cpp_vclSparseMatrix_dim(ptrA, type_flag));
+    return __result;
+END_RCPP
+}
+// cpp_vclSparseMatrix_vec_prod
+void cpp_vclSparseMatrix_vec_prod(SEXP ptrA, SEXP ptrB, SEXP ptrC, bool trans, int device_flag, const int type_flag);
+RcppExport SEXP gpuR_cpp_vclSparseMatrix_vec_prod(SEXP ptrASEXP, SEXP ptrBSEXP, SEXP ptrCSEXP, SEXP transSEXP, SEXP device_flagSEXP, SEXP type_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrB(ptrBSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrC(ptrCSEXP);
+    Rcpp::traits::input_parameter< bool >::type trans(transSEXP);
+    Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
+    Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
+    cpp_vclSparseMatrix_vec_prod(ptrA, ptrB, ptrC, trans, device_flag, type_flag);
+    return R_NilValue;
+END_RCPP
+}
+// cpp_vclSparseMatrix_mat_prod
+void cpp_vclSparseMatrix_mat_prod(SEXP ptrA, SEXP ptrB, SEXP ptrC, bool trans, int device_flag, const int type_flag);
+RcppExport SEXP gpuR_cpp_vclSparseMatrix_mat_prod(SEXP ptrASEXP, SEXP ptrBSEXP, SEXP ptrCSEXP, SEXP transSEXP, SEXP device_flagSEXP, SEXP type_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrB(ptrBSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrC(ptrCSEXP);
+    Rcpp::traits::input_parameter< bool >::type trans(transSEXP);
+    Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
+    Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
+    cpp_vclSparseMatrix_mat_prod(ptrA, ptrB, ptrC, trans, device_flag, type_flag);
+    return R_NilValue;
+END_RCPP
+}
+// cpp_vclSparseMatrix_sums
+void cpp_vclSparseMatrix_sums(SEXP ptrA, SEXP ptrC, bool rows, int device_flag, const int type_flag);
+RcppExport SEXP gpuR_cpp_vclSparseMatrix_sums(SEXP ptrASEXP, SEXP ptrCSEXP, SEXP rowsSEXP, SEXP device_flagSEXP, SEXP type_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrC(ptrCSEXP);
+    Rcpp::traits::input_parameter< bool >::type rows(rowsSEXP);
+    Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
+    Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
+    cpp_vclSparseMatrix_sums(ptrA, ptrC, rows, device_flag, type_flag);
+    return R_NilValue;
+END_RCPP
+}
+// cpp_gpuMatrix_pmcc
+void cpp_gpuMatrix_pmcc(SEXP ptrA, SEXP ptrB, int device_flag, const int type_flag);
+RcppExport SEXP gpuR_cpp_gpuMatrix_pmcc(SEXP ptrASEXP, SEXP ptrBSEXP, SEXP device_flagSEXP, SEXP type_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrB(ptrBSEXP);
+    Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
+    Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
+    cpp_gpuMatrix_pmcc(ptrA, ptrB, device_flag, type_flag);
+    return R_NilValue;
+END_RCPP
+}
+// cpp_vclMatrix_pmcc
+void cpp_vclMatrix_pmcc(SEXP ptrA, SEXP ptrB, int device_flag, const int type_flag);
+RcppExport SEXP gpuR_cpp_vclMatrix_pmcc(SEXP ptrASEXP, SEXP ptrBSEXP, SEXP device_flagSEXP, SEXP type_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrB(ptrBSEXP);
+    Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
+    Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
+    cpp_vclMatrix_pmcc(ptrA, ptrB, device_flag, type_flag);
+    return R_NilValue;
+END_RCPP
+}
+// cpp_vclMatrix_eucl
+void cpp_vclMatrix_eucl(SEXP ptrA, SEXP ptrD, bool squareDist, int device_flag, const int type_flag);
+RcppExport SEXP gpuR_cpp_vclMatrix_eucl(SEXP ptrASEXP, SEXP ptrDSEXP, SEXP squareDistSEXP, SEXP device_flagSEXP, SEXP type_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrD(ptrDSEXP);
+    Rcpp::traits::input_parameter< bool >::type squareDist(squareDistSEXP);
+    Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
+    Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
+    cpp_vclMatrix_eucl(ptrA, ptrD, squareDist, device_flag, type_flag);
+    return R_NilValue;
+END_RCPP
+}
+// cpp_vclMatrix_peucl
+void cpp_vclMatrix_peucl(SEXP ptrA, SEXP ptrB, SEXP ptrD, bool squareDist, int device_flag, const int type_flag);
+RcppExport SEXP gpuR_cpp_vclMatrix_peucl(SEXP ptrASEXP, SEXP ptrBSEXP, SEXP ptrDSEXP, SEXP squareDistSEXP, SEXP device_flagSEXP, SEXP type_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrB(ptrBSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrD(ptrDSEXP);
+    Rcpp::traits::input_parameter< bool >::type squareDist(squareDistSEXP);
+    Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
+    Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
+    cpp_vclMatrix_peucl(ptrA, ptrB, ptrD, squareDist, device_flag, type_flag);
+    return R_NilValue;
+END_RCPP
+}
+// cpp_gpuMatrix_eucl
+void cpp_gpuMatrix_eucl(SEXP ptrA, SEXP ptrD, bool squareDist, int device_flag, const int type_flag);
+RcppExport SEXP gpuR_cpp_gpuMatrix_eucl(SEXP ptrASEXP, SEXP ptrDSEXP, SEXP squareDistSEXP, SEXP device_flagSEXP, SEXP type_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrD(ptrDSEXP);
+    Rcpp::traits::input_parameter< bool >::type squareDist(squareDistSEXP);
+    Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
+    Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
+    cpp_gpuMatrix_eucl(ptrA, ptrD, squareDist, device_flag, type_flag);
+    return R_NilValue;
+END_RCPP
+}
+// cpp_gpuMatrix_peucl
+void cpp_gpuMatrix_peucl(SEXP ptrA, SEXP ptrB, SEXP ptrD, bool squareDist, int device_flag, const int type_flag);
+RcppExport SEXP gpuR_cpp_gpuMatrix_peucl(SEXP ptrASEXP, SEXP ptrBSEXP, SEXP ptrDSEXP, SEXP squareDistSEXP, SEXP device_flagSEXP, SEXP type_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrB(ptrBSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrD(ptrDSEXP);
+    Rcpp::traits::input_parameter< bool >::type squareDist(squareDistSEXP);
+    Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
+    Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
+    cpp_gpuMatrix_peucl(ptrA, ptrB, ptrD, squareDist, device_flag, type_flag);
+    return R_NilValue;
+END_RCPP
+}
+// cpp_gpuMatrix_colmean
+void cpp_gpuMatrix_colmean(SEXP ptrA, SEXP ptrB, int device_flag, const int type_flag);
+RcppExport SEXP gpuR_cpp_gpuMatrix_colmean(SEXP ptrASEXP, SEXP ptrBSEXP, SEXP device_flagSEXP, SEXP type_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrB(ptrBSEXP);
+    Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
+    Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
+    cpp_gpuMatrix_colmean(ptrA, ptrB, device_flag, type_flag);
+    return R_NilValue;
+END_RCPP
+}
+// cpp_gpuMatrix_colsum
+void cpp_gpuMatrix_colsum(SEXP ptrA, SEXP ptrB, int device_flag, const int type_flag);
+RcppExport SEXP gpuR_cpp_gpuMatrix_colsum(SEXP ptrASEXP, SEXP ptrBSEXP, SEXP device_flagSEXP, SEXP type_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrB(ptrBSEXP);
+    Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
+    Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
+    cpp_gpuMatrix_colsum(ptrA, ptrB, device_flag, type_flag);
+    return R_NilValue;
+END_RCPP
+}
+// cpp_gpuMatrix_rowmean
+void cpp_gpuMatrix_rowmean(SEXP ptrA, SEXP ptrB, int device_flag, const int type_flag);
+RcppExport SEXP gpuR_cpp_gpuMatrix_rowmean(SEXP ptrASEXP, SEXP ptrBSEXP, SEXP device_flagSEXP, SEXP type_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrB(ptrBSEXP);
+    Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
+    Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
+    cpp_gpuMatrix_rowmean(ptrA, ptrB, device_flag, type_flag);
     return R_NilValue;
 END_RCPP
 }
@@ -2657,6 +3874,58 @@ BEGIN_RCPP
     return R_NilValue;
 END_RCPP
 }
+// cpp_vclMatrix_colmax
+void cpp_vclMatrix_colmax(SEXP ptrA, SEXP ptrB, int device_flag, const int type_flag);
+RcppExport SEXP gpuR_cpp_vclMatrix_colmax(SEXP ptrASEXP, SEXP ptrBSEXP, SEXP device_flagSEXP, SEXP type_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrB(ptrBSEXP);
+    Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
+    Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
+    cpp_vclMatrix_colmax(ptrA, ptrB, device_flag, type_flag);
+    return R_NilValue;
+END_RCPP
+}
+// cpp_vclMatrix_colmin
+void cpp_vclMatrix_colmin(SEXP ptrA, SEXP ptrB, int device_flag, const int type_flag);
+RcppExport SEXP gpuR_cpp_vclMatrix_colmin(SEXP ptrASEXP, SEXP ptrBSEXP, SEXP device_flagSEXP, SEXP type_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrB(ptrBSEXP);
+    Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
+    Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
+    cpp_vclMatrix_colmin(ptrA, ptrB, device_flag, type_flag);
+    return R_NilValue;
+END_RCPP
+}
+// cpp_vclMatrix_rowmax
+void cpp_vclMatrix_rowmax(SEXP ptrA, SEXP ptrB, int device_flag, const int type_flag);
+RcppExport SEXP gpuR_cpp_vclMatrix_rowmax(SEXP ptrASEXP, SEXP ptrBSEXP, SEXP device_flagSEXP, SEXP type_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrB(ptrBSEXP);
+    Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
+    Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
+    cpp_vclMatrix_rowmax(ptrA, ptrB, device_flag, type_flag);
+    return R_NilValue;
+END_RCPP
+}
+// cpp_vclMatrix_rowmin
+void cpp_vclMatrix_rowmin(SEXP ptrA, SEXP ptrB, int device_flag, const int type_flag);
+RcppExport SEXP gpuR_cpp_vclMatrix_rowmin(SEXP ptrASEXP, SEXP ptrBSEXP, SEXP device_flagSEXP, SEXP type_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrB(ptrBSEXP);
+    Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
+    Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
+    cpp_vclMatrix_rowmin(ptrA, ptrB, device_flag, type_flag);
+    return R_NilValue;
+END_RCPP
+}
 // cpp_vclMatrix_rowmean
 void cpp_vclMatrix_rowmean(SEXP ptrA, SEXP ptrB, int device_flag, const int type_flag);
 RcppExport SEXP gpuR_cpp_vclMatrix_rowmean(SEXP ptrASEXP, SEXP ptrBSEXP, SEXP device_flagSEXP, SEXP type_flagSEXP) {
@@ -2683,3 +3952,75 @@ BEGIN_RCPP
     return R_NilValue;
 END_RCPP
 }
+// cpp_gpuMatrix_svd
+void cpp_gpuMatrix_svd(SEXP ptrA, SEXP ptrOmega, SEXP ptrD, SEXP ptrU, SEXP ptrV, int power, int device_flag, const int type_flag);
+RcppExport SEXP gpuR_cpp_gpuMatrix_svd(SEXP ptrASEXP, SEXP ptrOmegaSEXP, SEXP ptrDSEXP, SEXP ptrUSEXP, SEXP ptrVSEXP, SEXP powerSEXP, SEXP device_flagSEXP, SEXP type_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrOmega(ptrOmegaSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrD(ptrDSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrU(ptrUSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrV(ptrVSEXP);
+    Rcpp::traits::input_parameter< int >::type power(powerSEXP);
+    Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
+    Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
+    cpp_gpuMatrix_svd(ptrA, ptrOmega, ptrD, ptrU, ptrV, power, device_flag, type_flag);
+    return R_NilValue;
+END_RCPP
+}
+// cpp_vclMatrix_svd
+void cpp_vclMatrix_svd(SEXP ptrA, SEXP ptrOmega, SEXP ptrD, SEXP ptrU, SEXP ptrV, int power, int device_flag, const int type_flag);
+RcppExport SEXP gpuR_cpp_vclMatrix_svd(SEXP ptrASEXP, SEXP ptrOmegaSEXP, SEXP ptrDSEXP, SEXP ptrUSEXP, SEXP ptrVSEXP, SEXP powerSEXP, SEXP device_flagSEXP, SEXP type_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrOmega(ptrOmegaSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrD(ptrDSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrU(ptrUSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrV(ptrVSEXP);
+    Rcpp::traits::input_parameter< int >::type power(powerSEXP);
+    Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
+    Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
+    cpp_vclMatrix_svd(ptrA, ptrOmega, ptrD, ptrU, ptrV, power, device_flag, type_flag);
+    return R_NilValue;
+END_RCPP
+}
+// cpp_gpuMatrix_prcomp
+void cpp_gpuMatrix_prcomp(SEXP ptrA, SEXP ptrOmega, SEXP ptrCenter, SEXP ptrScale, SEXP ptrSdev, SEXP ptrR, SEXP ptrX, int power, int device_flag, const int type_flag);
+RcppExport SEXP gpuR_cpp_gpuMatrix_prcomp(SEXP ptrASEXP, SEXP ptrOmegaSEXP, SEXP ptrCenterSEXP, SEXP ptrScaleSEXP, SEXP ptrSdevSEXP, SEXP ptrRSEXP, SEXP ptrXSEXP, SEXP powerSEXP, SEXP device_flagSEXP, SEXP type_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrOmega(ptrOmegaSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrCenter(ptrCenterSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrScale(ptrScaleSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrSdev(ptrSdevSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrR(ptrRSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrX(ptrXSEXP);
+    Rcpp::traits::input_parameter< int >::type power(powerSEXP);
+    Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
+    Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
+    cpp_gpuMatrix_prcomp(ptrA, ptrOmega, ptrCenter, ptrScale, ptrSdev, ptrR, ptrX, power, device_flag, type_flag);
+    return R_NilValue;
+END_RCPP
+}
+// cpp_vclMatrix_prcomp
+void cpp_vclMatrix_prcomp(SEXP ptrA, SEXP ptrOmega, SEXP ptrCenter, SEXP ptrScale, SEXP ptrSdev, SEXP ptrR, SEXP ptrX, int power, int device_flag, const int type_flag);
+RcppExport SEXP gpuR_cpp_vclMatrix_prcomp(SEXP ptrASEXP, SEXP ptrOmegaSEXP, SEXP ptrCenterSEXP, SEXP ptrScaleSEXP, SEXP ptrSdevSEXP, SEXP ptrRSEXP, SEXP ptrXSEXP, SEXP powerSEXP, SEXP device_flagSEXP, SEXP type_flagSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type ptrA(ptrASEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrOmega(ptrOmegaSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrCenter(ptrCenterSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrScale(ptrScaleSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrSdev(ptrSdevSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrR(ptrRSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ptrX(ptrXSEXP);
+    Rcpp::traits::input_parameter< int >::type power(powerSEXP);
+    Rcpp::traits::input_parameter< int >::type device_flag(device_flagSEXP);
+    Rcpp::traits::input_parameter< const int >::type type_flag(type_flagSEXP);
+    cpp_vclMatrix_prcomp(ptrA, ptrOmega, ptrCenter, ptrScale, ptrSdev, ptrR, ptrX, power, device_flag, type_flag);
+    return R_NilValue;
+END_RCPP
+}
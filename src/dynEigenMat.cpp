@@ -1,62 +1,60 @@
 
 #include "gpuR/windows_check.hpp"
 #include "gpuR/dynEigenMat.hpp"
+#include "gpuR/trace_helpers.hpp"
+#include "gpuR/vcl_rect_copy.hpp"
+
+#include <map>
 
 template<typename T>
 dynEigenMat<T>::dynEigenMat(SEXP A_)
 {
     A = Rcpp::as<Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> >(A_);
-    orig_nr = A.rows();
-    orig_nc = A.cols();
     nr = A.rows();
     nc = A.cols();
     r_start = 1;
     r_end = nr;
     c_start = 1;
     c_end = nc;
-    ptr = A.data();
+    ptr = &A;
 }
 
 template<typename T>
 dynEigenMat<T>::dynEigenMat(Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> &A_)
 {
     A = A_;
-    orig_nr = A.rows();
-    orig_nc = A.cols();
     nr = A.rows();
     nc = A.cols();
     r_start = 1;
     r_end = nr;
     c_start = 1;
     c_end = nc;
-    ptr = A.data();
+    ptr = &A;
 }
 
 template<typename T>
 dynEigenMat<T>::dynEigenMat(Rcpp::XPtr<dynEigenMat<T> > dynMat)
 {
+    ptr = dynMat->getPtr();
     nr = dynMat->nrow();
     nc = dynMat->ncol();
     r_start = dynMat->row_start();
     r_end = dynMat->row_end();
     c_start = dynMat->col_start();
     c_end = dynMat->col_end();
-    ptr = dynMat->getPtr();
 }
 
 template<typename T>
 dynEigenMat<T>::dynEigenMat(int nr_in, int nc_in)
 {
     A = Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>::Zero(nr_in, nc_in);
-    orig_nr = nr_in;
-    orig_nc = nc_in;
     nr = nr_in;
     nc = nc_in;
     r_start = 1;
     r_end = nr_in;
     c_start = 1;
     c_end = nc_in;
-    ptr = A.data();
+    ptr = &A;
 }
 
 template<typename T>
@@ -66,21 +64,20 @@ dynEigenMat<T>::dynEigenMat(
     const int col_start, const int col_end)
 {
     A = A_;
-    orig_nr = A.rows();
-    orig_nc = A.cols();
     nr = A.rows();
     nc = A.cols();
     r_start = row_start-1;
     r_end = row_end-1;
     c_start = col_start-1;
     c_end = col_end-1;
-    ptr = A.data();
+    ptr = &A;
 }
 
 template<typename T>
 Eigen::Ref<Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> >
 dynEigenMat<T>::data() { 
-    Eigen::Map<Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> > temp(ptr, orig_nr, orig_nc);
+    Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> *src = storage();
+    Eigen::Map<Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> > temp(src->data(), src->rows(), src->cols());
 //    std::cout << "row start: " << r_start << std::endl;
 //    std::cout << "col start: " << c_start << std::endl;
 //    std::cout << "row end: " << r_end << std::endl;
@@ -101,32 +98,30 @@ template<typename T>
 dynEigenMat<T>::dynEigenMat(T scalar, int nr_in, int nc_in)
 {
     A = Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>::Constant(nr_in, nc_in, scalar);
-    orig_nr = nr_in;
-    orig_nc = nc_in;
     nr = nr_in;
     nc = nc_in;
     r_start = 1;
     r_end = nr_in;
     c_start = 1;
     c_end = nc_in;
-    ptr = A.data();
+    ptr = &A;
 }
 
 template<typename T>
 viennacl::matrix<T>
 dynEigenMat<T>::device_data() {
-    Eigen::Map<Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> > temp(ptr, orig_nr, orig_nc);
+    Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> *src = storage();
+    Eigen::Map<Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> > temp(src->data(), src->rows(), src->cols());
     Eigen::Ref<Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> > ref = temp.block(r_start-1, c_start-1, r_end-r_start + 1, c_end-c_start + 1);
-    Eigen::Map<Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>, 0, Eigen::OuterStride<> > block(
-        ref.data(), ref.rows(), ref.cols(),
-        Eigen::OuterStride<>(ref.outerStride())
-    );
     
-    const int M = block.cols();
-    const int K = block.rows();
+    const int M = ref.cols();
+    const int K = ref.rows();
+    
+    traceScope span("device_data", (double)K * M * sizeof(T));
     
+    // the block goes up in one strided transfer, see vcl_rect_copy.hpp
     viennacl::matrix<T> vclMat(K,M);
-    viennacl::copy(block, vclMat);
+    vcl_write_block(ref.data(), ref.outerStride(), vclMat);
     
     return vclMat;
     
@@ -135,14 +130,149 @@ dynEigenMat<T>::device_data() {
 template<typename T>
 void
 dynEigenMat<T>::to_host(viennacl::matrix<T> &vclMat) {
-    Eigen::Map<Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> > temp(ptr, orig_nr, orig_nc);
+    detach();
+    
+    Eigen::Map<Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> > temp(ptr->data(), ptr->rows(), ptr->cols());
     Eigen::Ref<Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> > ref = temp.block(r_start-1, c_start-1, r_end-r_start + 1, c_end-c_start + 1);
-    Eigen::Map<Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>, 0, Eigen::OuterStride<> > block(
-        ref.data(), ref.rows(), ref.cols(),
-        Eigen::OuterStride<>(ref.outerStride())
-    );
     
-    viennacl::copy(vclMat, block);    
+    traceScope span("to_host", (double)ref.size() * sizeof(T));
+    
+    vcl_read_block(vclMat, ref.data(), ref.outerStride());
+}
+
+// storage lent to lazy copies, keyed by the lender's matrix so writes
+// through any block of the lender find it as well
+template<typename T>
+static std::map<Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>*, std::weak_ptr<eigenMatLink<T> > > &
+eigen_lent()
+{
+    static std::map<Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>*, std::weak_ptr<eigenMatLink<T> > > lent;
+    return lent;
+}
+
+template<typename T>
+dynEigenMat<T>::~dynEigenMat()
+{
+    if(ptr != &A){
+        return;
+    }
+    
+    // copies still reading this storage take it over, no copy is needed
+    typename std::map<Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>*, std::weak_ptr<eigenMatLink<T> > >::iterator it = eigen_lent<T>().find(ptr);
+    if(it == eigen_lent<T>().end()){
+        return;
+    }
+    
+    std::shared_ptr<eigenMatLink<T> > lent = it->second.lock();
+    eigen_lent<T>().erase(it);
+    
+    if(lent){
+        lent->snapshot.swap(A);
+        lent->source = NULL;
+    }
+}
+
+// lazy deep copy, the new object reads this storage until either side is
+// written, see detach()
+template<typename T>
+dynEigenMat<T>*
+dynEigenMat<T>::share()
+{
+    std::shared_ptr<eigenMatLink<T> > lent = link;
+    
+    if(!lent){
+        std::weak_ptr<eigenMatLink<T> > &entry = eigen_lent<T>()[ptr];
+        lent = entry.lock();
+        if(!lent){
+            lent = std::make_shared<eigenMatLink<T> >();
+            lent->source = ptr;
+            entry = lent;
+        }
+    }
+    
+    dynEigenMat<T> *mat = new dynEigenMat<T>();
+    mat->ptr = NULL;
+    mat->link = lent;
+    mat->nr = nr;
+    mat->nc = nc;
+    mat->r_start = r_start;
+    mat->r_end = r_end;
+    mat->c_start = c_start;
+    mat->c_end = c_end;
+    return mat;
+}
+
+// make a lazy copy own its data
+template<typename T>
+void
+dynEigenMat<T>::detach_copy()
+{
+    if(ptr){
+        return;
+    }
+    
+    A = data();
+    ptr = &A;
+    r_start = 1;
+    r_end = nr;
+    c_start = 1;
+    c_end = nc;
+    link.reset();
+}
+
+// call before writing: a lazy copy takes its own copy of the data and a
+// lender hands its current data to the copies still reading it
+template<typename T>
+void
+dynEigenMat<T>::detach()
+{
+    if(!ptr){
+        detach_copy();
+        return;
+    }
+    
+    typename std::map<Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>*, std::weak_ptr<eigenMatLink<T> > >::iterator it = eigen_lent<T>().find(ptr);
+    if(it == eigen_lent<T>().end()){
+        return;
+    }
+    
+    std::shared_ptr<eigenMatLink<T> > lent = it->second.lock();
+    eigen_lent<T>().erase(it);
+    
+    if(lent){
+        lent->snapshot = *ptr;
+        lent->source = NULL;
+    }
+}
+
+// append rows in place, the storage grows geometrically so a run of
+// appends costs amortized O(new rows) and blocks of this matrix remain
+// valid as they refer to A rather than its buffer
+template<typename T>
+void
+dynEigenMat<T>::append_rows(const Eigen::Ref<const Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> > &B)
+{
+    detach();
+    
+    if(ptr != &A || r_start != 1 || c_start != 1 || c_end != A.cols()){
+        throw Rcpp::exception("rows can only be appended to a full gpuMatrix, not a block");
+    }
+    if(B.cols() != nc){
+        throw Rcpp::exception("number of columns of matrices must match");
+    }
+    
+    const int k = B.rows();
+    if(nr + k > A.rows()){
+        const int capacity = std::max(nr + k, 2 * (int)A.rows());
+        
+        Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> grown(capacity, nc);
+        grown.topRows(nr) = A.topRows(nr);
+        A.swap(grown);
+    }
+    
+    A.middleRows(nr, k) = B;
+    nr += k;
+    r_end = nr;
 }
 
 template class dynEigenMat<int>;
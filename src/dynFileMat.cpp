@@ -0,0 +1,21 @@
+
+#include "gpuR/windows_check.hpp"
+#include "gpuR/dynFileMat.hpp"
+
+template<typename T>
+dynFileMat<T>::dynFileMat(std::string path_, int type_flag, bool writable_) 
+    : writable(writable_), path(path_), map(path_, writable_)
+{
+    const matrixFileHeader h = map.header();
+    
+    if(h.type_flag != type_flag || matrix_file_elem_size(type_flag) != sizeof(T)){
+        throw Rcpp::exception("matrix file type does not match the matrix");
+    }
+    
+    nr = h.nrow;
+    nc = h.ncol;
+}
+
+template class dynFileMat<int>;
+template class dynFileMat<float>;
+template class dynFileMat<double>;
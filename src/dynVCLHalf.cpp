@@ -0,0 +1,18 @@
+#include "gpuR/windows_check.hpp"
+#include "gpuR/dynVCLHalf.hpp"
+
+#include <RcppEigen.h>
+
+// uninitialized, in the current context
+dynVCLHalf::dynVCLHalf(int nr_in, int nc_in)
+{
+    if(nr_in < 1 || nc_in < 1){
+        throw Rcpp::exception("a half precision object must have at least one element");
+    }
+
+    nr = nr_in;
+    nc = nc_in;
+
+    viennacl::backend::memory_create(buf, sizeof(cl_half) * size(),
+                                     viennacl::context(viennacl::ocl::current_context()));
+}
@@ -2,14 +2,34 @@
 
 #include "gpuR/windows_check.hpp"
 #include "gpuR/dynVCLMat.hpp"
+#include "gpuR/trace_helpers.hpp"
+#include "gpuR/vcl_rect_copy.hpp"
+
+#include <map>
+#include <vector>
 
 template<typename T>
 dynVCLMat<T>::dynVCLMat(SEXP A_, int device_flag)
 {
-    
-    Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> Am;
-    Am = Rcpp::as<Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> >(A_);
-    
+    upload(A_, Rf_nrows(A_), Rf_ncols(A_), device_flag);
+}
+
+// an R vector filling a nr_in x nc_in matrix in column-major order
+template<typename T>
+dynVCLMat<T>::dynVCLMat(SEXP A_, int nr_in, int nc_in, int device_flag)
+{
+    if(Rf_xlength(A_) != (R_xlen_t)nr_in * nc_in){
+        throw Rcpp::exception("length of data does not match the matrix dimensions");
+    }
+    upload(A_, nr_in, nc_in, device_flag);
+}
+
+// R's column-major elements go up in one strided transfer, read in place
+// when R stores them as T rather than through an Eigen copy
+template<typename T>
+void
+dynVCLMat<T>::upload(SEXP A_, int nr_in, int nc_in, int device_flag)
+{
     // define device type to use
     if(device_flag == 0){
         //use only GPUs
@@ -23,18 +43,24 @@ dynVCLMat<T>::dynVCLMat(SEXP A_, int device_flag)
         viennacl::ocl::switch_context(id);
     }
     
-    int K = Am.rows();
-    int M = Am.cols();
+    std::vector<T> converted;
+    const T *host;
+    if(vclRStorage<T>::direct && TYPEOF(A_) == vclRStorage<T>::rtype){
+        host = reinterpret_cast<const T *>(Rcpp::internal::r_vector_start<vclRStorage<T>::rtype>(A_));
+    }else{
+        converted = Rcpp::as<std::vector<T> >(A_);
+        host = converted.empty() ? NULL : &converted[0];
+    }
     
-    A = viennacl::matrix<T>(K,M);
-      
-    viennacl::copy(Am, A); 
+    A = viennacl::matrix<T>(nr_in, nc_in);
     
-//    std::cout << "initial vcl vector" << std::endl;
-//    std::cout << A << std::endl;
+    {
+        traceScope span("dynVCLMat upload", (double)A.size1() * A.size2() * sizeof(T));
+        vcl_write_block(host, nr_in, A);
+    }
     
-    nr = K;
-    nc = M;
+    nr = nr_in;
+    nc = nc_in;
     ptr = &A;
     viennacl::range temp_rr(0, nr);
     viennacl::range temp_cr(0, nc);
@@ -63,7 +89,10 @@ dynVCLMat<T>::dynVCLMat(
     }
         
     A = viennacl::matrix<T>(nr_in, nc_in);
-    viennacl::copy(Am, A); 
+    {
+        traceScope span("dynVCLMat upload", (double)A.size1() * A.size2() * sizeof(T));
+        vcl_write_block(Am.data(), Am.rows(), A);
+    }
     
     nr = nr_in;
     nc = nc_in;
@@ -127,14 +156,58 @@ dynVCLMat<T>::dynVCLMat(int nr_in, int nc_in, T scalar, int device_flag)
 }
 
 
+// unpadded nr x nc matrix whose buffer is allocated but never cleared,
+// for results the caller overwrites completely
+template<typename T>
+static viennacl::matrix<T>
+vcl_uninitialized_matrix(int nr_in, int nc_in, int device_flag)
+{
+    // define device type to use
+    if(device_flag == 0){
+        //use only GPUs
+        long id = 0;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::gpu_tag());
+        viennacl::ocl::switch_context(id);
+    }else{
+        // use only CPUs
+        long id = 1;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::cpu_tag());
+        viennacl::ocl::switch_context(id);
+    }
+    
+    if(nr_in == 0 || nc_in == 0){
+        return viennacl::matrix<T>(nr_in, nc_in);
+    }
+    
+    viennacl::backend::mem_handle h;
+    viennacl::backend::memory_create(h, sizeof(T) * nr_in * nc_in, 
+                                     viennacl::context(viennacl::ocl::current_context()));
+    
+    // the matrix retains the buffer, it outlives 'h'
+    return viennacl::matrix<T>(h.opencl_handle().get(), nr_in, nc_in);
+}
+
+template<typename T>
+dynVCLMat<T>::dynVCLMat(int nr_in, int nc_in, int device_flag, vclUninitialized)
+    : A(vcl_uninitialized_matrix<T>(nr_in, nc_in, device_flag))
+{
+    nr = nr_in;
+    nc = nc_in;
+    ptr = &A;
+    viennacl::range temp_rr(0, nr);
+    viennacl::range temp_cr(0, nc);
+    row_r = temp_rr;
+    col_r = temp_cr;
+}
+
 template<typename T>
 dynVCLMat<T>::dynVCLMat(Rcpp::XPtr<dynVCLMat<T> > dynMat)
 {
+    ptr = dynMat->getPtr();
     nr = dynMat->nrow();
     nc = dynMat->ncol();
     row_r = dynMat->row_range();
     col_r = dynMat->col_range();
-    ptr = dynMat->getPtr();
 }
 
 template<typename T>
@@ -158,10 +231,177 @@ dynVCLMat<T>::setPtr(viennacl::matrix<T>* ptr_){
 template<typename T>
 viennacl::matrix_range<viennacl::matrix<T> >
 dynVCLMat<T>::data() { 
-    viennacl::matrix_range<viennacl::matrix<T> > m_sub(*ptr, row_r, col_r);
+    viennacl::matrix_range<viennacl::matrix<T> > m_sub(*storage(), row_r, col_r);
     return m_sub;
 }
 
+// storage lent to lazy copies, keyed by the lender's matrix so writes
+// through any block of the lender find it as well
+template<typename T>
+static std::map<viennacl::matrix<T>*, std::weak_ptr<vclMatLink<T> > > &
+vcl_lent()
+{
+    static std::map<viennacl::matrix<T>*, std::weak_ptr<vclMatLink<T> > > lent;
+    return lent;
+}
+
+template<typename T>
+dynVCLMat<T>::~dynVCLMat()
+{
+    // copies still reading this storage keep a snapshot of it
+    if(ptr == &A){
+        detach();
+    }
+}
+
+// lazy deep copy, the new object reads this storage until either side is
+// written, see detach()
+template<typename T>
+dynVCLMat<T>*
+dynVCLMat<T>::share()
+{
+    std::shared_ptr<vclMatLink<T> > lent = link;
+    
+    if(!lent){
+        std::weak_ptr<vclMatLink<T> > &entry = vcl_lent<T>()[ptr];
+        lent = entry.lock();
+        if(!lent){
+            lent = std::make_shared<vclMatLink<T> >();
+            lent->source = ptr;
+            entry = lent;
+        }
+    }
+    
+    dynVCLMat<T> *mat = new dynVCLMat<T>();
+    mat->ptr = NULL;
+    mat->link = lent;
+    mat->nr = nr;
+    mat->nc = nc;
+    mat->row_r = row_r;
+    mat->col_r = col_r;
+    return mat;
+}
+
+// make a lazy copy own its data
+template<typename T>
+void
+dynVCLMat<T>::detach_copy()
+{
+    if(ptr){
+        return;
+    }
+    
+    A = data();
+    ptr = &A;
+    row_r = viennacl::range(0, A.size1());
+    col_r = viennacl::range(0, A.size2());
+    link.reset();
+}
+
+// call before writing: a lazy copy takes its own copy of the data and a
+// lender hands its current data to the copies still reading it
+template<typename T>
+void
+dynVCLMat<T>::detach()
+{
+    if(!ptr){
+        detach_copy();
+        return;
+    }
+    
+    typename std::map<viennacl::matrix<T>*, std::weak_ptr<vclMatLink<T> > >::iterator it = vcl_lent<T>().find(ptr);
+    if(it == vcl_lent<T>().end()){
+        return;
+    }
+    
+    std::shared_ptr<vclMatLink<T> > lent = it->second.lock();
+    vcl_lent<T>().erase(it);
+    
+    if(lent){
+        lent->snapshot = *ptr;
+        lent->source = NULL;
+    }
+}
+
+// make room for k more rows, growing the storage geometrically so a run
+// of appends costs amortized O(new rows).  A stays the same object so
+// blocks of this matrix remain valid.
+template<typename T>
+void
+dynVCLMat<T>::reserve_rows(int k)
+{
+    detach();
+    
+    if(ptr != &A || row_r.start() != 0 || col_r.start() != 0 || col_r.size() != A.size2()){
+        throw Rcpp::exception("rows can only be appended to a full vclMatrix, not a block");
+    }
+    
+    const int rows = row_r.size();
+    if(rows + k <= (int)A.size1()){
+        return;
+    }
+    
+    const int capacity = std::max(rows + k, 2 * (int)A.size1());
+    
+    // stage the live rows, resize discards the old buffer
+    viennacl::matrix<T> live(rows, nc, viennacl::traits::context(A));
+    if(rows > 0){
+        live = data();
+    }
+    
+    A.resize(capacity, nc, false);
+    
+    if(rows > 0){
+        viennacl::matrix_range<viennacl::matrix<T> > head(A, viennacl::range(0, rows), viennacl::range(0, nc));
+        head = live;
+    }
+}
+
+template<typename T>
+void
+dynVCLMat<T>::append_rows(Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> &B)
+{
+    if(B.cols() != nc){
+        throw Rcpp::exception("number of columns of matrices must match");
+    }
+    
+    const int rows = row_r.size();
+    const int k = B.rows();
+    reserve_rows(k);
+    
+    if(k > 0){
+        viennacl::matrix_range<viennacl::matrix<T> > tail(A, viennacl::range(rows, rows + k), viennacl::range(0, nc));
+        traceScope span("dynVCLMat append", (double)k * nc * sizeof(T));
+        vcl_write_block(B.data(), B.rows(), tail);
+    }
+    
+    nr = rows + k;
+    row_r = viennacl::range(0, nr);
+}
+
+template<typename T>
+void
+dynVCLMat<T>::append_rows(viennacl::matrix_range<viennacl::matrix<T> > B)
+{
+    if((int)B.size2() != nc){
+        throw Rcpp::exception("number of columns of matrices must match");
+    }
+    
+    const int rows = row_r.size();
+    const int k = B.size1();
+    
+    // B may view this matrix, its rows keep their place when A grows
+    reserve_rows(k);
+    
+    if(k > 0){
+        viennacl::matrix_range<viennacl::matrix<T> > tail(A, viennacl::range(rows, rows + k), viennacl::range(0, nc));
+        tail = B;
+    }
+    
+    nr = rows + k;
+    row_r = viennacl::range(0, nr);
+}
+
 template class dynVCLMat<int>;
 template class dynVCLMat<float>;
 template class dynVCLMat<double>;
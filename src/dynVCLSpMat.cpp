@@ -0,0 +1,191 @@
+#include "gpuR/windows_check.hpp"
+#include "gpuR/dynVCLSpMat.hpp"
+#include "gpuR/trace_helpers.hpp"
+
+#include "viennacl/tools/adapter.hpp"
+
+#include <map>
+
+// CSR of the transpose, a counting sort over the columns so columns stay
+// in increasing order within each row
+template <typename T>
+static hostCSR<T>
+csr_transpose(const hostCSR<T> &A)
+{
+    hostCSR<T> At;
+    At.nr = A.nc;
+    At.nc = A.nr;
+
+    const size_t nnz = A.cols.size();
+    At.row_jumper.assign(A.nc + 1, 0);
+    At.cols.resize(nnz);
+    At.elements.resize(nnz);
+
+    for(size_t k = 0; k < nnz; k++){
+        At.row_jumper[A.cols[k] + 1]++;
+    }
+    for(int j = 0; j < A.nc; j++){
+        At.row_jumper[j + 1] += At.row_jumper[j];
+    }
+
+    std::vector<unsigned int> next(At.row_jumper.begin(), At.row_jumper.end() - 1);
+    for(int i = 0; i < A.nr; i++){
+        for(unsigned int k = A.row_jumper[i]; k < A.row_jumper[i + 1]; k++){
+            const unsigned int dst = next[A.cols[k]]++;
+            At.cols[dst] = i;
+            At.elements[dst] = A.elements[k];
+        }
+    }
+
+    return At;
+}
+
+template <typename T>
+static void
+csr_upload(const hostCSR<T> &A, viennacl::compressed_matrix<T> &vcl_A)
+{
+    traceScope span("dynVCLSpMat upload",
+                    (double)A.cols.size() * (sizeof(T) + sizeof(unsigned int)) +
+                    (double)A.row_jumper.size() * sizeof(unsigned int));
+    vcl_A.set(&A.row_jumper[0], &A.cols[0], &A.elements[0], A.nr, A.nc, A.cols.size());
+}
+
+// from the compressed sparse column arrays of a dgCMatrix: 0-based row
+// indices i, column pointers p and values x
+template<typename T>
+dynVCLSpMat<T>::dynVCLSpMat(
+    SEXP i_, SEXP p_, SEXP x_,
+    int nr_in, int nc_in,
+    int format_in, int device_flag)
+{
+    Rcpp::IntegerVector i(i_);
+    Rcpp::IntegerVector p(p_);
+    Rcpp::NumericVector x(x_);
+
+    if(nr_in < 1 || nc_in < 1){
+        throw Rcpp::exception("a vclSparseMatrix must have at least one row and column");
+    }
+    if(p.size() != nc_in + 1 || i.size() != x.size() || p[nc_in] != i.size()){
+        throw Rcpp::exception("malformed compressed sparse column arrays");
+    }
+
+    // define device type to use
+    if(device_flag == 0){
+        //use only GPUs
+        long id = 0;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::gpu_tag());
+        viennacl::ocl::switch_context(id);
+    }else{
+        // use only CPUs
+        long id = 1;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::cpu_tag());
+        viennacl::ocl::switch_context(id);
+    }
+
+    // the column-compressed arrays are the CSR form of the transpose
+    hostCSR<T> At;
+    At.nr = nc_in;
+    At.nc = nr_in;
+    At.row_jumper.assign(p.begin(), p.end());
+    At.cols.assign(i.begin(), i.end());
+    At.elements.assign(x.begin(), x.end());
+
+    hostCSR<T> A = csr_transpose(At);
+
+    // the device buffers cannot be empty, an all zero matrix keeps an
+    // explicit zero at [1, 1]
+    if(A.cols.empty()){
+        A.row_jumper.assign(nr_in + 1, 1);
+        A.row_jumper[0] = 0;
+        A.cols.push_back(0);
+        A.elements.push_back(0);
+    }
+
+    nr = nr_in;
+    nc = nc_in;
+    format = format_in;
+
+    if(format == GPUR_SPARSE_COO){
+        std::vector<std::map<unsigned int, T> > rows(nr);
+        for(int r = 0; r < nr; r++){
+            for(unsigned int k = A.row_jumper[r]; k < A.row_jumper[r + 1]; k++){
+                rows[r][A.cols[k]] = A.elements[k];
+            }
+        }
+
+        viennacl::tools::const_sparse_matrix_adapter<T, unsigned int> adapted(rows, nr, nc);
+        traceScope span("dynVCLSpMat upload",
+                        (double)A.cols.size() * (sizeof(T) + 2 * sizeof(unsigned int)));
+        viennacl::copy(adapted, coo_);
+    }else{
+        csr_upload(A, csr_);
+    }
+}
+
+// the CSR arrays back from the device
+template<typename T>
+hostCSR<T>
+dynVCLSpMat<T>::download()
+{
+    hostCSR<T> A;
+    A.nr = nr;
+    A.nc = nc;
+
+    const size_t n = nnz();
+    A.cols.resize(n);
+    A.elements.resize(n);
+
+    traceScope span("dynVCLSpMat download",
+                    (double)n * (sizeof(T) + 2 * sizeof(unsigned int)));
+
+    if(format == GPUR_SPARSE_COO){
+        // (row, column) pairs, stored row by row as they were uploaded
+        std::vector<unsigned int> coords(2 * n);
+        viennacl::backend::memory_read(coo_.handle12(), 0, sizeof(unsigned int) * 2 * n, &coords[0]);
+        viennacl::backend::memory_read(coo_.handle(), 0, sizeof(T) * n, &A.elements[0]);
+
+        A.row_jumper.assign(nr + 1, 0);
+        for(size_t k = 0; k < n; k++){
+            A.row_jumper[coords[2 * k] + 1]++;
+            A.cols[k] = coords[2 * k + 1];
+        }
+        for(int r = 0; r < nr; r++){
+            A.row_jumper[r + 1] += A.row_jumper[r];
+        }
+    }else{
+        A.row_jumper.resize(nr + 1);
+        viennacl::backend::memory_read(csr_.handle1(), 0, sizeof(unsigned int) * (nr + 1), &A.row_jumper[0]);
+        viennacl::backend::memory_read(csr_.handle2(), 0, sizeof(unsigned int) * n, &A.cols[0]);
+        viennacl::backend::memory_read(csr_.handle(), 0, sizeof(T) * n, &A.elements[0]);
+    }
+
+    return A;
+}
+
+// CSR form of the transpose, built once from the device copy
+template<typename T>
+viennacl::compressed_matrix<T>&
+dynVCLSpMat<T>::trans()
+{
+    if(!trans_){
+        hostCSR<T> At = csr_transpose(download());
+        trans_.reset(new viennacl::compressed_matrix<T>());
+        csr_upload(At, *trans_);
+    }
+    return *trans_;
+}
+
+// the matrix in CSR whatever its format, a COO matrix fills the unused
+// CSR member once
+template<typename T>
+viennacl::compressed_matrix<T>&
+dynVCLSpMat<T>::compressed()
+{
+    if(format == GPUR_SPARSE_COO && csr_.nnz() == 0){
+        csr_upload(download(), csr_);
+    }
+    return csr_;
+}
+
+template class dynVCLSpMat<float>;
+template class dynVCLSpMat<double>;
@@ -2,6 +2,7 @@
 
 #include "gpuR/windows_check.hpp"
 #include "gpuR/dynVCLVec.hpp"
+#include "gpuR/trace_helpers.hpp"
 
 template<typename T>
 dynVCLVec<T>::dynVCLVec(SEXP A_, int device_flag)
@@ -25,7 +26,10 @@ dynVCLVec<T>::dynVCLVec(SEXP A_, int device_flag)
     int K = Am.size();
     
     A = viennacl::vector<T>(K);    
-    viennacl::copy(Am, A); 
+    {
+        traceScope span("dynVCLVec upload", (double)K * sizeof(T));
+        viennacl::copy(Am, A); 
+    }
     
     size = K;
     begin = 1;
@@ -65,7 +65,6 @@ gpuMatBlock(
     dynEigenMat<T> *mat = new dynEigenMat<T>();
     mat->setPtr(pA->getPtr());
     mat->setRange(rowStart, rowEnd, colStart, colEnd);
-    mat->setSourceDim(pA->nrow(), pA->ncol());
     mat->updateDim();
     
     XPtr<dynEigenMat<T> > pMat(mat);
@@ -111,6 +110,35 @@ cpp_rbind_gpuMatrix(SEXP ptrA_, SEXP ptrB_)
 }
 
 
+// append rows of an R matrix to a gpuMatrix in place
+template <typename T>
+void
+cpp_gpuMatrix_append_rows(SEXP ptrA_, SEXP B_)
+{
+    XPtr<dynEigenMat<T> > pA(ptrA_);
+    Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> B = as<Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> >(B_);
+    pA->append_rows(B);
+}
+
+// lazy copy of a gpuMatrix, see dynEigenMat::share
+template <typename T>
+SEXP
+cpp_share_gpuMatrix(SEXP ptrA_)
+{
+    XPtr<dynEigenMat<T> > pA(ptrA_);
+    XPtr<dynEigenMat<T> > pMat(pA->share());
+    return pMat;
+}
+
+// call before a gpuMatrix is written so no lazy copy sees the write
+template <typename T>
+void
+cpp_gpuMatrix_detach(SEXP ptrA_)
+{
+    XPtr<dynEigenMat<T> > pA(ptrA_);
+    pA->detach();
+}
+
 template <typename T>
 Eigen::Map<Eigen::Matrix<T, Eigen::Dynamic, 1> >
 get_gpu_slice_vec(const SEXP ptrA)
@@ -163,6 +191,42 @@ cpp_deepcopy_gpuMatrix(SEXP ptrA, const int type_flag)
     }
 }
 
+/*** gpuMatrix lazy deepcopy ***/
+// [[Rcpp::export]]
+SEXP
+cpp_share_gpuMatrix(SEXP ptrA, const int type_flag)
+{
+    switch(type_flag) {
+        case 4:
+            return cpp_share_gpuMatrix<int>(ptrA);
+        case 6:
+            return cpp_share_gpuMatrix<float>(ptrA);
+        case 8:
+            return cpp_share_gpuMatrix<double>(ptrA);
+        default:
+            throw Rcpp::exception("unknown type detected for gpuMatrix object!");
+    }
+}
+
+// [[Rcpp::export]]
+void
+cpp_gpuMatrix_detach(SEXP ptrA, const int type_flag)
+{
+    switch(type_flag) {
+        case 4:
+            cpp_gpuMatrix_detach<int>(ptrA);
+            return;
+        case 6:
+            cpp_gpuMatrix_detach<float>(ptrA);
+            return;
+        case 8:
+            cpp_gpuMatrix_detach<double>(ptrA);
+            return;
+        default:
+            throw Rcpp::exception("unknown type detected for gpuMatrix object!");
+    }
+}
+
 /*** gpuMatrix cbind ***/
 // [[Rcpp::export]]
 SEXP
@@ -197,6 +261,26 @@ cpp_rbind_gpuMatrix(SEXP ptrA, SEXP ptrB, const int type_flag)
     }
 }
 
+/*** gpuMatrix append rows ***/
+// [[Rcpp::export]]
+void
+cpp_gpuMatrix_append_rows(SEXP ptrA, SEXP B, const int type_flag)
+{
+    switch(type_flag) {
+        case 4:
+            cpp_gpuMatrix_append_rows<int>(ptrA, B);
+            return;
+        case 6:
+            cpp_gpuMatrix_append_rows<float>(ptrA, B);
+            return;
+        case 8:
+            cpp_gpuMatrix_append_rows<double>(ptrA, B);
+            return;
+        default:
+            throw Rcpp::exception("unknown type detected for gpuMatrix object!");
+    }
+}
+
 /*** gpuVector deepcopy ***/
 // [[Rcpp::export]]
 SEXP
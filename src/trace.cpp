@@ -0,0 +1,70 @@
+#include "gpuR/windows_check.hpp"
+
+// Use OpenCL with ViennaCL
+#define VIENNACL_WITH_OPENCL 1
+
+// ViennaCL headers
+#include "viennacl/ocl/device.hpp"
+#include "viennacl/ocl/platform.hpp"
+#include "viennacl/ocl/backend.hpp"
+
+#include <Rcpp.h>
+
+#include "gpuR/trace_helpers.hpp"
+
+using namespace Rcpp;
+
+
+// [[Rcpp::export]]
+void cpp_trace_start()
+{
+    gpuRTracer().start();
+}
+
+// [[Rcpp::export]]
+SEXP cpp_trace_stop()
+{
+    traceRecorder &rec = gpuRTracer();
+    rec.stop();
+    return wrap(rec.json());
+}
+
+// [[Rcpp::export]]
+bool cpp_trace_enabled()
+{
+    return gpuRTracer().enabled();
+}
+
+// [[Rcpp::export]]
+void cpp_trace_begin(SEXP name)
+{
+    gpuRTracer().beginCall(as<std::string>(name));
+}
+
+// [[Rcpp::export]]
+void cpp_trace_end()
+{
+    traceRecorder &rec = gpuRTracer();
+
+    if(!rec.enabled()) return;
+
+    // wait for the queue of the context the call ended up on so the
+    // work it enqueued is attributed to this call on the device track
+    long id = viennacl::ocl::backend<>::current_context_id();
+    const int tid = GPUR_TRACE_QUEUE + id;
+
+    viennacl::ocl::get_queue().finish();
+    double done = rec.now();
+
+    std::string name;
+    double ts = rec.endCall(name);
+    if(ts < 0) return;
+
+    double qstart = std::max(ts, rec.queueIdleSince(tid));
+
+    std::ostringstream track;
+    track << "queue " << id << " (" << viennacl::ocl::current_device().name() << ")";
+    rec.nameTrack(tid, track.str());
+    rec.record(name, "device", tid, qstart, done - qstart);
+    rec.setQueueIdle(tid, done);
+}
@@ -3,6 +3,8 @@
 
 #include <RcppEigen.h>
 
+#include <limits>
+
 #include "gpuR/dynEigenMat.hpp"
 #include "gpuR/dynEigenVec.hpp"
 
@@ -32,24 +34,22 @@ cpp_gpuVec_size(SEXP ptrA_)
     return pMat->length();
 }
 
+// elements that are not NA (NA_integer_) or NaN
 template <typename T>
-SEXP 
-cpp_gpuMatrix_max(SEXP ptrA_)
-{       
-    XPtr<dynEigenMat<T> > pMat(ptrA_);
-    Eigen::Ref<Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> > refA = pMat->data();
-    
-    Eigen::Map<Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>, 0, Eigen::OuterStride<> > Am(
-        refA.data(), refA.rows(), refA.cols(),
-        Eigen::OuterStride<>(refA.outerStride())
-    );
-    
-    return wrap(Am.maxCoeff());
-}
+struct validElement {
+    bool operator()(const T &v) const { return v == v; }
+};
 
+template <>
+struct validElement<int> {
+    bool operator()(const int &v) const { return v != NA_INTEGER; }
+};
+
+// max/min of a gpuMatrix on the host, in the form of the Summary
+// statistics (see cpp_gpuMatrix_summary) so the R side is shared
 template <typename T>
 SEXP 
-cpp_gpuMatrix_min(SEXP ptrA_)
+cpp_gpuMatrix_extrema(SEXP ptrA_)
 {       
     XPtr<dynEigenMat<T> > pMat(ptrA_);
     Eigen::Ref<Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> > refA = pMat->data();
@@ -59,7 +59,28 @@ cpp_gpuMatrix_min(SEXP ptrA_)
         Eigen::OuterStride<>(refA.outerStride())
     );
     
-    return wrap(Am.minCoeff());
+    const double size = static_cast<double>(Am.size());
+    double n = size;
+    T mn = 0, mx = 0;
+    
+    if(Am.size() > 0){
+        Eigen::Array<bool, Eigen::Dynamic, Eigen::Dynamic> valid = Am.array().unaryExpr(validElement<T>());
+        n = valid.count();
+        
+        if(n == size){
+            mn = Am.minCoeff();
+            mx = Am.maxCoeff();
+        }else if(n > 0){
+            mn = valid.select(Am.array(), std::numeric_limits<T>::max()).minCoeff();
+            mx = valid.select(Am.array(), std::numeric_limits<T>::lowest()).maxCoeff();
+        }
+    }
+    
+    return NumericVector::create(
+        Named("min") = static_cast<double>(mn),
+        Named("max") = static_cast<double>(mx),
+        Named("n") = n,
+        Named("na") = size - n);
 }
 
 //template <typename T>
@@ -154,37 +175,18 @@ cpp_igpuVec_size(SEXP ptrA)
 
 // [[Rcpp::export]]
 SEXP
-cpp_gpuMatrix_max(
-    SEXP ptrA, 
-    const int type_flag)
-{
-    
-    switch(type_flag) {
-        case 4:
-            return cpp_gpuMatrix_max<int>(ptrA);
-        case 6:
-            return cpp_gpuMatrix_max<float>(ptrA);
-        case 8:
-            return cpp_gpuMatrix_max<double>(ptrA);
-        default:
-            throw Rcpp::exception("unknown type detected for gpuMatrix object!");
-    }
-}
-
-// [[Rcpp::export]]
-SEXP
-cpp_gpuMatrix_min(
+cpp_gpuMatrix_extrema(
     SEXP ptrA, 
     const int type_flag)
 {
     
     switch(type_flag) {
         case 4:
-            return cpp_gpuMatrix_min<int>(ptrA);
+            return cpp_gpuMatrix_extrema<int>(ptrA);
         case 6:
-            return cpp_gpuMatrix_min<float>(ptrA);
+            return cpp_gpuMatrix_extrema<float>(ptrA);
         case 8:
-            return cpp_gpuMatrix_min<double>(ptrA);
+            return cpp_gpuMatrix_extrema<double>(ptrA);
         default:
             throw Rcpp::exception("unknown type detected for gpuMatrix object!");
     }
@@ -3,6 +3,9 @@
 //#include "gpuR/vcl_helpers.hpp"
 #include "gpuR/dynVCLMat.hpp"
 #include "gpuR/dynVCLVec.hpp"
+#include "gpuR/trace_helpers.hpp"
+#include "gpuR/vcl_index_kernels.hpp"
+#include "gpuR/vcl_rect_copy.hpp"
 
 using Eigen::MatrixXd;
 using Eigen::MatrixXf;
@@ -48,6 +51,35 @@ cpp_deepcopy_vclVector(SEXP ptrA_)
     return pVec;
 }
 
+// lazy copy of a vclMatrix, see dynVCLMat::share
+template <typename T>
+SEXP
+cpp_share_vclMatrix(SEXP ptrA_)
+{
+    Rcpp::XPtr<dynVCLMat<T> > ptrA(ptrA_);
+    Rcpp::XPtr<dynVCLMat<T> > pMat(ptrA->share());
+    return pMat;
+}
+
+// call before a vclMatrix is written so no lazy copy sees the write
+template <typename T>
+void
+cpp_vclMatrix_detach(SEXP ptrA_)
+{
+    Rcpp::XPtr<dynVCLMat<T> > ptrA(ptrA_);
+    ptrA->detach();
+}
+
+// whether A and B are views of overlapping elements of one buffer
+template <typename T>
+bool
+cpp_vclMatrix_overlap(SEXP ptrA_, SEXP ptrB_)
+{
+    Rcpp::XPtr<dynVCLMat<T> > ptrA(ptrA_);
+    Rcpp::XPtr<dynVCLMat<T> > ptrB(ptrB_);
+    return vcl_overlap<T>(ptrA->data(), ptrB->data());
+}
+
 // slice vclVector
 template <typename T>
 SEXP
@@ -64,58 +96,87 @@ cpp_vclVector_slice(SEXP ptrA_, int start, int end)
     return pOut;
 }
 
-//cbind two vclMatrix objects
+// bind any number of vclMatrix objects by column (byRow false) or by
+// row, the result is allocated once without a zero fill and each input
+// is copied straight into its block
 template <typename T>
 SEXP
-cpp_cbind_vclMatrix(SEXP ptrA_, SEXP ptrB_, int device_flag)
-{        
-    Rcpp::XPtr<dynVCLMat<T> > ptrA(ptrA_);
-    Rcpp::XPtr<dynVCLMat<T> > ptrB(ptrB_);
-    viennacl::matrix_range<viennacl::matrix<T> > pA  = ptrA->data();
-    viennacl::matrix_range<viennacl::matrix<T> > pB  = ptrB->data();
-    
-    viennacl::matrix<T> C(pA.size1(), pA.size2() + pB.size2());
+cpp_bind_vclMatrix(Rcpp::List ptrs, bool byRow, int device_flag)
+{
+    std::vector<viennacl::matrix_range<viennacl::matrix<T> > > blocks;
+    int nr = 0, nc = 0;
     
-    viennacl::matrix_range<viennacl::matrix<T> > C_right(C, viennacl::range(0, pA.size1()), viennacl::range(pA.size2(), pA.size2() + pB.size2()));
-    viennacl::matrix_range<viennacl::matrix<T> > C_left(C, viennacl::range(0, pA.size1()), viennacl::range(0, pA.size2()));
+    for(int i = 0; i < ptrs.size(); i++){
+        Rcpp::XPtr<dynVCLMat<T> > ptrA(ptrs[i]);
+        blocks.push_back(ptrA->data());
+        
+        const int bnr = blocks.back().size1();
+        const int bnc = blocks.back().size2();
+        if(byRow){
+            nr += bnr;
+            nc = bnc;
+        }else{
+            nr = bnr;
+            nc += bnc;
+        }
+    }
     
-    C_right = pB;
-    C_left = pA;
+    dynVCLMat<T> *mat = new dynVCLMat<T>(nr, nc, device_flag, vclUninitialized());
     
-    dynVCLMat<T> *mat = new dynVCLMat<T>(pA.size1(), pA.size2() + pB.size2(), device_flag);
-    mat->setMatrix(C);
-    mat->setDims(pA.size1(), pA.size2() + pB.size2());
-    mat->setRange(0, pA.size1(), 0, pA.size2() + pB.size2());
+    int pos = 0;
+    for(unsigned int i = 0; i < blocks.size(); i++){
+        const int bnr = blocks[i].size1();
+        const int bnc = blocks[i].size2();
+        if(bnr == 0 || bnc == 0){
+            continue;
+        }
+        
+        if(byRow){
+            viennacl::matrix_range<viennacl::matrix<T> > C_block(mat->A, viennacl::range(pos, pos + bnr), viennacl::range(0, nc));
+            C_block = blocks[i];
+            pos += bnr;
+        }else{
+            viennacl::matrix_range<viennacl::matrix<T> > C_block(mat->A, viennacl::range(0, nr), viennacl::range(pos, pos + bnc));
+            C_block = blocks[i];
+            pos += bnc;
+        }
+    }
     
     Rcpp::XPtr<dynVCLMat<T> > pMat(mat);
     return pMat;
 }
 
+//cbind two vclMatrix objects
+template <typename T>
+SEXP
+cpp_cbind_vclMatrix(SEXP ptrA_, SEXP ptrB_, int device_flag)
+{        
+    return cpp_bind_vclMatrix<T>(Rcpp::List::create(ptrA_, ptrB_), false, device_flag);
+}
+
 //rbind two vclMatrix objects
 template <typename T>
 SEXP
 cpp_rbind_vclMatrix(SEXP ptrA_, SEXP ptrB_, int device_flag)
 {        
+    return cpp_bind_vclMatrix<T>(Rcpp::List::create(ptrA_, ptrB_), true, device_flag);
+}
+
+// append rows in place, from an R matrix or from another vclMatrix
+template <typename T>
+void
+cpp_vclMatrix_append_rows(SEXP ptrA_, SEXP B_, bool device)
+{
     Rcpp::XPtr<dynVCLMat<T> > ptrA(ptrA_);
-    Rcpp::XPtr<dynVCLMat<T> > ptrB(ptrB_);
-    viennacl::matrix_range<viennacl::matrix<T> > pA  = ptrA->data();
-    viennacl::matrix_range<viennacl::matrix<T> > pB  = ptrB->data();
-    
-    viennacl::matrix<T> C(pA.size1() + pB.size1(), pA.size2());
+    ptrA->detach();
     
-    viennacl::matrix_range<viennacl::matrix<T> > C_top(C, viennacl::range(0, pA.size1()), viennacl::range(0, pA.size2()));
-    viennacl::matrix_range<viennacl::matrix<T> > C_bottom(C, viennacl::range(pA.size1(), pA.size1() + pB.size1()), viennacl::range(0, pA.size2()));
-    
-    C_top = pA;
-    C_bottom = pB;
-    
-    dynVCLMat<T> *mat = new dynVCLMat<T>(pA.size1() + pB.size1(), pA.size2(), device_flag);
-    mat->setMatrix(C);
-    mat->setDims(pA.size1() + pB.size1(), pA.size2());
-    mat->setRange(0, pA.size1() + pB.size1(), 0, pA.size2());
-    
-    Rcpp::XPtr<dynVCLMat<T> > pMat(mat);
-    return pMat;
+    if(device){
+        Rcpp::XPtr<dynVCLMat<T> > ptrB(B_);
+        ptrA->append_rows(ptrB->data());
+    }else{
+        Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> B = Rcpp::as<Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> >(B_);
+        ptrA->append_rows(B);
+    }
 }
 
 template <typename T>
@@ -149,6 +210,7 @@ VCLtoVecSEXP(SEXP A_)
     
     Eigen::Matrix<T, Eigen::Dynamic, 1> Am(M);
     
+    traceScope span("VCLtoVecSEXP", (double)M * sizeof(T));
     viennacl::copy(pA, Am); 
     
     return Am;
@@ -212,13 +274,38 @@ VCLtoSEXP(SEXP A)
 //    int nr = pA->size1();
 //    int nc = pA->size2();
     
-    viennacl::matrix<T> pA = static_cast<viennacl::matrix<T> >(tempA);
-    int nr = pA.size1();
-    int nc = pA.size2();
+    int nr = tempA.size1();
+    int nc = tempA.size2();
     
     Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> Am(nr, nc);
     
-    viennacl::copy(pA, Am); 
+    // read the block straight from the parent matrix, no device copy
+    traceScope span("VCLtoSEXP", (double)nr * nc * sizeof(T));
+    vcl_read_block(tempA, Am.data(), nr); 
+    
+    return Am;
+}
+
+// read a vclMatrix into a new R matrix, straight into R's memory when R
+// stores T as is
+template <typename T>
+SEXP
+VCLtoMatSEXP(SEXP A)
+{
+    if(!vclRStorage<T>::direct){
+        return wrap(VCLtoSEXP<T>(A));
+    }
+    
+    Rcpp::XPtr<dynVCLMat<T> > ptrA(A);
+    viennacl::matrix_range<viennacl::matrix<T> > tempA  = ptrA->data();
+    
+    int nr = tempA.size1();
+    int nc = tempA.size2();
+    
+    Rcpp::Shield<SEXP> Am(Rf_allocMatrix(vclRStorage<T>::rtype, nr, nc));
+    
+    traceScope span("VCLtoSEXP", (double)nr * nc * sizeof(T));
+    vcl_read_block(tempA, reinterpret_cast<T *>(Rcpp::internal::r_vector_start<vclRStorage<T>::rtype>(Am)), nr);
     
     return Am;
 }
@@ -228,14 +315,7 @@ template <typename T>
 SEXP 
 vectorToMatVCL(SEXP A, const int nr, const int nc, int device_flag)
 {
-    Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> Am;
-    Am = Rcpp::as<Eigen::Matrix<T, Eigen::Dynamic, 1> >(A);
-//    Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> temp = as<Eigen::Matrix<T, Eigen::Dynamic, 1> >(A);
-    Am.resize(nr, nc);
-    
-//    Eigen::Map<Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> > Amm(&Am(0), nr, nc);
-    
-    dynVCLMat<T> *mat = new dynVCLMat<T>(Am, nr, nc, device_flag);
+    dynVCLMat<T> *mat = new dynVCLMat<T>(A, nr, nc, device_flag);
     Rcpp::XPtr<dynVCLMat<T> > pMat(mat);
     return pMat;    
     
@@ -307,21 +387,10 @@ vclSetCol(SEXP data, SEXP newdata, const int nc)
     Rcpp::XPtr<dynVCLMat<T> > pMat(data);
     viennacl::matrix_range<viennacl::matrix<T> > A  = pMat->data();
     
-    Eigen::Matrix<T, Eigen::Dynamic, 1> Am;
-    Am = Rcpp::as<Eigen::Matrix<T, Eigen::Dynamic, 1> >(newdata);
-    
-    for(unsigned int i = 0; i < A.size1(); i++){
-        A(i, nc-1) = Am(i);
-    } 
+    std::vector<T> Am = Rcpp::as<std::vector<T> >(newdata);
     
-//    Rcpp::XPtr<viennacl::matrix<T> > pA(data);
-//    viennacl::matrix<T> &A = *pA;
-//    Eigen::Matrix<T, Eigen::Dynamic, 1> Am;
-//    Am = Rcpp::as<Eigen::Matrix<T, Eigen::Dynamic, 1> >(newdata);
-//    
-//    for(unsigned int i = 0; i < A.size1(); i++){
-//        A(i, nc-1) = Am(i);
-//    } 
+    // one upload and one kernel instead of a transfer per element
+    vcl_set_col<T>(A, nc-1, Am);
 }
 
 // update viennacl row elements
@@ -331,21 +400,10 @@ vclSetRow(SEXP data, SEXP newdata, const int nr)
 {
     Rcpp::XPtr<dynVCLMat<T> > pMat(data);
     viennacl::matrix_range<viennacl::matrix<T> > A  = pMat->data();
-    Eigen::Matrix<T, Eigen::Dynamic, 1> Am;
-    Am = Rcpp::as<Eigen::Matrix<T, Eigen::Dynamic, 1> >(newdata);
     
-    for(unsigned int i = 0; i < A.size2(); i++){
-        A(nr-1, i) = Am(i);
-    } 
+    std::vector<T> Am = Rcpp::as<std::vector<T> >(newdata);
     
-//    Rcpp::XPtr<viennacl::matrix<T> > pA(data);
-//    viennacl::matrix<T> &A = *pA;
-//    Eigen::Matrix<T, Eigen::Dynamic, 1> Am;
-//    Am = Rcpp::as<Eigen::Matrix<T, Eigen::Dynamic, 1> >(newdata);
-//    
-//    for(unsigned int i = 0; i < A.size2(); i++){
-//        A(nr-1, i) = Am(i);
-//    } 
+    vcl_set_row<T>(A, nr-1, Am);
 }
 
 // update viennacl element
@@ -420,6 +478,95 @@ vclGetElement(SEXP &data, const int &nr, const int &nc)
 }
 
 
+/*** vclMatrix/vclVector indexed access ***/
+
+// zero based device indices from R's one based indices
+inline
+std::vector<cl_uint>
+vclIndex(SEXP idx_)
+{
+    Rcpp::IntegerVector idx(idx_);
+    std::vector<cl_uint> out(idx.size());
+    
+    for(int i = 0; i < idx.size(); i++){
+        out[i] = static_cast<cl_uint>(idx[i] - 1);
+    }
+    return out;
+}
+
+// A[rows, cols] as a column-major vector
+template <typename T>
+std::vector<T>
+vclGather(SEXP data, SEXP rows, SEXP cols)
+{
+    Rcpp::XPtr<dynVCLMat<T> > pMat(data);
+    viennacl::matrix_range<viennacl::matrix<T> > A  = pMat->data();
+    
+    std::vector<T> out;
+    vcl_gather<T>(A, vclIndex(rows), vclIndex(cols), out);
+    return out;
+}
+
+// A[rows, cols] <- newdata
+template <typename T>
+void
+vclScatter(SEXP data, SEXP rows, SEXP cols, SEXP newdata)
+{
+    Rcpp::XPtr<dynVCLMat<T> > pMat(data);
+    viennacl::matrix_range<viennacl::matrix<T> > A  = pMat->data();
+    
+    vcl_scatter<T>(A, vclIndex(rows), vclIndex(cols), Rcpp::as<std::vector<T> >(newdata));
+}
+
+// A[idx] with column-major linear indices
+template <typename T>
+std::vector<T>
+vclGatherIndex(SEXP data, SEXP idx)
+{
+    Rcpp::XPtr<dynVCLMat<T> > pMat(data);
+    viennacl::matrix_range<viennacl::matrix<T> > A  = pMat->data();
+    
+    std::vector<T> out;
+    vcl_gather_index<T>(A, vclIndex(idx), out);
+    return out;
+}
+
+// A[idx] <- newdata with column-major linear indices
+template <typename T>
+void
+vclScatterIndex(SEXP data, SEXP idx, SEXP newdata)
+{
+    Rcpp::XPtr<dynVCLMat<T> > pMat(data);
+    viennacl::matrix_range<viennacl::matrix<T> > A  = pMat->data();
+    
+    vcl_scatter_index<T>(A, vclIndex(idx), Rcpp::as<std::vector<T> >(newdata));
+}
+
+// v[idx]
+template <typename T>
+std::vector<T>
+vclVecGather(SEXP data, SEXP idx)
+{
+    Rcpp::XPtr<dynVCLVec<T> > pVec(data);
+    viennacl::vector_range<viennacl::vector<T> > A  = pVec->data();
+    
+    std::vector<T> out;
+    vcl_vec_gather<T>(A, vclIndex(idx), out);
+    return out;
+}
+
+// v[idx] <- newdata
+template <typename T>
+void
+vclVecScatter(SEXP data, SEXP idx, SEXP newdata)
+{
+    Rcpp::XPtr<dynVCLVec<T> > pVec(data);
+    viennacl::vector_range<viennacl::vector<T> > A  = pVec->data();
+    
+    vcl_vec_scatter<T>(A, vclIndex(idx), Rcpp::as<std::vector<T> >(newdata));
+}
+
+
 /*** vclMatrix deepcopy ***/
 // [[Rcpp::export]]
 SEXP
@@ -437,6 +584,58 @@ cpp_deepcopy_vclMatrix(SEXP ptrA, const int type_flag)
     }
 }
 
+/*** vclMatrix lazy deepcopy ***/
+// [[Rcpp::export]]
+SEXP
+cpp_share_vclMatrix(SEXP ptrA, const int type_flag)
+{
+    switch(type_flag) {
+        case 4:
+            return cpp_share_vclMatrix<int>(ptrA);
+        case 6:
+            return cpp_share_vclMatrix<float>(ptrA);
+        case 8:
+            return cpp_share_vclMatrix<double>(ptrA);
+        default:
+            throw Rcpp::exception("unknown type detected for vclMatrix object!");
+    }
+}
+
+// [[Rcpp::export]]
+void
+cpp_vclMatrix_detach(SEXP ptrA, const int type_flag)
+{
+    switch(type_flag) {
+        case 4:
+            cpp_vclMatrix_detach<int>(ptrA);
+            return;
+        case 6:
+            cpp_vclMatrix_detach<float>(ptrA);
+            return;
+        case 8:
+            cpp_vclMatrix_detach<double>(ptrA);
+            return;
+        default:
+            throw Rcpp::exception("unknown type detected for vclMatrix object!");
+    }
+}
+
+// [[Rcpp::export]]
+bool
+cpp_vclMatrix_overlap(SEXP ptrA, SEXP ptrB, const int type_flag)
+{
+    switch(type_flag) {
+        case 4:
+            return cpp_vclMatrix_overlap<int>(ptrA, ptrB);
+        case 6:
+            return cpp_vclMatrix_overlap<float>(ptrA, ptrB);
+        case 8:
+            return cpp_vclMatrix_overlap<double>(ptrA, ptrB);
+        default:
+            throw Rcpp::exception("unknown type detected for vclMatrix object!");
+    }
+}
+
 /*** vclVector deepcopy ***/
 // [[Rcpp::export]]
 SEXP
@@ -493,6 +692,27 @@ cpp_vclMatrix_block(
     }
 }
 
+/*** vclMatrix n-ary cbind/rbind ***/
+// [[Rcpp::export]]
+SEXP
+cpp_bind_vclMatrix(
+    Rcpp::List ptrs,
+    bool byRow,
+    int type_flag,
+    int device_flag)
+{    
+    switch(type_flag) {
+        case 4:
+            return cpp_bind_vclMatrix<int>(ptrs, byRow, device_flag);
+        case 6:
+            return cpp_bind_vclMatrix<float>(ptrs, byRow, device_flag);
+        case 8:
+            return cpp_bind_vclMatrix<double>(ptrs, byRow, device_flag);
+        default:
+            throw Rcpp::exception("unknown type detected for vclMatrix object!");
+    }
+}
+
 /*** vclMatrix cbind ***/
 // [[Rcpp::export]]
 SEXP
@@ -535,6 +755,30 @@ cpp_rbind_vclMatrix(
     }
 }
 
+/*** vclMatrix append rows ***/
+// [[Rcpp::export]]
+void
+cpp_vclMatrix_append_rows(
+    SEXP ptrA, 
+    SEXP B,
+    bool device,
+    int type_flag)
+{    
+    switch(type_flag) {
+        case 4:
+            cpp_vclMatrix_append_rows<int>(ptrA, B, device);
+            return;
+        case 6:
+            cpp_vclMatrix_append_rows<float>(ptrA, B, device);
+            return;
+        case 8:
+            cpp_vclMatrix_append_rows<double>(ptrA, B, device);
+            return;
+        default:
+            throw Rcpp::exception("unknown type detected for vclMatrix object!");
+    }
+}
+
 /*** matrix imports ***/
 
 // [[Rcpp::export]]
@@ -562,11 +806,11 @@ VCLtoMatSEXP(SEXP ptrA, const int type_flag)
 {
     switch(type_flag) {
         case 4:
-            return wrap(VCLtoSEXP<int>(ptrA));
+            return VCLtoMatSEXP<int>(ptrA);
         case 6:
-            return wrap(VCLtoSEXP<float>(ptrA));
+            return VCLtoMatSEXP<float>(ptrA);
         case 8:
-            return wrap(VCLtoSEXP<double>(ptrA));
+            return VCLtoMatSEXP<double>(ptrA);
         default:
             throw Rcpp::exception("unknown type detected for vclMatrix object!");
     }
@@ -757,6 +1001,113 @@ vclVecSetElement(SEXP ptrA, const int idx, SEXP newdata, const int type_flag)
     }
 }
 
+/*** indexed access ***/
+
+// [[Rcpp::export]]
+SEXP
+cpp_vclMatrix_gather(SEXP ptrA, SEXP rows, SEXP cols, const int type_flag)
+{
+    switch(type_flag) {
+        case 4:
+            return wrap(vclGather<int>(ptrA, rows, cols));
+        case 6:
+            return wrap(vclGather<float>(ptrA, rows, cols));
+        case 8:
+            return wrap(vclGather<double>(ptrA, rows, cols));
+        default:
+            throw Rcpp::exception("unknown type detected for vclMatrix object!");
+    }
+}
+
+// [[Rcpp::export]]
+void
+cpp_vclMatrix_scatter(SEXP ptrA, SEXP rows, SEXP cols, SEXP newdata, const int type_flag)
+{
+    switch(type_flag) {
+        case 4:
+            vclScatter<int>(ptrA, rows, cols, newdata);
+            return;
+        case 6:
+            vclScatter<float>(ptrA, rows, cols, newdata);
+            return;
+        case 8:
+            vclScatter<double>(ptrA, rows, cols, newdata);
+            return;
+        default:
+            throw Rcpp::exception("unknown type detected for vclMatrix object!");
+    }
+}
+
+// [[Rcpp::export]]
+SEXP
+cpp_vclMatrix_gather_index(SEXP ptrA, SEXP idx, const int type_flag)
+{
+    switch(type_flag) {
+        case 4:
+            return wrap(vclGatherIndex<int>(ptrA, idx));
+        case 6:
+            return wrap(vclGatherIndex<float>(ptrA, idx));
+        case 8:
+            return wrap(vclGatherIndex<double>(ptrA, idx));
+        default:
+            throw Rcpp::exception("unknown type detected for vclMatrix object!");
+    }
+}
+
+// [[Rcpp::export]]
+void
+cpp_vclMatrix_scatter_index(SEXP ptrA, SEXP idx, SEXP newdata, const int type_flag)
+{
+    switch(type_flag) {
+        case 4:
+            vclScatterIndex<int>(ptrA, idx, newdata);
+            return;
+        case 6:
+            vclScatterIndex<float>(ptrA, idx, newdata);
+            return;
+        case 8:
+            vclScatterIndex<double>(ptrA, idx, newdata);
+            return;
+        default:
+            throw Rcpp::exception("unknown type detected for vclMatrix object!");
+    }
+}
+
+// [[Rcpp::export]]
+SEXP
+cpp_vclVector_gather(SEXP ptrA, SEXP idx, const int type_flag)
+{
+    switch(type_flag) {
+        case 4:
+            return wrap(vclVecGather<int>(ptrA, idx));
+        case 6:
+            return wrap(vclVecGather<float>(ptrA, idx));
+        case 8:
+            return wrap(vclVecGather<double>(ptrA, idx));
+        default:
+            throw Rcpp::exception("unknown type detected for vclVector object!");
+    }
+}
+
+// [[Rcpp::export]]
+void
+cpp_vclVector_scatter(SEXP ptrA, SEXP idx, SEXP newdata, const int type_flag)
+{
+    switch(type_flag) {
+        case 4:
+            vclVecScatter<int>(ptrA, idx, newdata);
+            return;
+        case 6:
+            vclVecScatter<float>(ptrA, idx, newdata);
+            return;
+        case 8:
+            vclVecScatter<double>(ptrA, idx, newdata);
+            return;
+        default:
+            throw Rcpp::exception("unknown type detected for vclVector object!");
+    }
+}
+
 /*** vector imports ***/
 
 // [[Rcpp::export]]
@@ -8,6 +8,8 @@
 #include "gpuR/dynEigenVec.hpp"
 #include "gpuR/dynVCLMat.hpp"
 #include "gpuR/dynVCLVec.hpp"
+#include "gpuR/vcl_blas_helpers.hpp"
+#include "gpuR/vcl_reduce_kernels.hpp"
 
 // Use OpenCL with ViennaCL
 #define VIENNACL_WITH_OPENCL 1
@@ -28,6 +30,23 @@ using namespace Rcpp;
 
 /*** templates ***/
 
+// Summary group statistics as a named vector for R
+template <typename T>
+Rcpp::NumericVector
+summaryToSEXP(vclSummary<T> &res)
+{
+    Rcpp::NumericVector out = Rcpp::NumericVector::create(
+        Rcpp::Named("sum") = res.sum,
+        Rcpp::Named("prod") = res.prod,
+        Rcpp::Named("min") = static_cast<double>(res.min),
+        Rcpp::Named("max") = static_cast<double>(res.max),
+        Rcpp::Named("n") = res.n,
+        Rcpp::Named("na") = res.na,
+        Rcpp::Named("nonzero") = res.nonzero);
+    
+    return out;
+}
+
 
 /*** gpuVector Templates ***/
 
@@ -97,13 +116,12 @@ cpp_gpuVector_unary_axpy(
     const int M = Am.size();
     
     viennacl::vector<T> vcl_A(M);
-    viennacl::vector<T> vcl_Z = viennacl::zero_vector<T>(M);
     
     viennacl::copy(Am, vcl_A); 
     
-    vcl_Z -= vcl_A;
+    vcl_A *= T(-1);
 
-    viennacl::copy(vcl_Z, Am);
+    viennacl::copy(vcl_A, Am);
 }
 
 
@@ -1093,15 +1111,11 @@ cpp_gpuMatrix_unary_axpy(
     
     XPtr<dynEigenMat<T> > ptrA(ptrA_);
     
-    const int M = ptrA->nrow();
-    const int K = ptrA->ncol();
-    
     viennacl::matrix<T> vcl_A = ptrA->device_data();
-    viennacl::matrix<T> vcl_Z = viennacl::zero_matrix<T>(M,K);
     
-    vcl_Z -= vcl_A;
+    vcl_A *= T(-1);
 
-    ptrA->to_host(vcl_Z);
+    ptrA->to_host(vcl_A);
 }
 
 template <typename T>
@@ -1781,8 +1795,59 @@ void cpp_gpuMatrix_elem_abs(
     ptrB->to_host(vcl_B);
 }
 
+template <typename T>
+Rcpp::NumericVector
+cpp_gpuMatrix_summary(
+    SEXP ptrA_,
+    int device_flag)
+{
+    // define device type to use
+    if(device_flag == 0){
+        //use only GPUs
+        long id = 0;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::gpu_tag());
+        viennacl::ocl::switch_context(id);
+    }else{
+        // use only CPUs
+        long id = 1;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::cpu_tag());
+        viennacl::ocl::switch_context(id);
+    }
+    
+    vclSummary<T> res;
+    
+    XPtr<dynEigenMat<T> > ptrA(ptrA_);
+    
+    viennacl::matrix<T> vcl_A = ptrA->device_data();
+    
+    // every statistic from a single pass over the matrix
+    vcl_summary<T>(vcl_A, res);
+    
+    return summaryToSEXP<T>(res);
+}
+
 /*** gpuMatrix Functions ***/
 
+// [[Rcpp::export]]
+SEXP
+cpp_gpuMatrix_summary(
+    SEXP ptrA,
+    int device_flag,
+    const int type_flag)
+{
+    
+    switch(type_flag) {
+        case 4:
+            return cpp_gpuMatrix_summary<int>(ptrA, device_flag);
+        case 6:
+            return cpp_gpuMatrix_summary<float>(ptrA, device_flag);
+        case 8:
+            return cpp_gpuMatrix_summary<double>(ptrA, device_flag);
+        default:
+            throw Rcpp::exception("unknown type detected for gpuMatrix object!");
+    }
+}
+
 // [[Rcpp::export]]
 void
 cpp_gpuMatrix_elem_prod(
@@ -2351,10 +2416,8 @@ cpp_vclVector_unary_axpy(
     Rcpp::XPtr<dynVCLVec<T> > pA(ptrA_);
     viennacl::vector_range<viennacl::vector<T> > vcl_A  = pA->data();
     
-    viennacl::vector<T> vcl_Z = viennacl::zero_vector<T>(vcl_A.size());
-    
-    vcl_Z -= vcl_A;
-    vcl_A = vcl_Z;
+    // sign flip in a single pass, no temporary
+    vcl_A *= T(-1);
 }
 
 template <typename T>
@@ -3108,7 +3171,7 @@ void cpp_vclMatrix_axpy(
     viennacl::matrix_range<viennacl::matrix<T> > A  = ptrA->data();
     viennacl::matrix_range<viennacl::matrix<T> > B  = ptrB->data();
     
-    B += alpha * (A);
+    vcl_axpy<T>(alpha, A, B);
 }
 
 template <typename T>
@@ -3134,10 +3197,8 @@ cpp_vclMatrix_unary_axpy(
     viennacl::matrix_range<viennacl::matrix<T> > vcl_A  = ptrA->data();
     
     
-    viennacl::matrix<T> vcl_Z = viennacl::zero_matrix<T>(vcl_A.size1(),vcl_A.size2());
-    
-    vcl_Z -= vcl_A;
-    vcl_A = vcl_Z;
+    // sign flip in a single pass, no temporary
+    vcl_A *= T(-1);
 }
 
 
@@ -3169,7 +3230,7 @@ void cpp_vclMatrix_elem_prod(
     viennacl::matrix_range<viennacl::matrix<T> > B  = ptrB->data();
     viennacl::matrix_range<viennacl::matrix<T> > C  = ptrC->data();
 
-    C = viennacl::linalg::element_prod(A, B);
+    vcl_elem_prod<T>(A, B, C);
 }
 
 template <typename T>
@@ -3745,8 +3806,8 @@ void cpp_vclMatrix_elem_abs(
 }
 
 template <typename T>
-T
-cpp_vclMatrix_max(
+Rcpp::NumericVector
+cpp_vclMatrix_summary(
     SEXP ptrA_,
     int device_flag)
 {    
@@ -3763,26 +3824,55 @@ cpp_vclMatrix_max(
         viennacl::ocl::switch_context(id);
     }
     
-    T max_out;
+    vclSummary<T> res;
     
     Rcpp::XPtr<dynVCLMat<T> > pA(ptrA_);
     viennacl::matrix_range<viennacl::matrix<T> > vcl_A  = pA->data();
     
-    // iterate over columns
-    Rcpp::NumericVector max_vec(vcl_A.size2());
+    // every statistic from a single pass over the matrix
+    vcl_summary<T>(vcl_A, res);
     
-    for(unsigned int i=0; i<vcl_A.size2(); i++){
-        max_vec[i] = viennacl::linalg::max(viennacl::column(vcl_A, i));
+    return summaryToSEXP<T>(res);
+}
+
+template <typename T>
+int
+cpp_vclMatrix_which_max(
+    SEXP ptrA_,
+    int device_flag)
+{    
+    // define device type to use
+    if(device_flag == 0){
+        //use only GPUs
+        long id = 0;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::gpu_tag());
+        viennacl::ocl::switch_context(id);
+    }else{
+        // use only CPUs
+        long id = 1;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::cpu_tag());
+        viennacl::ocl::switch_context(id);
     }
     
-    max_out = max(max_vec);
+    T max_out;
+    unsigned int index;
+    
+    Rcpp::XPtr<dynVCLMat<T> > pA(ptrA_);
+    viennacl::matrix_range<viennacl::matrix<T> > vcl_A  = pA->data();
+    
+    // NA/NaN are skipped as in base::which.max
+    vcl_arg_reduce<T>(vcl_A, GPUR_REDUCE_MAX | GPUR_REDUCE_SKIP_NA, max_out, index);
     
-    return max_out;
+    if(index == GPUR_REDUCE_EMPTY){
+        return NA_INTEGER;
+    }
+    
+    return index + 1;
 }
 
 template <typename T>
-T
-cpp_vclMatrix_min(
+int
+cpp_vclMatrix_which_min(
     SEXP ptrA_,
     int device_flag)
 {    
@@ -3800,20 +3890,19 @@ cpp_vclMatrix_min(
     }
     
     T min_out;
+    unsigned int index;
     
     Rcpp::XPtr<dynVCLMat<T> > pA(ptrA_);
     viennacl::matrix_range<viennacl::matrix<T> > vcl_A  = pA->data();
     
-    // iterate over columns
-    Rcpp::NumericVector min_vec(vcl_A.size2());
+    // NA/NaN are skipped as in base::which.min
+    vcl_arg_reduce<T>(vcl_A, 0 | GPUR_REDUCE_SKIP_NA, min_out, index);
     
-    for(unsigned int i=0; i<vcl_A.size2(); i++){
-        min_vec[i] = viennacl::linalg::min(viennacl::column(vcl_A, i));
+    if(index == GPUR_REDUCE_EMPTY){
+        return NA_INTEGER;
     }
     
-    min_out = min(min_vec);
-    
-    return min_out;
+    return index + 1;
 }
 
 /*** vclMatrix Functions ***/
@@ -4323,7 +4412,7 @@ void cpp_vclMatrix_elem_abs(
 
 // [[Rcpp::export]]
 SEXP
-cpp_vclMatrix_max(
+cpp_vclMatrix_summary(
     SEXP ptrA,
     int device_flag,
     const int type_flag)
@@ -4331,19 +4420,19 @@ cpp_vclMatrix_max(
     
     switch(type_flag) {
         case 4:
-            return wrap(cpp_vclMatrix_max<int>(ptrA, device_flag));
+            return cpp_vclMatrix_summary<int>(ptrA, device_flag);
         case 6:
-            return wrap(cpp_vclMatrix_max<float>(ptrA, device_flag));
+            return cpp_vclMatrix_summary<float>(ptrA, device_flag);
         case 8:
-            return wrap(cpp_vclMatrix_max<double>(ptrA, device_flag));
+            return cpp_vclMatrix_summary<double>(ptrA, device_flag);
         default:
-            throw Rcpp::exception("unknown type detected for vclVector object!");
+            throw Rcpp::exception("unknown type detected for vclMatrix object!");
     }
 }
 
 // [[Rcpp::export]]
 SEXP
-cpp_vclMatrix_min(
+cpp_vclMatrix_which_max(
     SEXP ptrA,
     int device_flag,
     const int type_flag)
@@ -4351,13 +4440,33 @@ cpp_vclMatrix_min(
     
     switch(type_flag) {
         case 4:
-            return wrap(cpp_vclMatrix_min<int>(ptrA, device_flag));
+            return wrap(cpp_vclMatrix_which_max<int>(ptrA, device_flag));
         case 6:
-            return wrap(cpp_vclMatrix_min<float>(ptrA, device_flag));
+            return wrap(cpp_vclMatrix_which_max<float>(ptrA, device_flag));
         case 8:
-            return wrap(cpp_vclMatrix_min<double>(ptrA, device_flag));
+            return wrap(cpp_vclMatrix_which_max<double>(ptrA, device_flag));
         default:
-            throw Rcpp::exception("unknown type detected for vclVector object!");
+            throw Rcpp::exception("unknown type detected for vclMatrix object!");
+    }
+}
+
+// [[Rcpp::export]]
+SEXP
+cpp_vclMatrix_which_min(
+    SEXP ptrA,
+    int device_flag,
+    const int type_flag)
+{
+    
+    switch(type_flag) {
+        case 4:
+            return wrap(cpp_vclMatrix_which_min<int>(ptrA, device_flag));
+        case 6:
+            return wrap(cpp_vclMatrix_which_min<float>(ptrA, device_flag));
+        case 8:
+            return wrap(cpp_vclMatrix_which_min<double>(ptrA, device_flag));
+        default:
+            throw Rcpp::exception("unknown type detected for vclMatrix object!");
     }
 }
 
@@ -7,6 +7,7 @@
 
 #include "gpuR/dynEigenMat.hpp"
 #include "gpuR/dynVCLMat.hpp"
+#include "gpuR/vcl_blas_helpers.hpp"
 
 // Use OpenCL with ViennaCL
 #define VIENNACL_WITH_OPENCL 1
@@ -297,7 +298,7 @@ void cpp_vclMatrix_gemm(
     viennacl::matrix_range<viennacl::matrix<T> > B = ptrB->data();
     viennacl::matrix_range<viennacl::matrix<T> > C = ptrC->data();
 
-    C = viennacl::linalg::prod(A, B);
+    vcl_gemm<T>(A, B, C);
 }
 
 template <typename T>
@@ -1,4 +1,3 @@
-
 // eigen headers for handling the R input data
 #include <RcppEigen.h>
 
@@ -19,14 +18,67 @@
 #include "viennacl/linalg/prod.hpp"
 #include "viennacl/linalg/qr-method.hpp"
 
+// values only reduction and the device sort
+#include "gpuR/vcl_tridiag.hpp"
+
 using namespace Rcpp;
 
+// unsorted eigenvalues of A into vcl_D, A is destroyed.  The eigenvectors
+// go to vcl_Q unless it is NULL, otherwise they are never formed.
+template <typename T>
+static void
+vcl_eigen(
+    viennacl::matrix<T> &vcl_A, 
+    viennacl::matrix<T> *vcl_Q,
+    viennacl::vector<T> &vcl_D,
+    bool symmetric)
+{
+    const size_t n = vcl_A.size1();
+    
+    if(vcl_Q){
+        std::vector<T> D(n);
+        std::vector<T> E(n);
+        
+        viennacl::linalg::detail::qr_method(vcl_A, *vcl_Q, D, E, symmetric);
+        
+        viennacl::copy(D, vcl_D);
+    }else{
+        std::vector<double> d, e;
+        
+        vcl_tridiagonalize(vcl_A, d, e);
+        if(!tridiag_ql_values(d, e)){
+            throw Rcpp::exception("eigenvalues did not converge");
+        }
+        
+        std::vector<T> D(d.begin(), d.end());
+        viennacl::copy(D, vcl_D);
+    }
+}
+
+// values <- vcl_D sorted decreasingly, order <- the permutation
+template <typename T, typename VecV>
+static void
+vcl_eigen_sort(
+    viennacl::vector<T> &vcl_D, 
+    VecV &vcl_values,
+    viennacl::backend::mem_handle &order)
+{
+    const vclLayout ld = vcl_vector_layout(vcl_D);
+    
+    vcl_sort_order<T>(vcl_D.handle().opencl_handle(), ld, order);
+    vcl_gather_cols<T>(vcl_D.handle().opencl_handle(), vcl_row_layout(ld),
+                       vcl_values.handle().opencl_handle(), 
+                       vcl_row_layout(vcl_vector_layout(vcl_values)),
+                       order);
+}
+
 template <typename T>
 void cpp_gpu_eigen(
     SEXP &Am, 
     SEXP &Qm,
     SEXP &eigenvalues,
     bool symmetric,
+    bool only_values,
     int device_flag)
 {    
     // define device type to use
@@ -43,31 +95,36 @@ void cpp_gpu_eigen(
     }
     
     Rcpp::XPtr<dynEigenVec<T> > ptreigenvalues(eigenvalues);
-    
-//    Eigen::Map<Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> > eigen_A = *ptrA;
-//    Eigen::Map<Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> > &eigen_Q = *ptrQ;
-//    Eigen::Map<Eigen::Matrix<T, Eigen::Dynamic, 1> > &eigen_eigenvalues = *ptreigenvalues;
     Eigen::Map<Eigen::Matrix<T, Eigen::Dynamic, 1> > eigen_eigenvalues = ptreigenvalues->data();
     
-    
     XPtr<dynEigenMat<T> > ptrA(Am);
-    XPtr<dynEigenMat<T> > ptrQ(Qm);
     
     const int K = ptrA->nrow();
     
     viennacl::matrix<T> vcl_A = ptrA->device_data();
-    viennacl::matrix<T> vcl_Q = ptrQ->device_data();
+    viennacl::vector<T> vcl_D(K);
     viennacl::vector<T> vcl_eigenvalues(K);
-
-    //temp D
-    std::vector<T> D(vcl_eigenvalues.size());
-    std::vector<T> E(vcl_A.size1());
+    viennacl::backend::mem_handle order;
     
-    viennacl::linalg::detail::qr_method(vcl_A, vcl_Q, D, E, symmetric);
-    
-    ptrQ->to_host(vcl_Q);
+    if(only_values){
+        vcl_eigen<T>(vcl_A, NULL, vcl_D, symmetric);
+        vcl_eigen_sort<T>(vcl_D, vcl_eigenvalues, order);
+    }else{
+        XPtr<dynEigenMat<T> > ptrQ(Qm);
+        
+        viennacl::matrix<T> vcl_V(K, K);
+        viennacl::matrix<T> vcl_Q(K, K);
+        
+        vcl_eigen<T>(vcl_A, &vcl_V, vcl_D, symmetric);
+        vcl_eigen_sort<T>(vcl_D, vcl_eigenvalues, order);
+        vcl_gather_cols<T>(vcl_V.handle().opencl_handle(), vcl_matrix_layout(vcl_V),
+                           vcl_Q.handle().opencl_handle(), vcl_matrix_layout(vcl_Q),
+                           order);
+        
+        ptrQ->to_host(vcl_Q);
+    }
     
-    std::copy(D.begin(), D.end(), &eigen_eigenvalues(0));
+    viennacl::fast_copy(vcl_eigenvalues.begin(), vcl_eigenvalues.end(), &eigen_eigenvalues(0));
 }
 
 template <typename T>
@@ -76,6 +133,7 @@ void cpp_vcl_eigen(
     SEXP &Qm,
     SEXP &eigenvalues,
     bool symmetric,
+    bool only_values,
     int device_flag)
 {    
     // define device type to use
@@ -91,44 +149,35 @@ void cpp_vcl_eigen(
         viennacl::ocl::switch_context(id);
     }
     
-    
     Rcpp::XPtr<dynVCLMat<T> > ptrA(Am);
-    Rcpp::XPtr<dynVCLMat<T> > ptrQ(Qm);
-    
-//    viennacl::matrix_range<viennacl::matrix<T> > vcl_A = ptrA->data();
-//    viennacl::matrix<T> vcl_A = static_cast<viennacl::matrix<T> >(A);
-    
-//    viennacl::matrix_range<viennacl::matrix<T> > vcl_Q = ptrQ->data();
-
-    // want copy of A to prevent overwriting original matrix
-    viennacl::matrix<T> vcl_A = ptrA->matrix();
-    // Q were are overwriting so get pointer
-    viennacl::matrix<T> *vcl_Q = ptrQ->getPtr();
-
-//    viennacl::matrix<T> vcl_A = ptrA->matrix();
-//    viennacl::matrix<T> vcl_Q = ptrQ->matrix();
     
-    // need to find some way to cast without a copy
+    // the reduction overwrites its input, copy only the live rows as the
+    // storage may hold spare capacity
+    viennacl::matrix<T> vcl_A(ptrA->data());
     
-//    viennacl::matrix<T> &vcl_Q = static_cast<viennacl::matrix<T>& >(*Q);
-    
-//    Rcpp::XPtr<viennacl::vector<T> > ptreigenvalues(eigenvalues);
+    const int K = vcl_A.size1();
     
     Rcpp::XPtr<dynVCLVec<T> > ptreigenvalues(eigenvalues);
     viennacl::vector_range<viennacl::vector<T> > vcl_eigenvalues  = ptreigenvalues->data();
     
-//    viennacl::matrix<T> vcl_A = *ptrA;
-//    viennacl::matrix<T> &vcl_Q = *ptrQ;
-//    viennacl::vector<T> &vcl_eigenvalues = *ptreigenvalues;
-
-    //temp D
-    std::vector<T> D(vcl_eigenvalues.size());
-    std::vector<T> E(vcl_A.size1());
-    
-    viennacl::linalg::detail::qr_method(vcl_A, *vcl_Q, D, E, symmetric);
+    viennacl::vector<T> vcl_D(K);
+    viennacl::backend::mem_handle order;
     
-    // copy D into eigenvalues
-    viennacl::copy(D, vcl_eigenvalues);
+    if(only_values){
+        vcl_eigen<T>(vcl_A, NULL, vcl_D, symmetric);
+        vcl_eigen_sort<T>(vcl_D, vcl_eigenvalues, order);
+    }else{
+        Rcpp::XPtr<dynVCLMat<T> > ptrQ(Qm);
+        viennacl::matrix_range<viennacl::matrix<T> > vcl_Q = ptrQ->data();
+        
+        viennacl::matrix<T> vcl_V(K, K);
+        
+        vcl_eigen<T>(vcl_A, &vcl_V, vcl_D, symmetric);
+        vcl_eigen_sort<T>(vcl_D, vcl_eigenvalues, order);
+        vcl_gather_cols<T>(vcl_V.handle().opencl_handle(), vcl_matrix_layout(vcl_V),
+                           vcl_Q.handle().opencl_handle(), vcl_matrix_layout(vcl_Q),
+                           order);
+    }
 }
 
 
@@ -139,18 +188,18 @@ cpp_gpu_eigen(
     SEXP Qm,
     SEXP eigenvalues,
     const bool symmetric,
+    const bool only_values,
     const int type_flag, 
     int device_flag)
 {
     switch(type_flag) {
         case 4:
-            cpp_gpu_eigen<int>(Am, Qm, eigenvalues, symmetric, device_flag);
-            return;
+            throw Rcpp::exception("integer type not currently implemented");
         case 6:
-            cpp_gpu_eigen<float>(Am, Qm, eigenvalues, symmetric, device_flag);
+            cpp_gpu_eigen<float>(Am, Qm, eigenvalues, symmetric, only_values, device_flag);
             return;
         case 8:
-            cpp_gpu_eigen<double>(Am, Qm, eigenvalues, symmetric, device_flag);
+            cpp_gpu_eigen<double>(Am, Qm, eigenvalues, symmetric, only_values, device_flag);
             return;
         default:
             throw Rcpp::exception("unknown type detected for vclMatrix object!");
@@ -164,18 +213,18 @@ cpp_vcl_eigen(
     SEXP Qm,
     SEXP eigenvalues,
     const bool symmetric,
+    const bool only_values,
     const int type_flag, 
     int device_flag)
 {
     switch(type_flag) {
         case 4:
-            cpp_vcl_eigen<int>(Am, Qm, eigenvalues, symmetric, device_flag);
-            return;
+            throw Rcpp::exception("integer type not currently implemented");
         case 6:
-            cpp_vcl_eigen<float>(Am, Qm, eigenvalues, symmetric, device_flag);
+            cpp_vcl_eigen<float>(Am, Qm, eigenvalues, symmetric, only_values, device_flag);
             return;
         case 8:
-            cpp_vcl_eigen<double>(Am, Qm, eigenvalues, symmetric, device_flag);
+            cpp_vcl_eigen<double>(Am, Qm, eigenvalues, symmetric, only_values, device_flag);
             return;
         default:
             throw Rcpp::exception("unknown type detected for vclMatrix object!");
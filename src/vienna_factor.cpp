@@ -0,0 +1,736 @@
+#include "gpuR/windows_check.hpp"
+
+// eigen headers for handling the R input data
+#include <RcppEigen.h>
+
+#include "gpuR/dynEigenMat.hpp"
+#include "gpuR/dynEigenVec.hpp"
+#include "gpuR/dynVCLMat.hpp"
+#include "gpuR/dynVCLVec.hpp"
+#include "gpuR/vcl_factor.hpp"
+
+// Use OpenCL with ViennaCL
+#define VIENNACL_WITH_OPENCL 1
+
+// ViennaCL headers
+#include "viennacl/ocl/device.hpp"
+#include "viennacl/ocl/platform.hpp"
+#include "viennacl/matrix.hpp"
+#include "viennacl/vector.hpp"
+
+using namespace Rcpp;
+
+// 1-based R pivots <-> 0-based device pivots
+static std::vector<cl_uint>
+pivots_from_R(IntegerVector pivot)
+{
+    std::vector<cl_uint> ipiv(pivot.size());
+    for(int i = 0; i < pivot.size(); i++){
+        ipiv[i] = pivot[i] - 1;
+    }
+    return ipiv;
+}
+
+static IntegerVector
+pivots_to_R(const std::vector<cl_uint> &ipiv)
+{
+    IntegerVector pivot(ipiv.size());
+    for(size_t i = 0; i < ipiv.size(); i++){
+        pivot[i] = ipiv[i] + 1;
+    }
+    return pivot;
+}
+
+/*** gpuMatrix Templates ***/
+
+template <typename T>
+int
+cpp_gpuMatrix_chol(
+    SEXP ptrA_, SEXP ptrR_,
+    int device_flag)
+{
+    // define device type to use
+    if(device_flag == 0){
+        //use only GPUs
+        long id = 0;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::gpu_tag());
+        viennacl::ocl::switch_context(id);
+    }else{
+        // use only CPUs
+        long id = 1;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::cpu_tag());
+        viennacl::ocl::switch_context(id);
+    }
+
+    XPtr<dynEigenMat<T> > ptrA(ptrA_);
+    XPtr<dynEigenMat<T> > ptrR(ptrR_);
+
+    viennacl::matrix<T> vcl_A = ptrA->device_data();
+
+    const int info = vcl_chol(vcl_A);
+
+    if(info == 0){
+        ptrR->to_host(vcl_A);
+    }
+
+    return info;
+}
+
+// X <- A^-1 B, or A^-1 when 'identity'.  B and X are gpuVectors if 'vec'
+template <typename T>
+bool
+cpp_gpuMatrix_solve(
+    SEXP ptrA_, SEXP ptrB_, SEXP ptrX_,
+    bool identity, bool vec,
+    int device_flag)
+{
+    // define device type to use
+    if(device_flag == 0){
+        //use only GPUs
+        long id = 0;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::gpu_tag());
+        viennacl::ocl::switch_context(id);
+    }else{
+        // use only CPUs
+        long id = 1;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::cpu_tag());
+        viennacl::ocl::switch_context(id);
+    }
+
+    XPtr<dynEigenMat<T> > ptrA(ptrA_);
+
+    viennacl::matrix<T> vcl_A = ptrA->device_data();
+    std::vector<cl_uint> ipiv;
+
+    if(!vcl_lu(vcl_A, ipiv)){
+        return false;
+    }
+
+    if(vec){
+        XPtr<dynEigenVec<T> > ptrB(ptrB_);
+        XPtr<dynEigenVec<T> > ptrX(ptrX_);
+
+        Eigen::Map<Eigen::Matrix<T, Eigen::Dynamic, 1> > B = ptrB->data();
+        Eigen::Map<Eigen::Matrix<T, Eigen::Dynamic, 1> > X = ptrX->data();
+
+        viennacl::vector<T> vcl_B(B.size());
+        viennacl::fast_copy(B.data(), B.data() + B.size(), vcl_B.begin());
+
+        vcl_lu_solve<T>(vcl_A, ipiv, vcl_B, vcl_vector_layout(vcl_B));
+
+        viennacl::fast_copy(vcl_B.begin(), vcl_B.end(), X.data());
+    }else{
+        XPtr<dynEigenMat<T> > ptrX(ptrX_);
+
+        viennacl::matrix<T> vcl_B = identity ?
+            viennacl::matrix<T>(viennacl::identity_matrix<T>(vcl_A.size1())) :
+            XPtr<dynEigenMat<T> >(ptrB_)->device_data();
+
+        vcl_lu_solve<T>(vcl_A, ipiv, vcl_B, vcl_matrix_layout(vcl_B));
+
+        ptrX->to_host(vcl_B);
+    }
+
+    return true;
+}
+
+template <typename T>
+List
+cpp_gpuMatrix_det(
+    SEXP ptrA_,
+    int device_flag)
+{
+    // define device type to use
+    if(device_flag == 0){
+        //use only GPUs
+        long id = 0;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::gpu_tag());
+        viennacl::ocl::switch_context(id);
+    }else{
+        // use only CPUs
+        long id = 1;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::cpu_tag());
+        viennacl::ocl::switch_context(id);
+    }
+
+    XPtr<dynEigenMat<T> > ptrA(ptrA_);
+
+    viennacl::matrix<T> vcl_A = ptrA->device_data();
+    std::vector<cl_uint> ipiv;
+
+    double modulus;
+    int sign;
+
+    vcl_lu(vcl_A, ipiv);
+    vcl_lu_det<T>(vcl_A, ipiv, modulus, sign);
+
+    return List::create(_["modulus"] = modulus, _["sign"] = sign);
+}
+
+template <typename T>
+NumericVector
+cpp_gpuMatrix_qr(
+    SEXP ptrA_, SEXP ptrQR_,
+    int device_flag)
+{
+    // define device type to use
+    if(device_flag == 0){
+        //use only GPUs
+        long id = 0;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::gpu_tag());
+        viennacl::ocl::switch_context(id);
+    }else{
+        // use only CPUs
+        long id = 1;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::cpu_tag());
+        viennacl::ocl::switch_context(id);
+    }
+
+    XPtr<dynEigenMat<T> > ptrA(ptrA_);
+    Rcpp::XPtr<dynVCLMat<T> > ptrQR(ptrQR_);
+
+    viennacl::matrix<T> vcl_A = ptrA->device_data();
+
+    std::vector<T> betas = viennacl::linalg::inplace_qr(vcl_A);
+
+    viennacl::matrix_range<viennacl::matrix<T> > vcl_QR = ptrQR->data();
+    vcl_QR = vcl_A;
+
+    return NumericVector(betas.begin(), betas.end());
+}
+
+// LU factors of a gpuMatrix, kept on the device in a vclMatrix
+template <typename T>
+List
+cpp_gpuMatrix_lu(
+    SEXP ptrA_, SEXP ptrLU_,
+    int device_flag)
+{
+    // define device type to use
+    if(device_flag == 0){
+        //use only GPUs
+        long id = 0;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::gpu_tag());
+        viennacl::ocl::switch_context(id);
+    }else{
+        // use only CPUs
+        long id = 1;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::cpu_tag());
+        viennacl::ocl::switch_context(id);
+    }
+
+    XPtr<dynEigenMat<T> > ptrA(ptrA_);
+    Rcpp::XPtr<dynVCLMat<T> > ptrLU(ptrLU_);
+
+    viennacl::matrix<T> vcl_A = ptrA->device_data();
+    std::vector<cl_uint> ipiv;
+
+    const bool nonsingular = vcl_lu(vcl_A, ipiv);
+
+    viennacl::matrix_range<viennacl::matrix<T> > vcl_LU = ptrLU->data();
+    vcl_LU = vcl_A;
+
+    return List::create(_["pivot"] = pivots_to_R(ipiv),
+                        _["nonsingular"] = nonsingular);
+}
+
+/*** vclMatrix Templates ***/
+
+template <typename T>
+int
+cpp_vclMatrix_chol(
+    SEXP ptrA_, SEXP ptrR_,
+    int device_flag)
+{
+    // define device type to use
+    if(device_flag == 0){
+        //use only GPUs
+        long id = 0;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::gpu_tag());
+        viennacl::ocl::switch_context(id);
+    }else{
+        // use only CPUs
+        long id = 1;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::cpu_tag());
+        viennacl::ocl::switch_context(id);
+    }
+
+    Rcpp::XPtr<dynVCLMat<T> > ptrA(ptrA_);
+    Rcpp::XPtr<dynVCLMat<T> > ptrR(ptrR_);
+
+    viennacl::matrix<T> vcl_A(ptrA->data());
+
+    const int info = vcl_chol(vcl_A);
+
+    if(info == 0){
+        viennacl::matrix_range<viennacl::matrix<T> > vcl_R = ptrR->data();
+        vcl_R = vcl_A;
+    }
+
+    return info;
+}
+
+template <typename T>
+List
+cpp_vclMatrix_lu(
+    SEXP ptrA_, SEXP ptrLU_,
+    int device_flag)
+{
+    // define device type to use
+    if(device_flag == 0){
+        //use only GPUs
+        long id = 0;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::gpu_tag());
+        viennacl::ocl::switch_context(id);
+    }else{
+        // use only CPUs
+        long id = 1;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::cpu_tag());
+        viennacl::ocl::switch_context(id);
+    }
+
+    Rcpp::XPtr<dynVCLMat<T> > ptrA(ptrA_);
+    Rcpp::XPtr<dynVCLMat<T> > ptrLU(ptrLU_);
+
+    viennacl::matrix<T> vcl_A(ptrA->data());
+    std::vector<cl_uint> ipiv;
+
+    const bool nonsingular = vcl_lu(vcl_A, ipiv);
+
+    viennacl::matrix_range<viennacl::matrix<T> > vcl_LU = ptrLU->data();
+    vcl_LU = vcl_A;
+
+    return List::create(_["pivot"] = pivots_to_R(ipiv),
+                        _["nonsingular"] = nonsingular);
+}
+
+// X <- A^-1 X from the LU factors of A, or A^-1 when 'identity'.  X is a
+// vclVector if 'vec'
+template <typename T>
+void
+cpp_vclLU_solve(
+    SEXP ptrLU_, IntegerVector pivot, SEXP ptrX_,
+    bool identity, bool vec,
+    int device_flag)
+{
+    // define device type to use
+    if(device_flag == 0){
+        //use only GPUs
+        long id = 0;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::gpu_tag());
+        viennacl::ocl::switch_context(id);
+    }else{
+        // use only CPUs
+        long id = 1;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::cpu_tag());
+        viennacl::ocl::switch_context(id);
+    }
+
+    Rcpp::XPtr<dynVCLMat<T> > ptrLU(ptrLU_);
+
+    viennacl::matrix_range<viennacl::matrix<T> > vcl_LU = ptrLU->data();
+    const std::vector<cl_uint> ipiv = pivots_from_R(pivot);
+
+    if(vec){
+        Rcpp::XPtr<dynVCLVec<T> > ptrX(ptrX_);
+        viennacl::vector_range<viennacl::vector<T> > vcl_X = ptrX->data();
+
+        vcl_lu_solve<T>(vcl_LU, ipiv, vcl_X, vcl_vector_layout(vcl_X));
+    }else{
+        Rcpp::XPtr<dynVCLMat<T> > ptrX(ptrX_);
+        viennacl::matrix_range<viennacl::matrix<T> > vcl_X = ptrX->data();
+
+        if(identity){
+            vcl_X = viennacl::matrix<T>(viennacl::identity_matrix<T>(vcl_LU.size1()));
+        }
+
+        vcl_lu_solve<T>(vcl_LU, ipiv, vcl_X, vcl_matrix_layout(vcl_X));
+    }
+}
+
+template <typename T>
+List
+cpp_vclLU_det(
+    SEXP ptrLU_, IntegerVector pivot,
+    int device_flag)
+{
+    // define device type to use
+    if(device_flag == 0){
+        //use only GPUs
+        long id = 0;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::gpu_tag());
+        viennacl::ocl::switch_context(id);
+    }else{
+        // use only CPUs
+        long id = 1;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::cpu_tag());
+        viennacl::ocl::switch_context(id);
+    }
+
+    Rcpp::XPtr<dynVCLMat<T> > ptrLU(ptrLU_);
+
+    viennacl::matrix_range<viennacl::matrix<T> > vcl_LU = ptrLU->data();
+
+    double modulus;
+    int sign;
+
+    vcl_lu_det<T>(vcl_LU, pivots_from_R(pivot), modulus, sign);
+
+    return List::create(_["modulus"] = modulus, _["sign"] = sign);
+}
+
+template <typename T>
+NumericVector
+cpp_vclMatrix_qr(
+    SEXP ptrA_, SEXP ptrQR_,
+    int device_flag)
+{
+    // define device type to use
+    if(device_flag == 0){
+        //use only GPUs
+        long id = 0;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::gpu_tag());
+        viennacl::ocl::switch_context(id);
+    }else{
+        // use only CPUs
+        long id = 1;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::cpu_tag());
+        viennacl::ocl::switch_context(id);
+    }
+
+    Rcpp::XPtr<dynVCLMat<T> > ptrA(ptrA_);
+    Rcpp::XPtr<dynVCLMat<T> > ptrQR(ptrQR_);
+
+    viennacl::matrix<T> vcl_A(ptrA->data());
+
+    std::vector<T> betas = viennacl::linalg::inplace_qr(vcl_A);
+
+    viennacl::matrix_range<viennacl::matrix<T> > vcl_QR = ptrQR->data();
+    vcl_QR = vcl_A;
+
+    return NumericVector(betas.begin(), betas.end());
+}
+
+// Q (thin, nrow x ncol) or R (upper, ncol x ncol) of a compact QR
+template <typename T>
+void
+cpp_vclQR_QR(
+    SEXP ptrQR_, NumericVector beta, SEXP ptrOut_,
+    bool Q,
+    int device_flag)
+{
+    // define device type to use
+    if(device_flag == 0){
+        //use only GPUs
+        long id = 0;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::gpu_tag());
+        viennacl::ocl::switch_context(id);
+    }else{
+        // use only CPUs
+        long id = 1;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::cpu_tag());
+        viennacl::ocl::switch_context(id);
+    }
+
+    Rcpp::XPtr<dynVCLMat<T> > ptrQR(ptrQR_);
+    Rcpp::XPtr<dynVCLMat<T> > ptrOut(ptrOut_);
+
+    viennacl::matrix_range<viennacl::matrix<T> > vcl_QR = ptrQR->data();
+    viennacl::matrix_range<viennacl::matrix<T> > vcl_Out = ptrOut->data();
+
+    const size_t n = vcl_QR.size2();
+    viennacl::range rn(0, n);
+
+    if(Q){
+        const std::vector<T> betas(beta.begin(), beta.end());
+
+        vcl_Out = vcl_thin_q(vcl_QR, betas);
+    }else{
+        viennacl::matrix<T> vcl_R = viennacl::project(vcl_QR, rn, rn);
+        vcl_zero_lower<T>(vcl_R);
+
+        vcl_Out = vcl_R;
+    }
+}
+
+// least squares coefficients X <- R^-1 t(Q) B, B and X are vclVectors
+// if 'vec'
+template <typename T>
+void
+cpp_vclQR_coef(
+    SEXP ptrQR_, NumericVector beta, SEXP ptrB_, SEXP ptrX_,
+    bool vec,
+    int device_flag)
+{
+    // define device type to use
+    if(device_flag == 0){
+        //use only GPUs
+        long id = 0;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::gpu_tag());
+        viennacl::ocl::switch_context(id);
+    }else{
+        // use only CPUs
+        long id = 1;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::cpu_tag());
+        viennacl::ocl::switch_context(id);
+    }
+
+    Rcpp::XPtr<dynVCLMat<T> > ptrQR(ptrQR_);
+
+    viennacl::matrix_range<viennacl::matrix<T> > vcl_QR = ptrQR->data();
+
+    const std::vector<T> betas(beta.begin(), beta.end());
+    const size_t n = vcl_QR.size2();
+    viennacl::range rn(0, n);
+    viennacl::matrix_range<viennacl::matrix<T> > vcl_R = viennacl::project(vcl_QR, rn, rn);
+
+    if(vec){
+        Rcpp::XPtr<dynVCLVec<T> > ptrB(ptrB_);
+        Rcpp::XPtr<dynVCLVec<T> > ptrX(ptrX_);
+
+        viennacl::vector<T> vcl_B = ptrB->data();
+
+        // t(Q) B one reflection at a time
+        for(size_t j = 0; j < betas.size(); j++){
+            viennacl::vector<T> v = vcl_householder<T>(vcl_QR, j);
+            const T s = viennacl::linalg::inner_prod(v, vcl_B);
+            vcl_B -= (betas[j] * s) * v;
+        }
+
+        viennacl::vector_range<viennacl::vector<T> > head(vcl_B, rn);
+        viennacl::linalg::inplace_solve(vcl_R, head, viennacl::linalg::upper_tag());
+
+        viennacl::vector_range<viennacl::vector<T> > vcl_X = ptrX->data();
+        vcl_X = head;
+    }else{
+        Rcpp::XPtr<dynVCLMat<T> > ptrB(ptrB_);
+        Rcpp::XPtr<dynVCLMat<T> > ptrX(ptrX_);
+
+        viennacl::matrix<T> vcl_B(ptrB->data());
+
+        vcl_apply_householder(vcl_QR, betas, vcl_B, true);
+
+        viennacl::matrix_range<viennacl::matrix<T> > head(vcl_B, rn, viennacl::range(0, vcl_B.size2()));
+        viennacl::linalg::inplace_solve(vcl_R, head, viennacl::linalg::upper_tag());
+
+        viennacl::matrix_range<viennacl::matrix<T> > vcl_X = ptrX->data();
+        vcl_X = head;
+    }
+}
+
+
+/*** Exported functions ***/
+
+// [[Rcpp::export]]
+int
+cpp_gpuMatrix_chol(
+    SEXP ptrA, SEXP ptrR,
+    int device_flag,
+    const int type_flag)
+{
+    switch(type_flag) {
+        case 6:
+            return cpp_gpuMatrix_chol<float>(ptrA, ptrR, device_flag);
+        case 8:
+            return cpp_gpuMatrix_chol<double>(ptrA, ptrR, device_flag);
+        default:
+            throw Rcpp::exception("unknown type detected for gpuMatrix object!");
+    }
+}
+
+// [[Rcpp::export]]
+bool
+cpp_gpuMatrix_solve(
+    SEXP ptrA, SEXP ptrB, SEXP ptrX,
+    bool identity, bool vec,
+    int device_flag,
+    const int type_flag)
+{
+    switch(type_flag) {
+        case 6:
+            return cpp_gpuMatrix_solve<float>(ptrA, ptrB, ptrX, identity, vec, device_flag);
+        case 8:
+            return cpp_gpuMatrix_solve<double>(ptrA, ptrB, ptrX, identity, vec, device_flag);
+        default:
+            throw Rcpp::exception("unknown type detected for gpuMatrix object!");
+    }
+}
+
+// [[Rcpp::export]]
+List
+cpp_gpuMatrix_det(
+    SEXP ptrA,
+    int device_flag,
+    const int type_flag)
+{
+    switch(type_flag) {
+        case 6:
+            return cpp_gpuMatrix_det<float>(ptrA, device_flag);
+        case 8:
+            return cpp_gpuMatrix_det<double>(ptrA, device_flag);
+        default:
+            throw Rcpp::exception("unknown type detected for gpuMatrix object!");
+    }
+}
+
+// [[Rcpp::export]]
+NumericVector
+cpp_gpuMatrix_qr(
+    SEXP ptrA, SEXP ptrQR,
+    int device_flag,
+    const int type_flag)
+{
+    switch(type_flag) {
+        case 6:
+            return cpp_gpuMatrix_qr<float>(ptrA, ptrQR, device_flag);
+        case 8:
+            return cpp_gpuMatrix_qr<double>(ptrA, ptrQR, device_flag);
+        default:
+            throw Rcpp::exception("unknown type detected for gpuMatrix object!");
+    }
+}
+
+// [[Rcpp::export]]
+List
+cpp_gpuMatrix_lu(
+    SEXP ptrA, SEXP ptrLU,
+    int device_flag,
+    const int type_flag)
+{
+    switch(type_flag) {
+        case 6:
+            return cpp_gpuMatrix_lu<float>(ptrA, ptrLU, device_flag);
+        case 8:
+            return cpp_gpuMatrix_lu<double>(ptrA, ptrLU, device_flag);
+        default:
+            throw Rcpp::exception("unknown type detected for gpuMatrix object!");
+    }
+}
+
+// [[Rcpp::export]]
+int
+cpp_vclMatrix_chol(
+    SEXP ptrA, SEXP ptrR,
+    int device_flag,
+    const int type_flag)
+{
+    switch(type_flag) {
+        case 6:
+            return cpp_vclMatrix_chol<float>(ptrA, ptrR, device_flag);
+        case 8:
+            return cpp_vclMatrix_chol<double>(ptrA, ptrR, device_flag);
+        default:
+            throw Rcpp::exception("unknown type detected for vclMatrix object!");
+    }
+}
+
+// [[Rcpp::export]]
+List
+cpp_vclMatrix_lu(
+    SEXP ptrA, SEXP ptrLU,
+    int device_flag,
+    const int type_flag)
+{
+    switch(type_flag) {
+        case 6:
+            return cpp_vclMatrix_lu<float>(ptrA, ptrLU, device_flag);
+        case 8:
+            return cpp_vclMatrix_lu<double>(ptrA, ptrLU, device_flag);
+        default:
+            throw Rcpp::exception("unknown type detected for vclMatrix object!");
+    }
+}
+
+// [[Rcpp::export]]
+void
+cpp_vclLU_solve(
+    SEXP ptrLU, IntegerVector pivot, SEXP ptrX,
+    bool identity, bool vec,
+    int device_flag,
+    const int type_flag)
+{
+    switch(type_flag) {
+        case 6:
+            cpp_vclLU_solve<float>(ptrLU, pivot, ptrX, identity, vec, device_flag);
+            return;
+        case 8:
+            cpp_vclLU_solve<double>(ptrLU, pivot, ptrX, identity, vec, device_flag);
+            return;
+        default:
+            throw Rcpp::exception("unknown type detected for vclMatrix object!");
+    }
+}
+
+// [[Rcpp::export]]
+List
+cpp_vclLU_det(
+    SEXP ptrLU, IntegerVector pivot,
+    int device_flag,
+    const int type_flag)
+{
+    switch(type_flag) {
+        case 6:
+            return cpp_vclLU_det<float>(ptrLU, pivot, device_flag);
+        case 8:
+            return cpp_vclLU_det<double>(ptrLU, pivot, device_flag);
+        default:
+            throw Rcpp::exception("unknown type detected for vclMatrix object!");
+    }
+}
+
+// [[Rcpp::export]]
+NumericVector
+cpp_vclMatrix_qr(
+    SEXP ptrA, SEXP ptrQR,
+    int device_flag,
+    const int type_flag)
+{
+    switch(type_flag) {
+        case 6:
+            return cpp_vclMatrix_qr<float>(ptrA, ptrQR, device_flag);
+        case 8:
+            return cpp_vclMatrix_qr<double>(ptrA, ptrQR, device_flag);
+        default:
+            throw Rcpp::exception("unknown type detected for vclMatrix object!");
+    }
+}
+
+// [[Rcpp::export]]
+void
+cpp_vclQR_QR(
+    SEXP ptrQR, NumericVector beta, SEXP ptrOut,
+    bool Q,
+    int device_flag,
+    const int type_flag)
+{
+    switch(type_flag) {
+        case 6:
+            cpp_vclQR_QR<float>(ptrQR, beta, ptrOut, Q, device_flag);
+            return;
+        case 8:
+            cpp_vclQR_QR<double>(ptrQR, beta, ptrOut, Q, device_flag);
+            return;
+        default:
+            throw Rcpp::exception("unknown type detected for vclMatrix object!");
+    }
+}
+
+// [[Rcpp::export]]
+void
+cpp_vclQR_coef(
+    SEXP ptrQR, NumericVector beta, SEXP ptrB, SEXP ptrX,
+    bool vec,
+    int device_flag,
+    const int type_flag)
+{
+    switch(type_flag) {
+        case 6:
+            cpp_vclQR_coef<float>(ptrQR, beta, ptrB, ptrX, vec, device_flag);
+            return;
+        case 8:
+            cpp_vclQR_coef<double>(ptrQR, beta, ptrB, ptrX, vec, device_flag);
+            return;
+        default:
+            throw Rcpp::exception("unknown type detected for vclMatrix object!");
+    }
+}
@@ -0,0 +1,509 @@
+
+#include "gpuR/windows_check.hpp"
+
+// eigen headers for handling the R input data
+#include <RcppEigen.h>
+
+#include "gpuR/dynEigenMat.hpp"
+#include "gpuR/dynEigenVec.hpp"
+#include "gpuR/dynFileMat.hpp"
+#include "gpuR/vcl_rect_copy.hpp"
+#include "gpuR/vcl_stats_helpers.hpp"
+#include "gpuR/trace_helpers.hpp"
+
+// Use OpenCL with ViennaCL
+#define VIENNACL_WITH_OPENCL 1
+
+// ViennaCL headers
+#include "viennacl/ocl/backend.hpp"
+#include "viennacl/matrix.hpp"
+#include "viennacl/matrix_proxy.hpp"
+#include "viennacl/vector.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/sum.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <vector>
+
+using namespace Rcpp;
+
+/*** gpuFileMatrix helpers ***/
+
+// rows of a tile 'cols' wide that fit in one transfer
+template <typename T>
+static size_t
+tile_rows(size_t nr, size_t cols)
+{
+    return std::min(nr, std::max<size_t>(1, matrix_file_chunk() / (sizeof(T) * std::max<size_t>(1, cols))));
+}
+
+// 1-based R indices checked against an extent of n
+static void
+check_file_index(const NumericVector &idx, size_t n)
+{
+    for(R_xlen_t k = 0; k < idx.size(); k++){
+        if(!(idx[k] >= 1 && idx[k] <= (double)n)){
+            throw Rcpp::exception("subscript out of bounds");
+        }
+    }
+}
+
+// the k-th selected row or column, 0-based
+static size_t
+file_index(const NumericVector &idx, bool all, size_t k)
+{
+    return all ? k : (size_t)idx[k] - 1;
+}
+
+// a value from R as stored in the file
+template <typename T>
+static T
+file_value(double x)
+{
+    return (T)x;
+}
+
+// NA as well beyond the int range, where the cast is undefined
+template <>
+int
+file_value<int>(double x)
+{
+    return ISNAN(x) || x <= INT_MIN || x >= (double)INT_MAX + 1 ? NA_INTEGER : (int)x;
+}
+
+/*** gpuFileMatrix Templates ***/
+
+template <typename T>
+SEXP
+cpp_gpuFileMatrix_open(std::string file, bool writable, int type_flag)
+{
+    dynFileMat<T> *mat = new dynFileMat<T>(file, type_flag, writable);
+    XPtr<dynFileMat<T> > pMat(mat);
+    return pMat;
+}
+
+// A[rows, cols] copied from the mapping
+template <typename T>
+SEXP
+cpp_gpuFileMatrix_get(
+    SEXP ptrA_,
+    NumericVector rows, NumericVector cols,
+    bool all_rows, bool all_cols)
+{
+    XPtr<dynFileMat<T> > ptrA(ptrA_);
+
+    const size_t M = ptrA->nrow();
+    const size_t N = ptrA->ncol();
+
+    if(!all_rows) check_file_index(rows, M);
+    if(!all_cols) check_file_index(cols, N);
+
+    const size_t R = all_rows ? M : rows.size();
+    const size_t C = all_cols ? N : cols.size();
+
+    const T *A = ptrA->data();
+    Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> out(R, C);
+
+    for(size_t j = 0; j < C; j++){
+        const T *col = A + file_index(cols, all_cols, j) * M;
+        for(size_t i = 0; i < R; i++){
+            out(i, j) = col[file_index(rows, all_rows, i)];
+        }
+    }
+
+    return wrap(out);
+}
+
+// A[rows, cols] <- values, recycled, written through the mapping
+template <typename T>
+void
+cpp_gpuFileMatrix_set(
+    SEXP ptrA_,
+    NumericVector rows, NumericVector cols,
+    bool all_rows, bool all_cols,
+    NumericVector values)
+{
+    XPtr<dynFileMat<T> > ptrA(ptrA_);
+
+    if(!ptrA->is_writable()){
+        throw Rcpp::exception("gpuFileMatrix was opened read-only");
+    }
+
+    const size_t M = ptrA->nrow();
+    const size_t N = ptrA->ncol();
+
+    if(!all_rows) check_file_index(rows, M);
+    if(!all_cols) check_file_index(cols, N);
+
+    const size_t R = all_rows ? M : rows.size();
+    const size_t C = all_cols ? N : cols.size();
+    const size_t V = values.size();
+
+    if(V == 0) return;
+
+    T *A = ptrA->data();
+    size_t k = 0;
+
+    for(size_t j = 0; j < C; j++){
+        T *col = A + file_index(cols, all_cols, j) * M;
+        for(size_t i = 0; i < R; i++){
+            col[file_index(rows, all_rows, i)] = file_value<T>(values[k]);
+            k = k + 1 == V ? 0 : k + 1;
+        }
+    }
+}
+
+// column (or row when 'rows') sums of A streamed through the device in
+// tiles of at most matrix_file_chunk() bytes, each reduced on the device
+template <typename T>
+void
+cpp_gpuFileMatrix_sums(
+    SEXP ptrA_, SEXP ptrS_,
+    bool rows,
+    int device_flag)
+{
+    // define device type to use
+    if(device_flag == 0){
+        //use only GPUs
+        long id = 0;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::gpu_tag());
+        viennacl::ocl::switch_context(id);
+    }else{
+        // use only CPUs
+        long id = 1;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::cpu_tag());
+        viennacl::ocl::switch_context(id);
+    }
+
+    XPtr<dynFileMat<T> > ptrA(ptrA_);
+    XPtr<dynEigenVec<T> > ptrS(ptrS_);
+
+    Eigen::Map<Eigen::Matrix<T, Eigen::Dynamic, 1> > S = ptrS->data();
+
+    const size_t M = ptrA->nrow();
+    const size_t N = ptrA->ncol();
+
+    // whole columns when they fit, otherwise column pieces
+    const size_t pc = std::min(N, std::max<size_t>(1, matrix_file_chunk() / (sizeof(T) * std::max<size_t>(1, M))));
+    const size_t pr = tile_rows<T>(M, pc);
+
+    traceScope span(rows ? "gpuFileMatrix rowSums" : "gpuFileMatrix colSums", (double)M * N * sizeof(T));
+
+    S.setZero();
+    if(M == 0 || N == 0) return;
+
+    const T *src = ptrA->data();
+
+    // column-major, so a tile of the file lands in one rect transfer
+    viennacl::matrix<T, viennacl::column_major> vcl_T(pr, pc);
+    std::vector<T> part;
+
+    for(size_t j = 0; j < N; j += pc){
+        const size_t nc = std::min(pc, N - j);
+
+        for(size_t i = 0; i < M; i += pr){
+            const size_t nr = std::min(pr, M - i);
+
+            viennacl::matrix_range<viennacl::matrix<T, viennacl::column_major> > vcl_P =
+                viennacl::project(vcl_T, viennacl::range(0, nr), viennacl::range(0, nc));
+
+            vcl_write_block(src + j * M + i, M, vcl_P);
+
+            viennacl::vector<T> vcl_s = rows ?
+                viennacl::vector<T>(viennacl::linalg::row_sum(vcl_P)) :
+                viennacl::vector<T>(viennacl::linalg::column_sum(vcl_P));
+
+            part.resize(vcl_s.size());
+            viennacl::copy(vcl_s, part);
+
+            Eigen::Map<Eigen::Matrix<T, Eigen::Dynamic, 1> > p(part.data(), part.size());
+            if(rows){
+                S.segment(i, nr) += p;
+            }else{
+                S.segment(j, nc) += p;
+            }
+        }
+    }
+}
+
+// C <- t(A) %*% B accumulated on the device over row panels of A and B,
+// B is A when 'same'
+template <typename T>
+void
+cpp_gpuFileMatrix_crossprod(
+    SEXP ptrA_, SEXP ptrB_, SEXP ptrC_,
+    bool same,
+    int device_flag)
+{
+    // define device type to use
+    if(device_flag == 0){
+        //use only GPUs
+        long id = 0;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::gpu_tag());
+        viennacl::ocl::switch_context(id);
+    }else{
+        // use only CPUs
+        long id = 1;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::cpu_tag());
+        viennacl::ocl::switch_context(id);
+    }
+
+    XPtr<dynFileMat<T> > ptrA(ptrA_);
+    XPtr<dynFileMat<T> > ptrB(ptrB_);
+    XPtr<dynEigenMat<T> > ptrC(ptrC_);
+
+    const size_t M = ptrA->nrow();
+    const size_t N = ptrA->ncol();
+    const size_t P = ptrB->ncol();
+
+    if(ptrB->nrow() != M){
+        throw Rcpp::exception("non-conformable arguments");
+    }
+
+    const size_t pr = tile_rows<T>(M, same ? N : N + P);
+
+    traceScope span("gpuFileMatrix crossprod", (double)M * (same ? N : N + P) * sizeof(T));
+
+    const T *srcA = ptrA->data();
+    const T *srcB = ptrB->data();
+
+    viennacl::matrix<T> vcl_C = viennacl::zero_matrix<T>(N, P);
+
+    if(M > 0 && N > 0 && P > 0){
+        viennacl::matrix<T, viennacl::column_major> vcl_TA(pr, N);
+        viennacl::matrix<T, viennacl::column_major> vcl_TB(same ? 1 : pr, same ? 1 : P);
+
+        for(size_t i = 0; i < M; i += pr){
+            const size_t nr = std::min(pr, M - i);
+
+            viennacl::matrix_range<viennacl::matrix<T, viennacl::column_major> > vcl_PA =
+                viennacl::project(vcl_TA, viennacl::range(0, nr), viennacl::range(0, N));
+            vcl_write_block(srcA + i, M, vcl_PA);
+
+            if(same){
+                vcl_C += viennacl::linalg::prod(trans(vcl_PA), vcl_PA);
+            }else{
+                viennacl::matrix_range<viennacl::matrix<T, viennacl::column_major> > vcl_PB =
+                    viennacl::project(vcl_TB, viennacl::range(0, nr), viennacl::range(0, P));
+                vcl_write_block(srcB + i, M, vcl_PB);
+
+                vcl_C += viennacl::linalg::prod(trans(vcl_PA), vcl_PB);
+            }
+        }
+    }
+
+    ptrC->to_host(vcl_C);
+}
+
+// D <- distances between the rows of A and the rows of B, A streamed
+// through the device in row panels and each panel of D read back
+template <typename T>
+void
+cpp_gpuFileMatrix_peuclidean(
+    SEXP ptrA_, SEXP ptrB_, SEXP ptrD_,
+    bool squareDist,
+    int device_flag)
+{
+    // define device type to use
+    if(device_flag == 0){
+        //use only GPUs
+        long id = 0;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::gpu_tag());
+        viennacl::ocl::switch_context(id);
+    }else{
+        // use only CPUs
+        long id = 1;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::cpu_tag());
+        viennacl::ocl::switch_context(id);
+    }
+
+    XPtr<dynFileMat<T> > ptrA(ptrA_);
+    XPtr<dynEigenMat<T> > ptrB(ptrB_);
+    XPtr<dynEigenMat<T> > ptrD(ptrD_);
+
+    const size_t M = ptrA->nrow();
+    const size_t N = ptrA->ncol();
+
+    viennacl::matrix<T> vcl_B = ptrB->device_data();
+    const size_t P = vcl_B.size1();
+
+    ptrD->detach();
+    Eigen::Ref<Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> > D = ptrD->data();
+
+    const size_t pr = tile_rows<T>(M, std::max(N, P));
+
+    traceScope span("gpuFileMatrix distance", (double)M * N * sizeof(T));
+
+    const T *src = ptrA->data();
+
+    for(size_t i = 0; i < M; i += pr){
+        const size_t nr = std::min(pr, M - i);
+
+        viennacl::matrix<T> vcl_PA(nr, N);
+        viennacl::matrix<T> vcl_PD(nr, P);
+
+        vcl_write_block(src + i, M, vcl_PA);
+        vcl_peucl<T>(vcl_PA, vcl_B, vcl_PD, squareDist);
+        vcl_read_block(vcl_PD, D.data() + i, D.outerStride());
+    }
+}
+
+/*** Exported functions ***/
+
+// [[Rcpp::export]]
+void
+cpp_matrix_file_create(
+    std::string file,
+    double nrow, double ncol,
+    const int type_flag)
+{
+    matrix_file_create(file, type_flag, (size_t)nrow, (size_t)ncol);
+}
+
+// [[Rcpp::export]]
+NumericVector
+cpp_gpuFileMatrix_dim(SEXP ptrA, const int type_flag)
+{
+    switch(type_flag) {
+        case 4:
+        {
+            XPtr<dynFileMat<int> > pMat(ptrA);
+            return NumericVector::create((double)pMat->nrow(), (double)pMat->ncol());
+        }
+        case 6:
+        {
+            XPtr<dynFileMat<float> > pMat(ptrA);
+            return NumericVector::create((double)pMat->nrow(), (double)pMat->ncol());
+        }
+        case 8:
+        {
+            XPtr<dynFileMat<double> > pMat(ptrA);
+            return NumericVector::create((double)pMat->nrow(), (double)pMat->ncol());
+        }
+        default:
+            throw Rcpp::exception("unknown type detected for gpuFileMatrix object!");
+    }
+}
+
+// [[Rcpp::export]]
+SEXP
+cpp_gpuFileMatrix_open(
+    std::string file, bool writable,
+    const int type_flag)
+{
+    switch(type_flag) {
+        case 4:
+            return cpp_gpuFileMatrix_open<int>(file, writable, type_flag);
+        case 6:
+            return cpp_gpuFileMatrix_open<float>(file, writable, type_flag);
+        case 8:
+            return cpp_gpuFileMatrix_open<double>(file, writable, type_flag);
+        default:
+            throw Rcpp::exception("unknown type detected for gpuFileMatrix object!");
+    }
+}
+
+// [[Rcpp::export]]
+SEXP
+cpp_gpuFileMatrix_get(
+    SEXP ptrA,
+    NumericVector rows, NumericVector cols,
+    bool all_rows, bool all_cols,
+    const int type_flag)
+{
+    switch(type_flag) {
+        case 4:
+            return cpp_gpuFileMatrix_get<int>(ptrA, rows, cols, all_rows, all_cols);
+        case 6:
+            return cpp_gpuFileMatrix_get<float>(ptrA, rows, cols, all_rows, all_cols);
+        case 8:
+            return cpp_gpuFileMatrix_get<double>(ptrA, rows, cols, all_rows, all_cols);
+        default:
+            throw Rcpp::exception("unknown type detected for gpuFileMatrix object!");
+    }
+}
+
+// [[Rcpp::export]]
+void
+cpp_gpuFileMatrix_set(
+    SEXP ptrA,
+    NumericVector rows, NumericVector cols,
+    bool all_rows, bool all_cols,
+    NumericVector values,
+    const int type_flag)
+{
+    switch(type_flag) {
+        case 4:
+            cpp_gpuFileMatrix_set<int>(ptrA, rows, cols, all_rows, all_cols, values);
+            return;
+        case 6:
+            cpp_gpuFileMatrix_set<float>(ptrA, rows, cols, all_rows, all_cols, values);
+            return;
+        case 8:
+            cpp_gpuFileMatrix_set<double>(ptrA, rows, cols, all_rows, all_cols, values);
+            return;
+        default:
+            throw Rcpp::exception("unknown type detected for gpuFileMatrix object!");
+    }
+}
+
+// [[Rcpp::export]]
+void
+cpp_gpuFileMatrix_sums(
+    SEXP ptrA, SEXP ptrS,
+    bool rows,
+    int device_flag,
+    const int type_flag)
+{
+    switch(type_flag) {
+        case 6:
+            cpp_gpuFileMatrix_sums<float>(ptrA, ptrS, rows, device_flag);
+            return;
+        case 8:
+            cpp_gpuFileMatrix_sums<double>(ptrA, ptrS, rows, device_flag);
+            return;
+        default:
+            throw Rcpp::exception("unknown type detected for gpuFileMatrix object!");
+    }
+}
+
+// [[Rcpp::export]]
+void
+cpp_gpuFileMatrix_crossprod(
+    SEXP ptrA, SEXP ptrB, SEXP ptrC,
+    bool same,
+    int device_flag,
+    const int type_flag)
+{
+    switch(type_flag) {
+        case 6:
+            cpp_gpuFileMatrix_crossprod<float>(ptrA, ptrB, ptrC, same, device_flag);
+            return;
+        case 8:
+            cpp_gpuFileMatrix_crossprod<double>(ptrA, ptrB, ptrC, same, device_flag);
+            return;
+        default:
+            throw Rcpp::exception("unknown type detected for gpuFileMatrix object!");
+    }
+}
+
+// [[Rcpp::export]]
+void
+cpp_gpuFileMatrix_peuclidean(
+    SEXP ptrA, SEXP ptrB, SEXP ptrD,
+    bool squareDist,
+    int device_flag,
+    const int type_flag)
+{
+    switch(type_flag) {
+        case 6:
+            cpp_gpuFileMatrix_peuclidean<float>(ptrA, ptrB, ptrD, squareDist, device_flag);
+            return;
+        case 8:
+            cpp_gpuFileMatrix_peuclidean<double>(ptrA, ptrB, ptrD, squareDist, device_flag);
+            return;
+        default:
+            throw Rcpp::exception("unknown type detected for gpuFileMatrix object!");
+    }
+}
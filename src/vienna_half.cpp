@@ -0,0 +1,358 @@
+#include "gpuR/windows_check.hpp"
+
+// eigen headers for handling the R input data
+#include <RcppEigen.h>
+
+#include "gpuR/dynVCLMat.hpp"
+#include "gpuR/dynVCLVec.hpp"
+#include "gpuR/dynVCLHalf.hpp"
+#include "gpuR/vcl_half_kernels.hpp"
+#include "gpuR/trace_helpers.hpp"
+
+// Use OpenCL with ViennaCL
+#define VIENNACL_WITH_OPENCL 1
+
+// ViennaCL headers
+#include "viennacl/ocl/device.hpp"
+#include "viennacl/ocl/platform.hpp"
+#include "viennacl/vector.hpp"
+#include "viennacl/matrix.hpp"
+
+#include <vector>
+
+using namespace Rcpp;
+
+/*** hvclMatrix/hvclVector helpers ***/
+
+// the column-major layout of a dense size1 x size2 float buffer
+static vclLayout
+dense_layout(unsigned int size1, unsigned int size2)
+{
+    vclLayout l;
+    l.offset = 0;
+    l.row_stride = 1;
+    l.col_stride = size1;
+    l.size1 = size1;
+    l.size2 = size2;
+    return l;
+}
+
+
+/*** Exported functions ***/
+
+// [[Rcpp::export]]
+SEXP
+cpp_hvcl_empty(int nr, int nc, int device_flag)
+{
+    // define device type to use
+    if(device_flag == 0){
+        //use only GPUs
+        long id = 0;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::gpu_tag());
+        viennacl::ocl::switch_context(id);
+    }else{
+        // use only CPUs
+        long id = 1;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::cpu_tag());
+        viennacl::ocl::switch_context(id);
+    }
+
+    dynVCLHalf *H = new dynVCLHalf(nr, nc);
+    Rcpp::XPtr<dynVCLHalf> pH(H);
+    return pH;
+}
+
+// [[Rcpp::export]]
+SEXP
+cpp_hvcl_from_host(SEXP data, int nr, int nc, int device_flag)
+{
+    // define device type to use
+    if(device_flag == 0){
+        //use only GPUs
+        long id = 0;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::gpu_tag());
+        viennacl::ocl::switch_context(id);
+    }else{
+        // use only CPUs
+        long id = 1;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::cpu_tag());
+        viennacl::ocl::switch_context(id);
+    }
+
+    Rcpp::NumericVector values(data);
+    std::vector<float> host(values.begin(), values.end());
+
+    viennacl::vector<float> vcl_F(host.size());
+    {
+        traceScope span("dynVCLHalf upload", (double)host.size() * sizeof(float));
+        viennacl::copy(host, vcl_F);
+    }
+
+    dynVCLHalf *H = new dynVCLHalf(nr, nc);
+    vcl_to_half(vcl_F.handle().opencl_handle(), dense_layout(nr, nc), H->handle());
+
+    Rcpp::XPtr<dynVCLHalf> pH(H);
+    return pH;
+}
+
+// [[Rcpp::export]]
+NumericVector
+cpp_hvcl_to_host(SEXP ptrH, int device_flag)
+{
+    // define device type to use
+    if(device_flag == 0){
+        //use only GPUs
+        long id = 0;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::gpu_tag());
+        viennacl::ocl::switch_context(id);
+    }else{
+        // use only CPUs
+        long id = 1;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::cpu_tag());
+        viennacl::ocl::switch_context(id);
+    }
+
+    Rcpp::XPtr<dynVCLHalf> pH(ptrH);
+
+    viennacl::vector<float> vcl_F(pH->size());
+    vcl_from_half(pH->handle(), vcl_F.handle().opencl_handle(), 
+                  dense_layout(pH->nrow(), pH->ncol()));
+
+    std::vector<float> host(pH->size());
+    {
+        traceScope span("dynVCLHalf download", (double)host.size() * sizeof(float));
+        viennacl::copy(vcl_F, host);
+    }
+
+    return NumericVector(host.begin(), host.end());
+}
+
+// [[Rcpp::export]]
+IntegerVector
+cpp_hvcl_dim(SEXP ptrH)
+{
+    Rcpp::XPtr<dynVCLHalf> pH(ptrH);
+    return IntegerVector::create(pH->nrow(), pH->ncol());
+}
+
+// [[Rcpp::export]]
+SEXP
+cpp_hvclMatrix_from_fvcl(SEXP ptrF, int device_flag)
+{
+    // define device type to use
+    if(device_flag == 0){
+        //use only GPUs
+        long id = 0;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::gpu_tag());
+        viennacl::ocl::switch_context(id);
+    }else{
+        // use only CPUs
+        long id = 1;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::cpu_tag());
+        viennacl::ocl::switch_context(id);
+    }
+
+    Rcpp::XPtr<dynVCLMat<float> > pF(ptrF);
+    viennacl::matrix_range<viennacl::matrix<float> > vcl_F = pF->data();
+
+    dynVCLHalf *H = new dynVCLHalf(vcl_F.size1(), vcl_F.size2());
+    vcl_to_half(vcl_F.handle().opencl_handle(), vcl_matrix_layout(vcl_F), H->handle());
+
+    Rcpp::XPtr<dynVCLHalf> pH(H);
+    return pH;
+}
+
+// [[Rcpp::export]]
+SEXP
+cpp_hvclVector_from_fvcl(SEXP ptrF, int device_flag)
+{
+    // define device type to use
+    if(device_flag == 0){
+        //use only GPUs
+        long id = 0;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::gpu_tag());
+        viennacl::ocl::switch_context(id);
+    }else{
+        // use only CPUs
+        long id = 1;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::cpu_tag());
+        viennacl::ocl::switch_context(id);
+    }
+
+    Rcpp::XPtr<dynVCLVec<float> > pF(ptrF);
+    viennacl::vector_range<viennacl::vector<float> > vcl_F = pF->data();
+
+    dynVCLHalf *H = new dynVCLHalf(vcl_F.size(), 1);
+    vcl_to_half(vcl_F.handle().opencl_handle(), vcl_vector_layout(vcl_F), H->handle());
+
+    Rcpp::XPtr<dynVCLHalf> pH(H);
+    return pH;
+}
+
+// [[Rcpp::export]]
+void
+cpp_hvclMatrix_to_fvcl(SEXP ptrH, SEXP ptrF, int device_flag)
+{
+    // define device type to use
+    if(device_flag == 0){
+        //use only GPUs
+        long id = 0;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::gpu_tag());
+        viennacl::ocl::switch_context(id);
+    }else{
+        // use only CPUs
+        long id = 1;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::cpu_tag());
+        viennacl::ocl::switch_context(id);
+    }
+
+    Rcpp::XPtr<dynVCLHalf> pH(ptrH);
+    Rcpp::XPtr<dynVCLMat<float> > pF(ptrF);
+    viennacl::matrix_range<viennacl::matrix<float> > vcl_F = pF->data();
+
+    vcl_from_half(pH->handle(), vcl_F.handle().opencl_handle(), vcl_matrix_layout(vcl_F));
+}
+
+// [[Rcpp::export]]
+void
+cpp_hvclVector_to_fvcl(SEXP ptrH, SEXP ptrF, int device_flag)
+{
+    // define device type to use
+    if(device_flag == 0){
+        //use only GPUs
+        long id = 0;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::gpu_tag());
+        viennacl::ocl::switch_context(id);
+    }else{
+        // use only CPUs
+        long id = 1;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::cpu_tag());
+        viennacl::ocl::switch_context(id);
+    }
+
+    Rcpp::XPtr<dynVCLHalf> pH(ptrH);
+    Rcpp::XPtr<dynVCLVec<float> > pF(ptrF);
+    viennacl::vector_range<viennacl::vector<float> > vcl_F = pF->data();
+
+    vcl_from_half(pH->handle(), vcl_F.handle().opencl_handle(), vcl_vector_layout(vcl_F));
+}
+
+// C <- A %*% B, computed in float tiles and rounded to half
+// [[Rcpp::export]]
+void
+cpp_hvcl_gemm(SEXP ptrA, SEXP ptrB, SEXP ptrC, int device_flag)
+{
+    // define device type to use
+    if(device_flag == 0){
+        //use only GPUs
+        long id = 0;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::gpu_tag());
+        viennacl::ocl::switch_context(id);
+    }else{
+        // use only CPUs
+        long id = 1;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::cpu_tag());
+        viennacl::ocl::switch_context(id);
+    }
+
+    Rcpp::XPtr<dynVCLHalf> pA(ptrA);
+    Rcpp::XPtr<dynVCLHalf> pB(ptrB);
+    Rcpp::XPtr<dynVCLHalf> pC(ptrC);
+
+    vcl_half_gemm(pA->handle(), pB->handle(), pC->handle(),
+                  pA->nrow(), pB->ncol(), pA->ncol());
+}
+
+// [[Rcpp::export]]
+void
+cpp_hvcl_elementwise(SEXP ptrA, SEXP ptrB, SEXP ptrC, int op, int device_flag)
+{
+    // define device type to use
+    if(device_flag == 0){
+        //use only GPUs
+        long id = 0;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::gpu_tag());
+        viennacl::ocl::switch_context(id);
+    }else{
+        // use only CPUs
+        long id = 1;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::cpu_tag());
+        viennacl::ocl::switch_context(id);
+    }
+
+    Rcpp::XPtr<dynVCLHalf> pA(ptrA);
+    Rcpp::XPtr<dynVCLHalf> pB(ptrB);
+    Rcpp::XPtr<dynVCLHalf> pC(ptrC);
+
+    vcl_half_elementwise(pA->handle(), pB->handle(), pC->handle(), pA->size(), op);
+}
+
+// [[Rcpp::export]]
+void
+cpp_hvcl_scalar(SEXP ptrA, double scalar, bool left, SEXP ptrC, int op, int device_flag)
+{
+    // define device type to use
+    if(device_flag == 0){
+        //use only GPUs
+        long id = 0;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::gpu_tag());
+        viennacl::ocl::switch_context(id);
+    }else{
+        // use only CPUs
+        long id = 1;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::cpu_tag());
+        viennacl::ocl::switch_context(id);
+    }
+
+    Rcpp::XPtr<dynVCLHalf> pA(ptrA);
+    Rcpp::XPtr<dynVCLHalf> pC(ptrC);
+
+    vcl_half_scalar(pA->handle(), (float)scalar, left, pC->handle(), pA->size(), op);
+}
+
+// S <- the row (byRow) or column sums of A, S a float vclVector
+// [[Rcpp::export]]
+void
+cpp_hvcl_margin_sums(SEXP ptrA, SEXP ptrS, bool byRow, int device_flag)
+{
+    // define device type to use
+    if(device_flag == 0){
+        //use only GPUs
+        long id = 0;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::gpu_tag());
+        viennacl::ocl::switch_context(id);
+    }else{
+        // use only CPUs
+        long id = 1;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::cpu_tag());
+        viennacl::ocl::switch_context(id);
+    }
+
+    Rcpp::XPtr<dynVCLHalf> pA(ptrA);
+    Rcpp::XPtr<dynVCLVec<float> > pS(ptrS);
+    viennacl::vector_range<viennacl::vector<float> > vcl_S = pS->data();
+
+    vcl_half_margin_sums(pA->handle(), pA->nrow(), pA->ncol(), byRow,
+                         vcl_S.handle().opencl_handle(), vcl_vector_layout(vcl_S));
+}
+
+// [[Rcpp::export]]
+double
+cpp_hvcl_sum(SEXP ptrA, int device_flag)
+{
+    // define device type to use
+    if(device_flag == 0){
+        //use only GPUs
+        long id = 0;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::gpu_tag());
+        viennacl::ocl::switch_context(id);
+    }else{
+        // use only CPUs
+        long id = 1;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::cpu_tag());
+        viennacl::ocl::switch_context(id);
+    }
+
+    Rcpp::XPtr<dynVCLHalf> pA(ptrA);
+    return vcl_half_sum(pA->handle(), pA->size());
+}
@@ -0,0 +1,147 @@
+#include "gpuR/windows_check.hpp"
+
+// eigen headers for handling the R input data
+#include <RcppEigen.h>
+
+#include "gpuR/dynVCLMat.hpp"
+#include "gpuR/dynVCLVec.hpp"
+#include "gpuR/vcl_inplace_kernels.hpp"
+
+// Use OpenCL with ViennaCL
+#define VIENNACL_WITH_OPENCL 1
+
+// ViennaCL headers
+#include "viennacl/ocl/device.hpp"
+#include "viennacl/ocl/platform.hpp"
+#include "viennacl/matrix.hpp"
+#include "viennacl/vector.hpp"
+
+using namespace Rcpp;
+
+/*** vclMatrix Templates ***/
+
+// C <- A op B or A op scalar, C may be A or B
+template <typename T>
+void
+cpp_vclMatrix_elementwise(
+    SEXP ptrA_, SEXP ptrB_,
+    double scalar, bool use_scalar, int op,
+    SEXP ptrC_,
+    int device_flag)
+{
+    // define device type to use
+    if(device_flag == 0){
+        //use only GPUs
+        long id = 0;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::gpu_tag());
+        viennacl::ocl::switch_context(id);
+    }else{
+        // use only CPUs
+        long id = 1;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::cpu_tag());
+        viennacl::ocl::switch_context(id);
+    }
+    
+    Rcpp::XPtr<dynVCLMat<T> > ptrA(ptrA_);
+    Rcpp::XPtr<dynVCLMat<T> > ptrB(ptrB_);
+    Rcpp::XPtr<dynVCLMat<T> > ptrC(ptrC_);
+    
+    viennacl::matrix_range<viennacl::matrix<T> > vcl_A = ptrA->data();
+    viennacl::matrix_range<viennacl::matrix<T> > vcl_B = ptrB->data();
+    viennacl::matrix_range<viennacl::matrix<T> > vcl_C = ptrC->data();
+    
+    vcl_elementwise<T>(vcl_A.handle().opencl_handle(), vcl_matrix_layout(vcl_A),
+                       vcl_B.handle().opencl_handle(), vcl_matrix_layout(vcl_B),
+                       static_cast<T>(scalar), use_scalar, op,
+                       vcl_C.handle().opencl_handle(), vcl_matrix_layout(vcl_C));
+}
+
+/*** vclVector Templates ***/
+
+// C <- A op B or A op scalar, C may be A or B
+template <typename T>
+void
+cpp_vclVector_elementwise(
+    SEXP ptrA_, SEXP ptrB_,
+    double scalar, bool use_scalar, int op,
+    SEXP ptrC_,
+    int device_flag)
+{
+    // define device type to use
+    if(device_flag == 0){
+        //use only GPUs
+        long id = 0;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::gpu_tag());
+        viennacl::ocl::switch_context(id);
+    }else{
+        // use only CPUs
+        long id = 1;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::cpu_tag());
+        viennacl::ocl::switch_context(id);
+    }
+    
+    Rcpp::XPtr<dynVCLVec<T> > ptrA(ptrA_);
+    Rcpp::XPtr<dynVCLVec<T> > ptrB(ptrB_);
+    Rcpp::XPtr<dynVCLVec<T> > ptrC(ptrC_);
+    
+    viennacl::vector_range<viennacl::vector<T> > vcl_A = ptrA->data();
+    viennacl::vector_range<viennacl::vector<T> > vcl_B = ptrB->data();
+    viennacl::vector_range<viennacl::vector<T> > vcl_C = ptrC->data();
+    
+    vcl_elementwise<T>(vcl_A.handle().opencl_handle(), vcl_vector_layout(vcl_A),
+                       vcl_B.handle().opencl_handle(), vcl_vector_layout(vcl_B),
+                       static_cast<T>(scalar), use_scalar, op,
+                       vcl_C.handle().opencl_handle(), vcl_vector_layout(vcl_C));
+}
+
+/*** vclMatrix Functions ***/
+
+// [[Rcpp::export]]
+void
+cpp_vclMatrix_elementwise(
+    SEXP ptrA, SEXP ptrB,
+    double scalar, bool use_scalar, int op,
+    SEXP ptrC,
+    int device_flag,
+    const int type_flag)
+{
+    switch(type_flag) {
+        case 4:
+            cpp_vclMatrix_elementwise<int>(ptrA, ptrB, scalar, use_scalar, op, ptrC, device_flag);
+            return;
+        case 6:
+            cpp_vclMatrix_elementwise<float>(ptrA, ptrB, scalar, use_scalar, op, ptrC, device_flag);
+            return;
+        case 8:
+            cpp_vclMatrix_elementwise<double>(ptrA, ptrB, scalar, use_scalar, op, ptrC, device_flag);
+            return;
+        default:
+            throw Rcpp::exception("unknown type detected for vclMatrix object!");
+    }
+}
+
+/*** vclVector Functions ***/
+
+// [[Rcpp::export]]
+void
+cpp_vclVector_elementwise(
+    SEXP ptrA, SEXP ptrB,
+    double scalar, bool use_scalar, int op,
+    SEXP ptrC,
+    int device_flag,
+    const int type_flag)
+{
+    switch(type_flag) {
+        case 4:
+            cpp_vclVector_elementwise<int>(ptrA, ptrB, scalar, use_scalar, op, ptrC, device_flag);
+            return;
+        case 6:
+            cpp_vclVector_elementwise<float>(ptrA, ptrB, scalar, use_scalar, op, ptrC, device_flag);
+            return;
+        case 8:
+            cpp_vclVector_elementwise<double>(ptrA, ptrB, scalar, use_scalar, op, ptrC, device_flag);
+            return;
+        default:
+            throw Rcpp::exception("unknown type detected for vclVector object!");
+    }
+}
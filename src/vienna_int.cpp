@@ -0,0 +1,369 @@
+#include "gpuR/windows_check.hpp"
+
+// eigen headers for handling the R input data
+#include <RcppEigen.h>
+
+#include "gpuR/dynEigenMat.hpp"
+#include "gpuR/dynEigenVec.hpp"
+#include "gpuR/dynVCLMat.hpp"
+#include "gpuR/dynVCLVec.hpp"
+#include "gpuR/vcl_int_kernels.hpp"
+
+// Use OpenCL with ViennaCL
+#define VIENNACL_WITH_OPENCL 1
+
+// Use ViennaCL algorithms on Eigen objects
+#define VIENNACL_WITH_EIGEN 1
+
+// ViennaCL headers
+#include "viennacl/ocl/device.hpp"
+#include "viennacl/ocl/platform.hpp"
+#include "viennacl/matrix.hpp"
+#include "viennacl/vector.hpp"
+
+using namespace Rcpp;
+
+/*** gpuMatrix Templates ***/
+
+// C <- A op B or A op scalar (scalar op A when left)
+template <typename T>
+bool
+cpp_gpuMatrix_int_arith(
+    SEXP ptrA_, SEXP ptrB_,
+    double scalar, bool use_scalar, bool left, int op,
+    SEXP ptrC_,
+    int device_flag)
+{
+    // define device type to use
+    if(device_flag == 0){
+        //use only GPUs
+        long id = 0;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::gpu_tag());
+        viennacl::ocl::switch_context(id);
+    }else{
+        // use only CPUs
+        long id = 1;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::cpu_tag());
+        viennacl::ocl::switch_context(id);
+    }
+
+    XPtr<dynEigenMat<T> > ptrA(ptrA_);
+    XPtr<dynEigenMat<T> > ptrC(ptrC_);
+
+    viennacl::matrix<T> vcl_A = ptrA->device_data();
+    viennacl::matrix<T> vcl_C(vcl_A.size1(), vcl_A.size2());
+
+    bool overflow;
+
+    if(use_scalar){
+        overflow = vcl_int_arith<T>(vcl_A.handle().opencl_handle(), vcl_matrix_layout(vcl_A),
+                                    vcl_A.handle().opencl_handle(), vcl_matrix_layout(vcl_A),
+                                    static_cast<T>(scalar), true, left, op,
+                                    vcl_C.handle().opencl_handle(), vcl_matrix_layout(vcl_C));
+    }else{
+        XPtr<dynEigenMat<T> > ptrB(ptrB_);
+        viennacl::matrix<T> vcl_B = ptrB->device_data();
+
+        overflow = vcl_int_arith<T>(vcl_A.handle().opencl_handle(), vcl_matrix_layout(vcl_A),
+                                    vcl_B.handle().opencl_handle(), vcl_matrix_layout(vcl_B),
+                                    T(0), false, left, op,
+                                    vcl_C.handle().opencl_handle(), vcl_matrix_layout(vcl_C));
+    }
+
+    ptrC->to_host(vcl_C);
+
+    return overflow;
+}
+
+// C <- op(A) op(B), op transposing when transA/transB
+template <typename T>
+bool
+cpp_gpuMatrix_int_gemm(
+    SEXP ptrA_, SEXP ptrB_, SEXP ptrC_,
+    bool transA, bool transB,
+    int device_flag)
+{
+    // define device type to use
+    if(device_flag == 0){
+        //use only GPUs
+        long id = 0;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::gpu_tag());
+        viennacl::ocl::switch_context(id);
+    }else{
+        // use only CPUs
+        long id = 1;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::cpu_tag());
+        viennacl::ocl::switch_context(id);
+    }
+
+    XPtr<dynEigenMat<T> > ptrA(ptrA_);
+    XPtr<dynEigenMat<T> > ptrB(ptrB_);
+    XPtr<dynEigenMat<T> > ptrC(ptrC_);
+
+    viennacl::matrix<T> vcl_A = ptrA->device_data();
+    viennacl::matrix<T> vcl_B = ptrB->device_data();
+
+    vclLayout la = vcl_matrix_layout(vcl_A);
+    vclLayout lb = vcl_matrix_layout(vcl_B);
+    if(transA) la = vcl_transpose_layout(la);
+    if(transB) lb = vcl_transpose_layout(lb);
+
+    viennacl::matrix<T> vcl_C(la.size1, lb.size2);
+
+    const bool overflow = vcl_int_gemm<T>(vcl_A.handle().opencl_handle(), la,
+                                          vcl_B.handle().opencl_handle(), lb,
+                                          vcl_C.handle().opencl_handle(), vcl_matrix_layout(vcl_C));
+
+    ptrC->to_host(vcl_C);
+
+    return overflow;
+}
+
+// S <- rowSums(A), colSums(A) when cols
+template <typename T>
+bool
+cpp_gpuMatrix_int_sums(
+    SEXP ptrA_, SEXP ptrS_,
+    bool cols,
+    int device_flag)
+{
+    // define device type to use
+    if(device_flag == 0){
+        //use only GPUs
+        long id = 0;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::gpu_tag());
+        viennacl::ocl::switch_context(id);
+    }else{
+        // use only CPUs
+        long id = 1;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::cpu_tag());
+        viennacl::ocl::switch_context(id);
+    }
+
+    XPtr<dynEigenMat<T> > ptrA(ptrA_);
+    XPtr<dynEigenVec<T> > ptrS(ptrS_);
+
+    viennacl::matrix<T> vcl_A = ptrA->device_data();
+    Eigen::Map<Eigen::Matrix<T, Eigen::Dynamic, 1> > sums = ptrS->data();
+
+    viennacl::vector<T> vcl_S(cols ? vcl_A.size2() : vcl_A.size1());
+
+    const bool overflow = vcl_int_sums<T>(vcl_A.handle().opencl_handle(), vcl_matrix_layout(vcl_A),
+                                          vcl_S.handle().opencl_handle(), vcl_vector_layout(vcl_S),
+                                          cols);
+
+    viennacl::copy(vcl_S, sums);
+
+    return overflow;
+}
+
+/*** vclMatrix Templates ***/
+
+// C <- A op B or A op scalar (scalar op A when left), C may be A or B
+template <typename T>
+bool
+cpp_vclMatrix_int_arith(
+    SEXP ptrA_, SEXP ptrB_,
+    double scalar, bool use_scalar, bool left, int op,
+    SEXP ptrC_,
+    int device_flag)
+{
+    // define device type to use
+    if(device_flag == 0){
+        //use only GPUs
+        long id = 0;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::gpu_tag());
+        viennacl::ocl::switch_context(id);
+    }else{
+        // use only CPUs
+        long id = 1;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::cpu_tag());
+        viennacl::ocl::switch_context(id);
+    }
+
+    XPtr<dynVCLMat<T> > ptrA(ptrA_);
+    XPtr<dynVCLMat<T> > ptrB(ptrB_);
+    XPtr<dynVCLMat<T> > ptrC(ptrC_);
+
+    viennacl::matrix_range<viennacl::matrix<T> > vcl_A = ptrA->data();
+    viennacl::matrix_range<viennacl::matrix<T> > vcl_B = ptrB->data();
+    viennacl::matrix_range<viennacl::matrix<T> > vcl_C = ptrC->data();
+
+    return vcl_int_arith<T>(vcl_A.handle().opencl_handle(), vcl_matrix_layout(vcl_A),
+                            vcl_B.handle().opencl_handle(), vcl_matrix_layout(vcl_B),
+                            static_cast<T>(scalar), use_scalar, left, op,
+                            vcl_C.handle().opencl_handle(), vcl_matrix_layout(vcl_C));
+}
+
+// C <- op(A) op(B), op transposing when transA/transB
+template <typename T>
+bool
+cpp_vclMatrix_int_gemm(
+    SEXP ptrA_, SEXP ptrB_, SEXP ptrC_,
+    bool transA, bool transB,
+    int device_flag)
+{
+    // define device type to use
+    if(device_flag == 0){
+        //use only GPUs
+        long id = 0;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::gpu_tag());
+        viennacl::ocl::switch_context(id);
+    }else{
+        // use only CPUs
+        long id = 1;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::cpu_tag());
+        viennacl::ocl::switch_context(id);
+    }
+
+    XPtr<dynVCLMat<T> > ptrA(ptrA_);
+    XPtr<dynVCLMat<T> > ptrB(ptrB_);
+    XPtr<dynVCLMat<T> > ptrC(ptrC_);
+
+    viennacl::matrix_range<viennacl::matrix<T> > vcl_A = ptrA->data();
+    viennacl::matrix_range<viennacl::matrix<T> > vcl_B = ptrB->data();
+    viennacl::matrix_range<viennacl::matrix<T> > vcl_C = ptrC->data();
+
+    vclLayout la = vcl_matrix_layout(vcl_A);
+    vclLayout lb = vcl_matrix_layout(vcl_B);
+    if(transA) la = vcl_transpose_layout(la);
+    if(transB) lb = vcl_transpose_layout(lb);
+
+    return vcl_int_gemm<T>(vcl_A.handle().opencl_handle(), la,
+                           vcl_B.handle().opencl_handle(), lb,
+                           vcl_C.handle().opencl_handle(), vcl_matrix_layout(vcl_C));
+}
+
+// S <- rowSums(A), colSums(A) when cols
+template <typename T>
+bool
+cpp_vclMatrix_int_sums(
+    SEXP ptrA_, SEXP ptrS_,
+    bool cols,
+    int device_flag)
+{
+    // define device type to use
+    if(device_flag == 0){
+        //use only GPUs
+        long id = 0;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::gpu_tag());
+        viennacl::ocl::switch_context(id);
+    }else{
+        // use only CPUs
+        long id = 1;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::cpu_tag());
+        viennacl::ocl::switch_context(id);
+    }
+
+    XPtr<dynVCLMat<T> > ptrA(ptrA_);
+    XPtr<dynVCLVec<T> > ptrS(ptrS_);
+
+    viennacl::matrix_range<viennacl::matrix<T> > vcl_A = ptrA->data();
+    viennacl::vector_range<viennacl::vector<T> > vcl_S = ptrS->data();
+
+    return vcl_int_sums<T>(vcl_A.handle().opencl_handle(), vcl_matrix_layout(vcl_A),
+                           vcl_S.handle().opencl_handle(), vcl_vector_layout(vcl_S),
+                           cols);
+}
+
+/*** gpuMatrix Functions ***/
+
+// [[Rcpp::export]]
+bool
+cpp_gpuMatrix_int_arith(
+    SEXP ptrA, SEXP ptrB,
+    double scalar, bool use_scalar, bool left, int op,
+    SEXP ptrC,
+    int device_flag,
+    const int type_flag)
+{
+    switch(type_flag) {
+        case 4:
+            return cpp_gpuMatrix_int_arith<int>(ptrA, ptrB, scalar, use_scalar, left, op, ptrC, device_flag);
+        default:
+            throw Rcpp::exception("unknown type detected for gpuMatrix object!");
+    }
+}
+
+// [[Rcpp::export]]
+bool
+cpp_gpuMatrix_int_gemm(
+    SEXP ptrA, SEXP ptrB, SEXP ptrC,
+    bool transA, bool transB,
+    int device_flag,
+    const int type_flag)
+{
+    switch(type_flag) {
+        case 4:
+            return cpp_gpuMatrix_int_gemm<int>(ptrA, ptrB, ptrC, transA, transB, device_flag);
+        default:
+            throw Rcpp::exception("unknown type detected for gpuMatrix object!");
+    }
+}
+
+// [[Rcpp::export]]
+bool
+cpp_gpuMatrix_int_sums(
+    SEXP ptrA, SEXP ptrS,
+    bool cols,
+    int device_flag,
+    const int type_flag)
+{
+    switch(type_flag) {
+        case 4:
+            return cpp_gpuMatrix_int_sums<int>(ptrA, ptrS, cols, device_flag);
+        default:
+            throw Rcpp::exception("unknown type detected for gpuMatrix object!");
+    }
+}
+
+/*** vclMatrix Functions ***/
+
+// [[Rcpp::export]]
+bool
+cpp_vclMatrix_int_arith(
+    SEXP ptrA, SEXP ptrB,
+    double scalar, bool use_scalar, bool left, int op,
+    SEXP ptrC,
+    int device_flag,
+    const int type_flag)
+{
+    switch(type_flag) {
+        case 4:
+            return cpp_vclMatrix_int_arith<int>(ptrA, ptrB, scalar, use_scalar, left, op, ptrC, device_flag);
+        default:
+            throw Rcpp::exception("unknown type detected for vclMatrix object!");
+    }
+}
+
+// [[Rcpp::export]]
+bool
+cpp_vclMatrix_int_gemm(
+    SEXP ptrA, SEXP ptrB, SEXP ptrC,
+    bool transA, bool transB,
+    int device_flag,
+    const int type_flag)
+{
+    switch(type_flag) {
+        case 4:
+            return cpp_vclMatrix_int_gemm<int>(ptrA, ptrB, ptrC, transA, transB, device_flag);
+        default:
+            throw Rcpp::exception("unknown type detected for vclMatrix object!");
+    }
+}
+
+// [[Rcpp::export]]
+bool
+cpp_vclMatrix_int_sums(
+    SEXP ptrA, SEXP ptrS,
+    bool cols,
+    int device_flag,
+    const int type_flag)
+{
+    switch(type_flag) {
+        case 4:
+            return cpp_vclMatrix_int_sums<int>(ptrA, ptrS, cols, device_flag);
+        default:
+            throw Rcpp::exception("unknown type detected for vclMatrix object!");
+    }
+}
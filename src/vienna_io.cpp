@@ -0,0 +1,277 @@
+#include "gpuR/windows_check.hpp"
+
+// eigen headers for handling the R input data
+#include <RcppEigen.h>
+
+#include "gpuR/dynEigenMat.hpp"
+#include "gpuR/dynVCLMat.hpp"
+#include "gpuR/matrix_file.hpp"
+#include "gpuR/vcl_rect_copy.hpp"
+#include "gpuR/trace_helpers.hpp"
+
+// Use OpenCL with ViennaCL
+#define VIENNACL_WITH_OPENCL 1
+
+// ViennaCL headers
+#include "viennacl/matrix.hpp"
+#include "viennacl/matrix_proxy.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <vector>
+
+using namespace Rcpp;
+
+// columns of an nr row matrix staged per transfer
+template <typename T>
+static size_t
+file_panel(size_t nr)
+{
+    return std::max<size_t>(1, matrix_file_chunk() / (sizeof(T) * std::max<size_t>(1, nr)));
+}
+
+static void
+open_matrix_file(std::ofstream &out, const std::string &file)
+{
+    out.open(file.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    if(!out){
+        throw Rcpp::exception(("cannot open file '" + file + "' for writing").c_str());
+    }
+}
+
+static void
+check_matrix_file(const matrixFileHeader &h, int type_flag, size_t nr, size_t nc)
+{
+    if(h.type_flag != type_flag){
+        throw Rcpp::exception("matrix file type does not match the matrix");
+    }
+    if(h.nrow != nr || h.ncol != nc){
+        throw Rcpp::exception("matrix file dimensions do not match the matrix");
+    }
+}
+
+/*** gpuMatrix Templates ***/
+
+// file <- A, straight from the host storage
+template <typename T>
+void
+cpp_gpuMatrix_save(SEXP ptrA_, std::string file, int type_flag)
+{
+    XPtr<dynEigenMat<T> > ptrA(ptrA_);
+
+    Eigen::Ref<Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> > A = ptrA->data();
+
+    const size_t M = A.rows();
+    const size_t N = A.cols();
+
+    traceScope span("gpuMatrix save", (double)M * N * sizeof(T));
+
+    std::ofstream out;
+    open_matrix_file(out, file);
+    matrix_file_write_header(out, type_flag, M, N);
+
+    if(A.outerStride() == A.rows()){
+        out.write(reinterpret_cast<const char *>(A.data()), sizeof(T) * M * N);
+    }else{
+        for(size_t j = 0; j < N; j++){
+            out.write(reinterpret_cast<const char *>(A.data() + j * A.outerStride()), sizeof(T) * M);
+        }
+    }
+
+    if(!out){
+        throw Rcpp::exception(("error writing file '" + file + "'").c_str());
+    }
+}
+
+// A <- file, copied from the mapping into the host storage
+template <typename T>
+void
+cpp_gpuMatrix_load(SEXP ptrA_, std::string file, int type_flag)
+{
+    XPtr<dynEigenMat<T> > ptrA(ptrA_);
+
+    mappedFile map(file);
+    const matrixFileHeader h = map.header();
+
+    ptrA->detach();
+    Eigen::Ref<Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> > A = ptrA->data();
+
+    const size_t M = A.rows();
+    const size_t N = A.cols();
+    check_matrix_file(h, type_flag, M, N);
+
+    traceScope span("gpuMatrix load", (double)M * N * sizeof(T));
+
+    const T *src = reinterpret_cast<const T *>(map.data() + GPUR_FILE_HEADER);
+    for(size_t j = 0; j < N; j++){
+        std::copy(src + j * M, src + (j + 1) * M, A.data() + j * A.outerStride());
+    }
+}
+
+/*** vclMatrix Templates ***/
+
+// file <- A, streamed from the device in column panels
+template <typename T>
+void
+cpp_vclMatrix_save(SEXP ptrA_, std::string file, int type_flag)
+{
+    XPtr<dynVCLMat<T> > ptrA(ptrA_);
+
+    viennacl::matrix_range<viennacl::matrix<T> > vcl_A = ptrA->data();
+
+    const size_t M = vcl_A.size1();
+    const size_t N = vcl_A.size2();
+    const size_t panel = file_panel<T>(M);
+
+    traceScope span("vclMatrix save", (double)M * N * sizeof(T));
+
+    std::ofstream out;
+    open_matrix_file(out, file);
+    matrix_file_write_header(out, type_flag, M, N);
+
+    std::vector<T> staging(M * std::min(panel, N));
+
+    for(size_t j = 0; j < N; j += panel){
+        const size_t nc = std::min(panel, N - j);
+
+        viennacl::matrix_range<viennacl::matrix<T> > vcl_P =
+            viennacl::project(vcl_A, viennacl::range(0, M), viennacl::range(j, j + nc));
+
+        vcl_read_block(vcl_P, staging.data(), M);
+        out.write(reinterpret_cast<const char *>(staging.data()), sizeof(T) * M * nc);
+    }
+
+    if(!out){
+        throw Rcpp::exception(("error writing file '" + file + "'").c_str());
+    }
+}
+
+// A <- file, uploaded from the mapping in column panels
+template <typename T>
+void
+cpp_vclMatrix_load(SEXP ptrA_, std::string file, int type_flag)
+{
+    XPtr<dynVCLMat<T> > ptrA(ptrA_);
+
+    mappedFile map(file);
+    const matrixFileHeader h = map.header();
+
+    ptrA->detach();
+    viennacl::matrix_range<viennacl::matrix<T> > vcl_A = ptrA->data();
+
+    const size_t M = vcl_A.size1();
+    const size_t N = vcl_A.size2();
+    const size_t panel = file_panel<T>(M);
+    check_matrix_file(h, type_flag, M, N);
+
+    traceScope span("vclMatrix load", (double)M * N * sizeof(T));
+
+    const T *src = reinterpret_cast<const T *>(map.data() + GPUR_FILE_HEADER);
+
+    for(size_t j = 0; j < N; j += panel){
+        const size_t nc = std::min(panel, N - j);
+
+        viennacl::matrix_range<viennacl::matrix<T> > vcl_P =
+            viennacl::project(vcl_A, viennacl::range(0, M), viennacl::range(j, j + nc));
+
+        vcl_write_block(src + j * M, M, vcl_P);
+    }
+}
+
+/*** Exported functions ***/
+
+// [[Rcpp::export]]
+List
+cpp_matrix_file_header(std::string file)
+{
+    mappedFile map(file);
+    const matrixFileHeader h = map.header();
+
+    return List::create(Named("type_flag") = h.type_flag,
+                        Named("nrow") = (double)h.nrow,
+                        Named("ncol") = (double)h.ncol);
+}
+
+// [[Rcpp::export]]
+void
+cpp_gpuMatrix_save(
+    SEXP ptrA, std::string file,
+    const int type_flag)
+{
+    switch(type_flag) {
+        case 4:
+            cpp_gpuMatrix_save<int>(ptrA, file, type_flag);
+            return;
+        case 6:
+            cpp_gpuMatrix_save<float>(ptrA, file, type_flag);
+            return;
+        case 8:
+            cpp_gpuMatrix_save<double>(ptrA, file, type_flag);
+            return;
+        default:
+            throw Rcpp::exception("unknown type detected for gpuMatrix object!");
+    }
+}
+
+// [[Rcpp::export]]
+void
+cpp_gpuMatrix_load(
+    SEXP ptrA, std::string file,
+    const int type_flag)
+{
+    switch(type_flag) {
+        case 4:
+            cpp_gpuMatrix_load<int>(ptrA, file, type_flag);
+            return;
+        case 6:
+            cpp_gpuMatrix_load<float>(ptrA, file, type_flag);
+            return;
+        case 8:
+            cpp_gpuMatrix_load<double>(ptrA, file, type_flag);
+            return;
+        default:
+            throw Rcpp::exception("unknown type detected for gpuMatrix object!");
+    }
+}
+
+// [[Rcpp::export]]
+void
+cpp_vclMatrix_save(
+    SEXP ptrA, std::string file,
+    const int type_flag)
+{
+    switch(type_flag) {
+        case 4:
+            cpp_vclMatrix_save<int>(ptrA, file, type_flag);
+            return;
+        case 6:
+            cpp_vclMatrix_save<float>(ptrA, file, type_flag);
+            return;
+        case 8:
+            cpp_vclMatrix_save<double>(ptrA, file, type_flag);
+            return;
+        default:
+            throw Rcpp::exception("unknown type detected for vclMatrix object!");
+    }
+}
+
+// [[Rcpp::export]]
+void
+cpp_vclMatrix_load(
+    SEXP ptrA, std::string file,
+    const int type_flag)
+{
+    switch(type_flag) {
+        case 4:
+            cpp_vclMatrix_load<int>(ptrA, file, type_flag);
+            return;
+        case 6:
+            cpp_vclMatrix_load<float>(ptrA, file, type_flag);
+            return;
+        case 8:
+            cpp_vclMatrix_load<double>(ptrA, file, type_flag);
+            return;
+        default:
+            throw Rcpp::exception("unknown type detected for vclMatrix object!");
+    }
+}
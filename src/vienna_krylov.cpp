@@ -0,0 +1,283 @@
+#include "gpuR/windows_check.hpp"
+
+// eigen headers for handling the R input data
+#include <RcppEigen.h>
+
+#include "gpuR/dynVCLMat.hpp"
+#include "gpuR/dynVCLVec.hpp"
+#include "gpuR/dynVCLSpMat.hpp"
+
+// Use OpenCL with ViennaCL
+#define VIENNACL_WITH_OPENCL 1
+
+// ViennaCL headers
+#include "viennacl/ocl/device.hpp"
+#include "viennacl/ocl/platform.hpp"
+#include "viennacl/vector.hpp"
+#include "viennacl/matrix.hpp"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/cg.hpp"
+#include "viennacl/linalg/bicgstab.hpp"
+#include "viennacl/linalg/gmres.hpp"
+#include "viennacl/linalg/jacobi_precond.hpp"
+#include "viennacl/linalg/ilu.hpp"
+
+#include <vector>
+
+using namespace Rcpp;
+
+// Krylov methods
+#define GPUR_KRYLOV_CG 0
+#define GPUR_KRYLOV_BICGSTAB 1
+#define GPUR_KRYLOV_GMRES 2
+
+// preconditioners
+#define GPUR_PRECOND_NONE 0
+#define GPUR_PRECOND_JACOBI 1
+#define GPUR_PRECOND_ILU0 2
+
+struct krylovStats {
+    int iters;
+    double error;
+    std::vector<double> residuals;
+};
+
+// records each residual estimate the solver reports, never stops it
+template <typename VectorT, typename T>
+static bool
+krylov_monitor(VectorT const &, T residual, void *data)
+{
+    static_cast<std::vector<double> *>(data)->push_back(residual);
+    return false;
+}
+
+// diagonal scaling for a dense matrix, ViennaCL's own Jacobi
+// preconditioner only takes sparse matrices
+template <typename T>
+struct vclDenseJacobi {
+    viennacl::vector<T> d;
+
+    template <typename MatrixT>
+    vclDenseJacobi(const MatrixT &A) : d(viennacl::diag(A)) {}
+
+    void apply(viennacl::vector<T> &x) const {
+        x = viennacl::linalg::element_div(x, d);
+    }
+};
+
+template <typename SolverT, typename MatrixT, typename PrecondT, typename T>
+static void
+krylov_solve(
+    SolverT &solver,
+    const MatrixT &A, const viennacl::vector<T> &b, viennacl::vector<T> &x,
+    bool guess, const PrecondT &precond, krylovStats &stats)
+{
+    solver.set_monitor(krylov_monitor<viennacl::vector<T>, T>, &stats.residuals);
+    if(guess){
+        solver.set_initial_guess(x);
+    }
+
+    x = solver(A, b, precond);
+
+    stats.iters = solver.tag().iters();
+    stats.error = solver.tag().error();
+}
+
+// x <- solution of A x = b, x holds the initial guess if 'guess'
+template <typename T, typename MatrixT, typename PrecondT>
+static void
+krylov_method(
+    const MatrixT &A, const viennacl::vector<T> &b, viennacl::vector<T> &x,
+    bool guess, int method,
+    double tol, int maxit, int restart,
+    const PrecondT &precond, krylovStats &stats)
+{
+    typedef viennacl::vector<T> VectorT;
+
+    switch(method) {
+        case GPUR_KRYLOV_CG: {
+            viennacl::linalg::cg_solver<VectorT> solver(
+                viennacl::linalg::cg_tag(tol, maxit));
+            krylov_solve(solver, A, b, x, guess, precond, stats);
+            return;
+        }
+        case GPUR_KRYLOV_BICGSTAB: {
+            viennacl::linalg::bicgstab_solver<VectorT> solver(
+                viennacl::linalg::bicgstab_tag(tol, maxit, restart));
+            krylov_solve(solver, A, b, x, guess, precond, stats);
+            return;
+        }
+        case GPUR_KRYLOV_GMRES: {
+            viennacl::linalg::gmres_solver<VectorT> solver(
+                viennacl::linalg::gmres_tag(tol, maxit, restart));
+            krylov_solve(solver, A, b, x, guess, precond, stats);
+            return;
+        }
+        default:
+            throw Rcpp::exception("unknown iterative solver");
+    }
+}
+
+static List
+krylov_result(const krylovStats &stats)
+{
+    return List::create(_["iterations"] = stats.iters,
+                        _["error"] = stats.error,
+                        _["residuals"] = wrap(stats.residuals));
+}
+
+/*** vclMatrix/vclSparseMatrix Templates ***/
+
+template <typename T>
+List
+cpp_vclMatrix_krylov(
+    SEXP ptrA_, SEXP ptrB_, SEXP ptrX_,
+    bool guess, int method, int precond,
+    double tol, int maxit, int restart,
+    int device_flag)
+{
+    // define device type to use
+    if(device_flag == 0){
+        //use only GPUs
+        long id = 0;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::gpu_tag());
+        viennacl::ocl::switch_context(id);
+    }else{
+        // use only CPUs
+        long id = 1;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::cpu_tag());
+        viennacl::ocl::switch_context(id);
+    }
+
+    Rcpp::XPtr<dynVCLMat<T> > ptrA(ptrA_);
+    Rcpp::XPtr<dynVCLVec<T> > ptrB(ptrB_);
+    Rcpp::XPtr<dynVCLVec<T> > ptrX(ptrX_);
+
+    viennacl::matrix_range<viennacl::matrix<T> > vcl_A = ptrA->data();
+    viennacl::vector_range<viennacl::vector<T> > vcl_X = ptrX->data();
+    viennacl::vector<T> vcl_b = ptrB->data();
+    viennacl::vector<T> vcl_x = vcl_X;
+
+    krylovStats stats;
+
+    switch(precond) {
+        case GPUR_PRECOND_NONE:
+            krylov_method(vcl_A, vcl_b, vcl_x, guess, method, tol, maxit, restart,
+                          viennacl::linalg::no_precond(), stats);
+            break;
+        case GPUR_PRECOND_JACOBI:
+            krylov_method(vcl_A, vcl_b, vcl_x, guess, method, tol, maxit, restart,
+                          vclDenseJacobi<T>(vcl_A), stats);
+            break;
+        default:
+            throw Rcpp::exception("ILU0 preconditioning requires a vclSparseMatrix");
+    }
+
+    vcl_X = vcl_x;
+
+    return krylov_result(stats);
+}
+
+template <typename T>
+List
+cpp_vclSparseMatrix_krylov(
+    SEXP ptrA_, SEXP ptrB_, SEXP ptrX_,
+    bool guess, int method, int precond,
+    double tol, int maxit, int restart,
+    int device_flag)
+{
+    // define device type to use
+    if(device_flag == 0){
+        //use only GPUs
+        long id = 0;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::gpu_tag());
+        viennacl::ocl::switch_context(id);
+    }else{
+        // use only CPUs
+        long id = 1;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::cpu_tag());
+        viennacl::ocl::switch_context(id);
+    }
+
+    typedef viennacl::compressed_matrix<T> SparseT;
+
+    Rcpp::XPtr<dynVCLSpMat<T> > ptrA(ptrA_);
+    Rcpp::XPtr<dynVCLVec<T> > ptrB(ptrB_);
+    Rcpp::XPtr<dynVCLVec<T> > ptrX(ptrX_);
+
+    SparseT &vcl_A = ptrA->compressed();
+    viennacl::vector_range<viennacl::vector<T> > vcl_X = ptrX->data();
+    viennacl::vector<T> vcl_b = ptrB->data();
+    viennacl::vector<T> vcl_x = vcl_X;
+
+    krylovStats stats;
+
+    switch(precond) {
+        case GPUR_PRECOND_NONE:
+            krylov_method(vcl_A, vcl_b, vcl_x, guess, method, tol, maxit, restart,
+                          viennacl::linalg::no_precond(), stats);
+            break;
+        case GPUR_PRECOND_JACOBI:
+            krylov_method(vcl_A, vcl_b, vcl_x, guess, method, tol, maxit, restart,
+                          viennacl::linalg::jacobi_precond<SparseT>(vcl_A, viennacl::linalg::jacobi_tag()),
+                          stats);
+            break;
+        case GPUR_PRECOND_ILU0:
+            krylov_method(vcl_A, vcl_b, vcl_x, guess, method, tol, maxit, restart,
+                          viennacl::linalg::ilu0_precond<SparseT>(vcl_A, viennacl::linalg::ilu0_tag()),
+                          stats);
+            break;
+        default:
+            throw Rcpp::exception("unknown preconditioner");
+    }
+
+    vcl_X = vcl_x;
+
+    return krylov_result(stats);
+}
+
+
+/*** Exported functions ***/
+
+// [[Rcpp::export]]
+List
+cpp_vclMatrix_krylov(
+    SEXP ptrA, SEXP ptrB, SEXP ptrX,
+    bool guess, int method, int precond,
+    double tol, int maxit, int restart,
+    int device_flag,
+    const int type_flag)
+{
+    switch(type_flag) {
+        case 6:
+            return cpp_vclMatrix_krylov<float>(ptrA, ptrB, ptrX, guess, method, precond,
+                                               tol, maxit, restart, device_flag);
+        case 8:
+            return cpp_vclMatrix_krylov<double>(ptrA, ptrB, ptrX, guess, method, precond,
+                                                tol, maxit, restart, device_flag);
+        default:
+            throw Rcpp::exception("unknown type detected for vclMatrix object!");
+    }
+}
+
+// [[Rcpp::export]]
+List
+cpp_vclSparseMatrix_krylov(
+    SEXP ptrA, SEXP ptrB, SEXP ptrX,
+    bool guess, int method, int precond,
+    double tol, int maxit, int restart,
+    int device_flag,
+    const int type_flag)
+{
+    switch(type_flag) {
+        case 6:
+            return cpp_vclSparseMatrix_krylov<float>(ptrA, ptrB, ptrX, guess, method, precond,
+                                                     tol, maxit, restart, device_flag);
+        case 8:
+            return cpp_vclSparseMatrix_krylov<double>(ptrA, ptrB, ptrX, guess, method, precond,
+                                                      tol, maxit, restart, device_flag);
+        default:
+            throw Rcpp::exception("unknown type detected for vclSparseMatrix object!");
+    }
+}
@@ -0,0 +1,351 @@
+#include "gpuR/windows_check.hpp"
+
+// eigen headers for handling the R input data and the small projected
+// eigenproblems
+#include <RcppEigen.h>
+
+#include "gpuR/dynVCLMat.hpp"
+#include "gpuR/dynVCLVec.hpp"
+#include "gpuR/dynVCLSpMat.hpp"
+
+// Use OpenCL with ViennaCL
+#define VIENNACL_WITH_OPENCL 1
+
+// ViennaCL headers
+#include "viennacl/ocl/device.hpp"
+#include "viennacl/ocl/platform.hpp"
+#include "viennacl/vector.hpp"
+#include "viennacl/matrix.hpp"
+#include "viennacl/matrix_proxy.hpp"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/linalg/prod.hpp"
+
+// small device matrices to and from the host
+#include "gpuR/vcl_eigen_copy.hpp"
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+using namespace Rcpp;
+
+/* Extreme eigenpairs of a symmetric matrix by LOBPCG.
+ *
+ * The block X of m >= k vectors, its residuals R and the previous search
+ * directions P sit side by side in one n x 3m matrix S, their products
+ * with A in a second one AS, so the whole state is O(n m).  Each
+ * iteration applies A once to the m residuals, every other device
+ * operation is a product with an m x m or 3m x m matrix.  The projected
+ * Rayleigh-Ritz problem, at most 3m x 3m, is solved on the host.
+ */
+
+// A %*% in for a dense or sparse operator
+template <typename T>
+struct vclDenseOp {
+    viennacl::matrix_range<viennacl::matrix<T> > A;
+
+    vclDenseOp(const viennacl::matrix_range<viennacl::matrix<T> > &A_) : A(A_) {}
+
+    template <typename In, typename Out>
+    void operator()(const In &in, Out &out) const {
+        out = viennacl::linalg::prod(A, in);
+    }
+};
+
+template <typename T>
+struct vclSparseOp {
+    viennacl::compressed_matrix<T> &A;
+
+    vclSparseOp(viennacl::compressed_matrix<T> &A_) : A(A_) {}
+
+    template <typename In, typename Out>
+    void operator()(const In &in, Out &out) const {
+        out = viennacl::linalg::prod(A, in);
+    }
+};
+
+// C <- the coefficients of the m extreme Ritz vectors of the basis with
+// Gram matrix G and projection H, theta their Ritz values.  The basis is
+// orthonormalized through the eigen decomposition of its scaled Gram
+// matrix, directions it cannot resolve above 'drop' are discarded.
+// False if fewer than m directions are left.
+static bool
+rayleigh_ritz(
+    const Eigen::MatrixXd &G, const Eigen::MatrixXd &H,
+    int m, bool largest, double drop,
+    Eigen::MatrixXd &C, Eigen::VectorXd &theta)
+{
+    const int nb = G.rows();
+
+    Eigen::VectorXd d = G.diagonal().cwiseMax(std::numeric_limits<double>::min());
+    d = d.cwiseSqrt().cwiseInverse();
+
+    Eigen::MatrixXd Gs = d.asDiagonal() * G * d.asDiagonal();
+    Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> eg(Gs);
+    if(eg.info() != Eigen::Success) return false;
+
+    // eigenvalues ascending
+    const Eigen::VectorXd &s = eg.eigenvalues();
+    int first = 0;
+    while(first < nb && s(first) <= drop * s(nb - 1)) first++;
+    const int r = nb - first;
+    if(r < m) return false;
+
+    const Eigen::MatrixXd B = d.asDiagonal() * eg.eigenvectors().rightCols(r) *
+        s.tail(r).cwiseSqrt().cwiseInverse().asDiagonal();
+    const Eigen::MatrixXd Hs = B.transpose() * (0.5 * (H + H.transpose())) * B;
+
+    Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> eh(Hs);
+    if(eh.info() != Eigen::Success) return false;
+
+    C.resize(nb, m);
+    theta.resize(m);
+    for(int j = 0; j < m; j++){
+        const int c = largest ? r - 1 - j : j;
+        theta(j) = eh.eigenvalues()(c);
+        C.col(j) = B * eh.eigenvectors().col(c);
+    }
+    return true;
+}
+
+template <typename T>
+struct lobpcgState {
+    typedef viennacl::matrix_range<viennacl::matrix<T> > RangeT;
+
+    size_t n, m;
+    viennacl::matrix<T> S, AS, Xn, Pn;
+
+    lobpcgState(size_t n_, size_t m_) :
+        n(n_), m(m_), S(n_, 3 * m_), AS(n_, 3 * m_), Xn(n_, m_), Pn(n_, m_) {}
+
+    RangeT block(viennacl::matrix<T> &M, size_t b, size_t count = 1){
+        return RangeT(M, viennacl::range(0, n), viennacl::range(b * m, (b + count) * m));
+    }
+
+    // Rayleigh-Ritz over the first nb blocks of S
+    bool ritz(size_t nb, bool largest, double drop, Eigen::MatrixXd &C, Eigen::VectorXd &theta){
+        RangeT Su = block(S, 0, nb);
+        RangeT ASu = block(AS, 0, nb);
+
+        viennacl::matrix<T> G = viennacl::linalg::prod(viennacl::trans(Su), Su);
+        viennacl::matrix<T> H = viennacl::linalg::prod(viennacl::trans(Su), ASu);
+
+        return rayleigh_ritz(vcl_to_eigen<T>(G), vcl_to_eigen<T>(H), m, largest, drop, C, theta);
+    }
+
+    // X <- [X R P] C, P <- [R P] C[-X, ] and the same for AS
+    void update(viennacl::matrix<T> &M, size_t nb, viennacl::matrix<T> &vcl_C){
+        RangeT Cx(vcl_C, viennacl::range(0, m), viennacl::range(0, m));
+        RangeT X = block(M, 0);
+
+        if(nb > 1){
+            RangeT Cp(vcl_C, viennacl::range(m, nb * m), viennacl::range(0, m));
+            RangeT RP = block(M, 1, nb - 1);
+            RangeT P = block(M, 2);
+
+            Pn = viennacl::linalg::prod(RP, Cp);
+            Xn = viennacl::linalg::prod(X, Cx);
+            Xn += Pn;
+            P = Pn;
+        }else{
+            Xn = viennacl::linalg::prod(X, Cx);
+        }
+        X = Xn;
+    }
+};
+
+// k extreme eigenpairs of the symmetric operator A starting from the
+// block X0.  Returns the number of iterations, 'converged' counts the k
+// wanted pairs with a relative residual within tol.
+template <typename T, typename OpA>
+static int
+lobpcg(
+    const OpA &A, const viennacl::matrix_range<viennacl::matrix<T> > &X0,
+    int k, bool largest, double tol, int maxit,
+    std::vector<T> &values, lobpcgState<T> &st, int &converged)
+{
+    typedef typename lobpcgState<T>::RangeT RangeT;
+
+    const size_t m = st.m;
+    const double drop = 100 * std::numeric_limits<T>::epsilon();
+
+    RangeT X = st.block(st.S, 0);
+    RangeT R = st.block(st.S, 1);
+    RangeT AX = st.block(st.AS, 0);
+    RangeT AR = st.block(st.AS, 1);
+
+    X = X0;
+    A(X, AX);
+
+    Eigen::MatrixXd C;
+    Eigen::VectorXd theta;
+    size_t nb = 1;
+    int iter = 0;
+    converged = 0;
+
+    for(;;){
+        if(!st.ritz(nb, largest, drop, C, theta)){
+            // the search directions went linearly dependent, restart
+            // without them
+            if(nb < 3) break;
+            nb = 2;
+            if(!st.ritz(nb, largest, drop, C, theta)) break;
+        }
+
+        viennacl::matrix<T> vcl_C = vcl_from_eigen<T>(C);
+        st.update(st.S, nb, vcl_C);
+        st.update(st.AS, nb, vcl_C);
+
+        values.resize(m);
+        for(size_t j = 0; j < m; j++) values[j] = (T)theta(j);
+
+        // R <- AX - X diag(theta)
+        viennacl::matrix<T> L = vcl_from_eigen<T>(Eigen::MatrixXd(theta.asDiagonal()));
+        R = AX;
+        R -= viennacl::linalg::prod(X, L);
+
+        viennacl::matrix<T> RtR = viennacl::linalg::prod(viennacl::trans(R), R);
+        const Eigen::MatrixXd rr = vcl_to_eigen<T>(RtR);
+
+        converged = 0;
+        for(int j = 0; j < k; j++){
+            const double scale = std::max(std::fabs(theta(j)), std::numeric_limits<double>::min());
+            if(std::sqrt(std::max(rr(j, j), 0.0)) <= tol * scale) converged++;
+        }
+
+        if(converged == k || iter == maxit) break;
+
+        A(R, AR);
+        iter++;
+        nb = nb == 1 ? 2 : 3;
+    }
+
+    return iter;
+}
+
+template <typename T, typename OpA>
+static List
+lobpcg_solve(
+    const OpA &A, SEXP ptrX0_, SEXP ptrValues_, SEXP ptrVectors_,
+    int k, bool largest, double tol, int maxit)
+{
+    Rcpp::XPtr<dynVCLMat<T> > ptrX0(ptrX0_);
+    Rcpp::XPtr<dynVCLVec<T> > ptrValues(ptrValues_);
+    Rcpp::XPtr<dynVCLMat<T> > ptrVectors(ptrVectors_);
+
+    viennacl::matrix_range<viennacl::matrix<T> > vcl_X0 = ptrX0->data();
+    viennacl::vector_range<viennacl::vector<T> > vcl_values = ptrValues->data();
+    viennacl::matrix_range<viennacl::matrix<T> > vcl_vectors = ptrVectors->data();
+
+    lobpcgState<T> st(vcl_X0.size1(), vcl_X0.size2());
+    std::vector<T> values;
+    int converged;
+
+    const int iters = lobpcg(A, vcl_X0, k, largest, tol, maxit, values, st, converged);
+
+    values.resize(k);
+    viennacl::copy(values, vcl_values);
+    vcl_vectors = viennacl::project(st.S, viennacl::range(0, st.n), viennacl::range(0, k));
+
+    return List::create(_["iterations"] = iters,
+                        _["converged"] = converged);
+}
+
+/*** vclMatrix/vclSparseMatrix Templates ***/
+
+template <typename T>
+List
+cpp_vclMatrix_lobpcg(
+    SEXP ptrA_, SEXP ptrX0_, SEXP ptrValues_, SEXP ptrVectors_,
+    int k, bool largest, double tol, int maxit,
+    int device_flag)
+{
+    // define device type to use
+    if(device_flag == 0){
+        //use only GPUs
+        long id = 0;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::gpu_tag());
+        viennacl::ocl::switch_context(id);
+    }else{
+        // use only CPUs
+        long id = 1;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::cpu_tag());
+        viennacl::ocl::switch_context(id);
+    }
+
+    Rcpp::XPtr<dynVCLMat<T> > ptrA(ptrA_);
+
+    const vclDenseOp<T> A(ptrA->data());
+
+    return lobpcg_solve<T>(A, ptrX0_, ptrValues_, ptrVectors_, k, largest, tol, maxit);
+}
+
+template <typename T>
+List
+cpp_vclSparseMatrix_lobpcg(
+    SEXP ptrA_, SEXP ptrX0_, SEXP ptrValues_, SEXP ptrVectors_,
+    int k, bool largest, double tol, int maxit,
+    int device_flag)
+{
+    // define device type to use
+    if(device_flag == 0){
+        //use only GPUs
+        long id = 0;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::gpu_tag());
+        viennacl::ocl::switch_context(id);
+    }else{
+        // use only CPUs
+        long id = 1;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::cpu_tag());
+        viennacl::ocl::switch_context(id);
+    }
+
+    Rcpp::XPtr<dynVCLSpMat<T> > ptrA(ptrA_);
+
+    const vclSparseOp<T> A(ptrA->compressed());
+
+    return lobpcg_solve<T>(A, ptrX0_, ptrValues_, ptrVectors_, k, largest, tol, maxit);
+}
+
+
+/*** Exported functions ***/
+
+// [[Rcpp::export]]
+List
+cpp_vclMatrix_lobpcg(
+    SEXP ptrA, SEXP ptrX0, SEXP ptrValues, SEXP ptrVectors,
+    int k, bool largest, double tol, int maxit,
+    int device_flag,
+    const int type_flag)
+{
+    switch(type_flag) {
+        case 6:
+            return cpp_vclMatrix_lobpcg<float>(ptrA, ptrX0, ptrValues, ptrVectors,
+                                               k, largest, tol, maxit, device_flag);
+        case 8:
+            return cpp_vclMatrix_lobpcg<double>(ptrA, ptrX0, ptrValues, ptrVectors,
+                                                k, largest, tol, maxit, device_flag);
+        default:
+            throw Rcpp::exception("unknown type detected for vclMatrix object!");
+    }
+}
+
+// [[Rcpp::export]]
+List
+cpp_vclSparseMatrix_lobpcg(
+    SEXP ptrA, SEXP ptrX0, SEXP ptrValues, SEXP ptrVectors,
+    int k, bool largest, double tol, int maxit,
+    int device_flag,
+    const int type_flag)
+{
+    switch(type_flag) {
+        case 6:
+            return cpp_vclSparseMatrix_lobpcg<float>(ptrA, ptrX0, ptrValues, ptrVectors,
+                                                     k, largest, tol, maxit, device_flag);
+        case 8:
+            return cpp_vclSparseMatrix_lobpcg<double>(ptrA, ptrX0, ptrValues, ptrVectors,
+                                                      k, largest, tol, maxit, device_flag);
+        default:
+            throw Rcpp::exception("unknown type detected for vclSparseMatrix object!");
+    }
+}
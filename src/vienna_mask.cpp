@@ -0,0 +1,768 @@
+#include "gpuR/windows_check.hpp"
+
+// eigen headers for handling the R input data
+#include <RcppEigen.h>
+
+#include "gpuR/dynVCLMat.hpp"
+#include "gpuR/dynVCLVec.hpp"
+#include "gpuR/vcl_mask_kernels.hpp"
+
+// Use OpenCL with ViennaCL
+#define VIENNACL_WITH_OPENCL 1
+
+// ViennaCL headers
+#include "viennacl/ocl/device.hpp"
+#include "viennacl/ocl/platform.hpp"
+#include "viennacl/matrix.hpp"
+#include "viennacl/vector.hpp"
+
+using namespace Rcpp;
+
+/*** Helpers ***/
+
+// result of a predicate reduction as a named vector for R
+SEXP
+whereToSEXP(const vclWhere &out, const double total)
+{
+    return Rcpp::NumericVector::create(
+        Rcpp::Named("n") = out.n,
+        Rcpp::Named("na") = out.na,
+        Rcpp::Named("sum") = out.sum,
+        Rcpp::Named("total") = total);
+}
+
+// handle and layout of a vclVector of any type
+template <typename T>
+void
+vclVectorOutput(SEXP ptrC_, viennacl::ocl::handle<cl_mem> &C, vclLayout &lc)
+{
+    Rcpp::XPtr<dynVCLVec<T> > ptrC(ptrC_);
+    viennacl::vector_range<viennacl::vector<T> > vcl_C = ptrC->data();
+    C = vcl_C.handle().opencl_handle();
+    lc = vcl_vector_layout(vcl_C);
+}
+
+void
+vclVectorOutput(SEXP ptrC_, int type_flag, viennacl::ocl::handle<cl_mem> &C, vclLayout &lc)
+{
+    switch(type_flag) {
+        case 4:
+            vclVectorOutput<int>(ptrC_, C, lc);
+            return;
+        case 6:
+            vclVectorOutput<float>(ptrC_, C, lc);
+            return;
+        case 8:
+            vclVectorOutput<double>(ptrC_, C, lc);
+            return;
+        default:
+            throw Rcpp::exception("unknown type detected for vclVector object!");
+    }
+}
+
+/*** vclMatrix Templates ***/
+
+// C <- A op B, or A op scalar, as an integer mask
+template <typename T>
+void
+cpp_vclMatrix_compare(
+    SEXP ptrA_, SEXP ptrB_,
+    double scalar, bool use_scalar, int op,
+    SEXP ptrC_,
+    int device_flag)
+{
+    // define device type to use
+    if(device_flag == 0){
+        //use only GPUs
+        long id = 0;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::gpu_tag());
+        viennacl::ocl::switch_context(id);
+    }else{
+        // use only CPUs
+        long id = 1;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::cpu_tag());
+        viennacl::ocl::switch_context(id);
+    }
+    
+    Rcpp::XPtr<dynVCLMat<T> > ptrA(ptrA_);
+    Rcpp::XPtr<dynVCLMat<T> > ptrB(ptrB_);
+    Rcpp::XPtr<dynVCLMat<int> > ptrC(ptrC_);
+    
+    viennacl::matrix_range<viennacl::matrix<T> > vcl_A = ptrA->data();
+    viennacl::matrix_range<viennacl::matrix<T> > vcl_B = ptrB->data();
+    viennacl::matrix_range<viennacl::matrix<int> > vcl_C = ptrC->data();
+    
+    vcl_compare<T>(vcl_A.handle().opencl_handle(), vcl_matrix_layout(vcl_A),
+                   vcl_B.handle().opencl_handle(), vcl_matrix_layout(vcl_B),
+                   scalar, use_scalar, op,
+                   vcl_C.handle().opencl_handle(), vcl_matrix_layout(vcl_C));
+}
+
+// C <- A & B, A | B, or against a logical scalar
+template <typename T>
+void
+cpp_vclMatrix_logic(
+    SEXP ptrA_, SEXP ptrB_,
+    int scalar, bool use_scalar, int op,
+    SEXP ptrC_,
+    int device_flag)
+{
+    // define device type to use
+    if(device_flag == 0){
+        //use only GPUs
+        long id = 0;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::gpu_tag());
+        viennacl::ocl::switch_context(id);
+    }else{
+        // use only CPUs
+        long id = 1;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::cpu_tag());
+        viennacl::ocl::switch_context(id);
+    }
+    
+    Rcpp::XPtr<dynVCLMat<T> > ptrA(ptrA_);
+    Rcpp::XPtr<dynVCLMat<T> > ptrB(ptrB_);
+    Rcpp::XPtr<dynVCLMat<int> > ptrC(ptrC_);
+    
+    viennacl::matrix_range<viennacl::matrix<T> > vcl_A = ptrA->data();
+    viennacl::matrix_range<viennacl::matrix<T> > vcl_B = ptrB->data();
+    viennacl::matrix_range<viennacl::matrix<int> > vcl_C = ptrC->data();
+    
+    vcl_logic<T>(vcl_A.handle().opencl_handle(), vcl_matrix_layout(vcl_A),
+                 vcl_B.handle().opencl_handle(), vcl_matrix_layout(vcl_B),
+                 scalar, use_scalar, op,
+                 vcl_C.handle().opencl_handle(), vcl_matrix_layout(vcl_C));
+}
+
+// C <- !A
+template <typename T>
+void
+cpp_vclMatrix_not(
+    SEXP ptrA_, SEXP ptrC_,
+    int device_flag)
+{
+    // define device type to use
+    if(device_flag == 0){
+        //use only GPUs
+        long id = 0;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::gpu_tag());
+        viennacl::ocl::switch_context(id);
+    }else{
+        // use only CPUs
+        long id = 1;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::cpu_tag());
+        viennacl::ocl::switch_context(id);
+    }
+    
+    Rcpp::XPtr<dynVCLMat<T> > ptrA(ptrA_);
+    Rcpp::XPtr<dynVCLMat<int> > ptrC(ptrC_);
+    
+    viennacl::matrix_range<viennacl::matrix<T> > vcl_A = ptrA->data();
+    viennacl::matrix_range<viennacl::matrix<int> > vcl_C = ptrC->data();
+    
+    vcl_logic_not<T>(vcl_A.handle().opencl_handle(), vcl_matrix_layout(vcl_A),
+                     vcl_C.handle().opencl_handle(), vcl_matrix_layout(vcl_C));
+}
+
+// A[mask] as a new vclVector
+template <typename T>
+SEXP
+cpp_vclMatrix_compact(
+    SEXP ptrA_, SEXP ptrM_,
+    int device_flag)
+{
+    // define device type to use
+    if(device_flag == 0){
+        //use only GPUs
+        long id = 0;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::gpu_tag());
+        viennacl::ocl::switch_context(id);
+    }else{
+        // use only CPUs
+        long id = 1;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::cpu_tag());
+        viennacl::ocl::switch_context(id);
+    }
+    
+    Rcpp::XPtr<dynVCLMat<T> > ptrA(ptrA_);
+    Rcpp::XPtr<dynVCLMat<int> > ptrM(ptrM_);
+    
+    viennacl::matrix_range<viennacl::matrix<T> > vcl_A = ptrA->data();
+    viennacl::matrix_range<viennacl::matrix<int> > vcl_M = ptrM->data();
+    
+    vclCompactPlan plan;
+    const unsigned int total = vcl_compact_plan(vcl_M, vcl_matrix_layout(vcl_M), plan);
+    
+    dynVCLVec<T> *vec = new dynVCLVec<T>(total, device_flag);
+    viennacl::vector_range<viennacl::vector<T> > vcl_out = vec->data();
+    
+    if(total > 0){
+        vcl_compact_values<T>(vcl_A.handle().opencl_handle(), vcl_matrix_layout(vcl_A),
+                              vcl_M, vcl_matrix_layout(vcl_M), plan, vcl_out);
+    }
+    
+    Rcpp::XPtr<dynVCLVec<T> > pOut(vec);
+    return pOut;
+}
+
+// count, NA count and sum over A op scalar, no mask is allocated
+template <typename T>
+SEXP
+cpp_vclMatrix_where(
+    SEXP ptrA_, 
+    double scalar, int op, bool absolute,
+    int device_flag)
+{
+    // define device type to use
+    if(device_flag == 0){
+        //use only GPUs
+        long id = 0;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::gpu_tag());
+        viennacl::ocl::switch_context(id);
+    }else{
+        // use only CPUs
+        long id = 1;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::cpu_tag());
+        viennacl::ocl::switch_context(id);
+    }
+    
+    Rcpp::XPtr<dynVCLMat<T> > ptrA(ptrA_);
+    viennacl::matrix_range<viennacl::matrix<T> > vcl_A = ptrA->data();
+    
+    vclWhere out;
+    vcl_where_reduce<T>(vcl_A.handle().opencl_handle(), vcl_matrix_layout(vcl_A),
+                        scalar, op, absolute, out);
+    
+    return whereToSEXP(out, vcl_A.size1() * vcl_A.size2());
+}
+
+// row or column wise count, sum or mean over A op scalar
+template <typename T>
+void
+cpp_vclMatrix_where_margin(
+    SEXP ptrA_, 
+    double scalar, int op, bool absolute,
+    int what, bool na_rm, bool byRow,
+    SEXP ptrC_, int out_flag,
+    int device_flag)
+{
+    // define device type to use
+    if(device_flag == 0){
+        //use only GPUs
+        long id = 0;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::gpu_tag());
+        viennacl::ocl::switch_context(id);
+    }else{
+        // use only CPUs
+        long id = 1;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::cpu_tag());
+        viennacl::ocl::switch_context(id);
+    }
+    
+    Rcpp::XPtr<dynVCLMat<T> > ptrA(ptrA_);
+    viennacl::matrix_range<viennacl::matrix<T> > vcl_A = ptrA->data();
+    
+    viennacl::ocl::handle<cl_mem> C;
+    vclLayout lc;
+    vclVectorOutput(ptrC_, out_flag, C, lc);
+    
+    vcl_where_margin<T>(vcl_A.handle().opencl_handle(), vcl_matrix_layout(vcl_A),
+                        scalar, op, absolute, what, na_rm, byRow, C, lc);
+}
+
+/*** vclVector Templates ***/
+
+// C <- A op B, or A op scalar, as an integer mask
+template <typename T>
+void
+cpp_vclVector_compare(
+    SEXP ptrA_, SEXP ptrB_,
+    double scalar, bool use_scalar, int op,
+    SEXP ptrC_,
+    int device_flag)
+{
+    // define device type to use
+    if(device_flag == 0){
+        //use only GPUs
+        long id = 0;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::gpu_tag());
+        viennacl::ocl::switch_context(id);
+    }else{
+        // use only CPUs
+        long id = 1;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::cpu_tag());
+        viennacl::ocl::switch_context(id);
+    }
+    
+    Rcpp::XPtr<dynVCLVec<T> > ptrA(ptrA_);
+    Rcpp::XPtr<dynVCLVec<T> > ptrB(ptrB_);
+    Rcpp::XPtr<dynVCLVec<int> > ptrC(ptrC_);
+    
+    viennacl::vector_range<viennacl::vector<T> > vcl_A = ptrA->data();
+    viennacl::vector_range<viennacl::vector<T> > vcl_B = ptrB->data();
+    viennacl::vector_range<viennacl::vector<int> > vcl_C = ptrC->data();
+    
+    vcl_compare<T>(vcl_A.handle().opencl_handle(), vcl_vector_layout(vcl_A),
+                   vcl_B.handle().opencl_handle(), vcl_vector_layout(vcl_B),
+                   scalar, use_scalar, op,
+                   vcl_C.handle().opencl_handle(), vcl_vector_layout(vcl_C));
+}
+
+// C <- A & B, A | B, or against a logical scalar
+template <typename T>
+void
+cpp_vclVector_logic(
+    SEXP ptrA_, SEXP ptrB_,
+    int scalar, bool use_scalar, int op,
+    SEXP ptrC_,
+    int device_flag)
+{
+    // define device type to use
+    if(device_flag == 0){
+        //use only GPUs
+        long id = 0;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::gpu_tag());
+        viennacl::ocl::switch_context(id);
+    }else{
+        // use only CPUs
+        long id = 1;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::cpu_tag());
+        viennacl::ocl::switch_context(id);
+    }
+    
+    Rcpp::XPtr<dynVCLVec<T> > ptrA(ptrA_);
+    Rcpp::XPtr<dynVCLVec<T> > ptrB(ptrB_);
+    Rcpp::XPtr<dynVCLVec<int> > ptrC(ptrC_);
+    
+    viennacl::vector_range<viennacl::vector<T> > vcl_A = ptrA->data();
+    viennacl::vector_range<viennacl::vector<T> > vcl_B = ptrB->data();
+    viennacl::vector_range<viennacl::vector<int> > vcl_C = ptrC->data();
+    
+    vcl_logic<T>(vcl_A.handle().opencl_handle(), vcl_vector_layout(vcl_A),
+                 vcl_B.handle().opencl_handle(), vcl_vector_layout(vcl_B),
+                 scalar, use_scalar, op,
+                 vcl_C.handle().opencl_handle(), vcl_vector_layout(vcl_C));
+}
+
+// C <- !A
+template <typename T>
+void
+cpp_vclVector_not(
+    SEXP ptrA_, SEXP ptrC_,
+    int device_flag)
+{
+    // define device type to use
+    if(device_flag == 0){
+        //use only GPUs
+        long id = 0;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::gpu_tag());
+        viennacl::ocl::switch_context(id);
+    }else{
+        // use only CPUs
+        long id = 1;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::cpu_tag());
+        viennacl::ocl::switch_context(id);
+    }
+    
+    Rcpp::XPtr<dynVCLVec<T> > ptrA(ptrA_);
+    Rcpp::XPtr<dynVCLVec<int> > ptrC(ptrC_);
+    
+    viennacl::vector_range<viennacl::vector<T> > vcl_A = ptrA->data();
+    viennacl::vector_range<viennacl::vector<int> > vcl_C = ptrC->data();
+    
+    vcl_logic_not<T>(vcl_A.handle().opencl_handle(), vcl_vector_layout(vcl_A),
+                     vcl_C.handle().opencl_handle(), vcl_vector_layout(vcl_C));
+}
+
+// A[mask] as a new vclVector
+template <typename T>
+SEXP
+cpp_vclVector_compact(
+    SEXP ptrA_, SEXP ptrM_,
+    int device_flag)
+{
+    // define device type to use
+    if(device_flag == 0){
+        //use only GPUs
+        long id = 0;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::gpu_tag());
+        viennacl::ocl::switch_context(id);
+    }else{
+        // use only CPUs
+        long id = 1;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::cpu_tag());
+        viennacl::ocl::switch_context(id);
+    }
+    
+    Rcpp::XPtr<dynVCLVec<T> > ptrA(ptrA_);
+    Rcpp::XPtr<dynVCLVec<int> > ptrM(ptrM_);
+    
+    viennacl::vector_range<viennacl::vector<T> > vcl_A = ptrA->data();
+    viennacl::vector_range<viennacl::vector<int> > vcl_M = ptrM->data();
+    
+    vclCompactPlan plan;
+    const unsigned int total = vcl_compact_plan(vcl_M, vcl_vector_layout(vcl_M), plan);
+    
+    dynVCLVec<T> *vec = new dynVCLVec<T>(total, device_flag);
+    viennacl::vector_range<viennacl::vector<T> > vcl_out = vec->data();
+    
+    if(total > 0){
+        vcl_compact_values<T>(vcl_A.handle().opencl_handle(), vcl_vector_layout(vcl_A),
+                              vcl_M, vcl_vector_layout(vcl_M), plan, vcl_out);
+    }
+    
+    Rcpp::XPtr<dynVCLVec<T> > pOut(vec);
+    return pOut;
+}
+
+// count, NA count and sum over A op scalar, no mask is allocated
+template <typename T>
+SEXP
+cpp_vclVector_where(
+    SEXP ptrA_, 
+    double scalar, int op, bool absolute,
+    int device_flag)
+{
+    // define device type to use
+    if(device_flag == 0){
+        //use only GPUs
+        long id = 0;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::gpu_tag());
+        viennacl::ocl::switch_context(id);
+    }else{
+        // use only CPUs
+        long id = 1;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::cpu_tag());
+        viennacl::ocl::switch_context(id);
+    }
+    
+    Rcpp::XPtr<dynVCLVec<T> > ptrA(ptrA_);
+    viennacl::vector_range<viennacl::vector<T> > vcl_A = ptrA->data();
+    
+    vclWhere out;
+    vcl_where_reduce<T>(vcl_A.handle().opencl_handle(), vcl_vector_layout(vcl_A),
+                        scalar, op, absolute, out);
+    
+    return whereToSEXP(out, vcl_A.size());
+}
+
+/*** vclMatrix Functions ***/
+
+// [[Rcpp::export]]
+void
+cpp_vclMatrix_compare(
+    SEXP ptrA, SEXP ptrB,
+    double scalar, bool use_scalar, int op,
+    SEXP ptrC,
+    int device_flag,
+    const int type_flag)
+{
+    switch(type_flag) {
+        case 4:
+            cpp_vclMatrix_compare<int>(ptrA, ptrB, scalar, use_scalar, op, ptrC, device_flag);
+            return;
+        case 6:
+            cpp_vclMatrix_compare<float>(ptrA, ptrB, scalar, use_scalar, op, ptrC, device_flag);
+            return;
+        case 8:
+            cpp_vclMatrix_compare<double>(ptrA, ptrB, scalar, use_scalar, op, ptrC, device_flag);
+            return;
+        default:
+            throw Rcpp::exception("unknown type detected for vclMatrix object!");
+    }
+}
+
+// [[Rcpp::export]]
+void
+cpp_vclMatrix_logic(
+    SEXP ptrA, SEXP ptrB,
+    int scalar, bool use_scalar, int op,
+    SEXP ptrC,
+    int device_flag,
+    const int type_flag)
+{
+    switch(type_flag) {
+        case 4:
+            cpp_vclMatrix_logic<int>(ptrA, ptrB, scalar, use_scalar, op, ptrC, device_flag);
+            return;
+        case 6:
+            cpp_vclMatrix_logic<float>(ptrA, ptrB, scalar, use_scalar, op, ptrC, device_flag);
+            return;
+        case 8:
+            cpp_vclMatrix_logic<double>(ptrA, ptrB, scalar, use_scalar, op, ptrC, device_flag);
+            return;
+        default:
+            throw Rcpp::exception("unknown type detected for vclMatrix object!");
+    }
+}
+
+// [[Rcpp::export]]
+void
+cpp_vclMatrix_not(
+    SEXP ptrA, SEXP ptrC,
+    int device_flag,
+    const int type_flag)
+{
+    switch(type_flag) {
+        case 4:
+            cpp_vclMatrix_not<int>(ptrA, ptrC, device_flag);
+            return;
+        case 6:
+            cpp_vclMatrix_not<float>(ptrA, ptrC, device_flag);
+            return;
+        case 8:
+            cpp_vclMatrix_not<double>(ptrA, ptrC, device_flag);
+            return;
+        default:
+            throw Rcpp::exception("unknown type detected for vclMatrix object!");
+    }
+}
+
+// [[Rcpp::export]]
+SEXP
+cpp_vclMatrix_compact(
+    SEXP ptrA, SEXP ptrM,
+    int device_flag,
+    const int type_flag)
+{
+    switch(type_flag) {
+        case 4:
+            return cpp_vclMatrix_compact<int>(ptrA, ptrM, device_flag);
+        case 6:
+            return cpp_vclMatrix_compact<float>(ptrA, ptrM, device_flag);
+        case 8:
+            return cpp_vclMatrix_compact<double>(ptrA, ptrM, device_flag);
+        default:
+            throw Rcpp::exception("unknown type detected for vclMatrix object!");
+    }
+}
+
+// which(mask) as a new integer vclVector
+// [[Rcpp::export]]
+SEXP
+cpp_vclMatrix_which(
+    SEXP ptrM,
+    int device_flag)
+{
+    // define device type to use
+    if(device_flag == 0){
+        //use only GPUs
+        long id = 0;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::gpu_tag());
+        viennacl::ocl::switch_context(id);
+    }else{
+        // use only CPUs
+        long id = 1;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::cpu_tag());
+        viennacl::ocl::switch_context(id);
+    }
+    
+    Rcpp::XPtr<dynVCLMat<int> > ptrM_(ptrM);
+    viennacl::matrix_range<viennacl::matrix<int> > vcl_M = ptrM_->data();
+    
+    vclCompactPlan plan;
+    const unsigned int total = vcl_compact_plan(vcl_M, vcl_matrix_layout(vcl_M), plan);
+    
+    dynVCLVec<int> *vec = new dynVCLVec<int>(total, device_flag);
+    viennacl::vector_range<viennacl::vector<int> > vcl_out = vec->data();
+    
+    if(total > 0){
+        vcl_compact_index(vcl_M, vcl_matrix_layout(vcl_M), plan, vcl_out);
+    }
+    
+    Rcpp::XPtr<dynVCLVec<int> > pOut(vec);
+    return pOut;
+}
+
+// [[Rcpp::export]]
+SEXP
+cpp_vclMatrix_where(
+    SEXP ptrA, 
+    double scalar, int op, bool absolute,
+    int device_flag,
+    const int type_flag)
+{
+    switch(type_flag) {
+        case 4:
+            return cpp_vclMatrix_where<int>(ptrA, scalar, op, absolute, device_flag);
+        case 6:
+            return cpp_vclMatrix_where<float>(ptrA, scalar, op, absolute, device_flag);
+        case 8:
+            return cpp_vclMatrix_where<double>(ptrA, scalar, op, absolute, device_flag);
+        default:
+            throw Rcpp::exception("unknown type detected for vclMatrix object!");
+    }
+}
+
+// [[Rcpp::export]]
+void
+cpp_vclMatrix_where_margin(
+    SEXP ptrA, 
+    double scalar, int op, bool absolute,
+    int what, bool na_rm, bool byRow,
+    SEXP ptrC, int out_flag,
+    int device_flag,
+    const int type_flag)
+{
+    switch(type_flag) {
+        case 4:
+            cpp_vclMatrix_where_margin<int>(ptrA, scalar, op, absolute, what, na_rm, byRow, ptrC, out_flag, device_flag);
+            return;
+        case 6:
+            cpp_vclMatrix_where_margin<float>(ptrA, scalar, op, absolute, what, na_rm, byRow, ptrC, out_flag, device_flag);
+            return;
+        case 8:
+            cpp_vclMatrix_where_margin<double>(ptrA, scalar, op, absolute, what, na_rm, byRow, ptrC, out_flag, device_flag);
+            return;
+        default:
+            throw Rcpp::exception("unknown type detected for vclMatrix object!");
+    }
+}
+
+/*** vclVector Functions ***/
+
+// [[Rcpp::export]]
+void
+cpp_vclVector_compare(
+    SEXP ptrA, SEXP ptrB,
+    double scalar, bool use_scalar, int op,
+    SEXP ptrC,
+    int device_flag,
+    const int type_flag)
+{
+    switch(type_flag) {
+        case 4:
+            cpp_vclVector_compare<int>(ptrA, ptrB, scalar, use_scalar, op, ptrC, device_flag);
+            return;
+        case 6:
+            cpp_vclVector_compare<float>(ptrA, ptrB, scalar, use_scalar, op, ptrC, device_flag);
+            return;
+        case 8:
+            cpp_vclVector_compare<double>(ptrA, ptrB, scalar, use_scalar, op, ptrC, device_flag);
+            return;
+        default:
+            throw Rcpp::exception("unknown type detected for vclVector object!");
+    }
+}
+
+// [[Rcpp::export]]
+void
+cpp_vclVector_logic(
+    SEXP ptrA, SEXP ptrB,
+    int scalar, bool use_scalar, int op,
+    SEXP ptrC,
+    int device_flag,
+    const int type_flag)
+{
+    switch(type_flag) {
+        case 4:
+            cpp_vclVector_logic<int>(ptrA, ptrB, scalar, use_scalar, op, ptrC, device_flag);
+            return;
+        case 6:
+            cpp_vclVector_logic<float>(ptrA, ptrB, scalar, use_scalar, op, ptrC, device_flag);
+            return;
+        case 8:
+            cpp_vclVector_logic<double>(ptrA, ptrB, scalar, use_scalar, op, ptrC, device_flag);
+            return;
+        default:
+            throw Rcpp::exception("unknown type detected for vclVector object!");
+    }
+}
+
+// [[Rcpp::export]]
+void
+cpp_vclVector_not(
+    SEXP ptrA, SEXP ptrC,
+    int device_flag,
+    const int type_flag)
+{
+    switch(type_flag) {
+        case 4:
+            cpp_vclVector_not<int>(ptrA, ptrC, device_flag);
+            return;
+        case 6:
+            cpp_vclVector_not<float>(ptrA, ptrC, device_flag);
+            return;
+        case 8:
+            cpp_vclVector_not<double>(ptrA, ptrC, device_flag);
+            return;
+        default:
+            throw Rcpp::exception("unknown type detected for vclVector object!");
+    }
+}
+
+// [[Rcpp::export]]
+SEXP
+cpp_vclVector_compact(
+    SEXP ptrA, SEXP ptrM,
+    int device_flag,
+    const int type_flag)
+{
+    switch(type_flag) {
+        case 4:
+            return cpp_vclVector_compact<int>(ptrA, ptrM, device_flag);
+        case 6:
+            return cpp_vclVector_compact<float>(ptrA, ptrM, device_flag);
+        case 8:
+            return cpp_vclVector_compact<double>(ptrA, ptrM, device_flag);
+        default:
+            throw Rcpp::exception("unknown type detected for vclVector object!");
+    }
+}
+
+// which(mask) as a new integer vclVector
+// [[Rcpp::export]]
+SEXP
+cpp_vclVector_which(
+    SEXP ptrM,
+    int device_flag)
+{
+    // define device type to use
+    if(device_flag == 0){
+        //use only GPUs
+        long id = 0;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::gpu_tag());
+        viennacl::ocl::switch_context(id);
+    }else{
+        // use only CPUs
+        long id = 1;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::cpu_tag());
+        viennacl::ocl::switch_context(id);
+    }
+    
+    Rcpp::XPtr<dynVCLVec<int> > ptrM_(ptrM);
+    viennacl::vector_range<viennacl::vector<int> > vcl_M = ptrM_->data();
+    
+    vclCompactPlan plan;
+    const unsigned int total = vcl_compact_plan(vcl_M, vcl_vector_layout(vcl_M), plan);
+    
+    dynVCLVec<int> *vec = new dynVCLVec<int>(total, device_flag);
+    viennacl::vector_range<viennacl::vector<int> > vcl_out = vec->data();
+    
+    if(total > 0){
+        vcl_compact_index(vcl_M, vcl_vector_layout(vcl_M), plan, vcl_out);
+    }
+    
+    Rcpp::XPtr<dynVCLVec<int> > pOut(vec);
+    return pOut;
+}
+
+// [[Rcpp::export]]
+SEXP
+cpp_vclVector_where(
+    SEXP ptrA, 
+    double scalar, int op, bool absolute,
+    int device_flag,
+    const int type_flag)
+{
+    switch(type_flag) {
+        case 4:
+            return cpp_vclVector_where<int>(ptrA, scalar, op, absolute, device_flag);
+        case 6:
+            return cpp_vclVector_where<float>(ptrA, scalar, op, absolute, device_flag);
+        case 8:
+            return cpp_vclVector_where<double>(ptrA, scalar, op, absolute, device_flag);
+        default:
+            throw Rcpp::exception("unknown type detected for vclVector object!");
+    }
+}
@@ -0,0 +1,247 @@
+#include "gpuR/windows_check.hpp"
+
+// eigen headers for handling the R input data
+#include <RcppEigen.h>
+
+#include "gpuR/dynVCLMat.hpp"
+#include "gpuR/dynVCLVec.hpp"
+#include "gpuR/dynVCLSpMat.hpp"
+
+// Use OpenCL with ViennaCL
+#define VIENNACL_WITH_OPENCL 1
+
+// ViennaCL headers
+#include "viennacl/ocl/device.hpp"
+#include "viennacl/ocl/platform.hpp"
+#include "viennacl/vector.hpp"
+#include "viennacl/matrix.hpp"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/coordinate_matrix.hpp"
+#include "viennacl/linalg/prod.hpp"
+
+using namespace Rcpp;
+
+/*** vclSparseMatrix Templates ***/
+
+// y <- A %*% x or t(A) %*% x, x a dense vector or matrix
+template <typename T, typename DenseX, typename DenseY>
+static void
+vcl_sparse_prod(dynVCLSpMat<T> &A, bool trans, const DenseX &x, DenseY &y)
+{
+    if(trans){
+        y = viennacl::linalg::prod(A.trans(), x);
+    }else if(A.sparse_format() == GPUR_SPARSE_COO){
+        y = viennacl::linalg::prod(A.coo(), x);
+    }else{
+        y = viennacl::linalg::prod(A.csr(), x);
+    }
+}
+
+template <typename T>
+SEXP
+cpp_vclSparseMatrix(
+    SEXP i, SEXP p, SEXP x,
+    int nr, int nc,
+    int format,
+    int device_flag)
+{
+    dynVCLSpMat<T> *mat = new dynVCLSpMat<T>(i, p, x, nr, nc, format, device_flag);
+    Rcpp::XPtr<dynVCLSpMat<T> > pMat(mat);
+    return pMat;
+}
+
+template <typename T>
+IntegerVector
+cpp_vclSparseMatrix_dim(SEXP ptrA_)
+{
+    Rcpp::XPtr<dynVCLSpMat<T> > ptrA(ptrA_);
+    return IntegerVector::create(ptrA->nrow(), ptrA->ncol(), ptrA->nnz());
+}
+
+template <typename T>
+void
+cpp_vclSparseMatrix_vec_prod(
+    SEXP ptrA_, SEXP ptrB_, SEXP ptrC_,
+    bool trans,
+    int device_flag)
+{
+    // define device type to use
+    if(device_flag == 0){
+        //use only GPUs
+        long id = 0;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::gpu_tag());
+        viennacl::ocl::switch_context(id);
+    }else{
+        // use only CPUs
+        long id = 1;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::cpu_tag());
+        viennacl::ocl::switch_context(id);
+    }
+
+    Rcpp::XPtr<dynVCLSpMat<T> > ptrA(ptrA_);
+    Rcpp::XPtr<dynVCLVec<T> > ptrB(ptrB_);
+    Rcpp::XPtr<dynVCLVec<T> > ptrC(ptrC_);
+
+    viennacl::vector_range<viennacl::vector<T> > vcl_B = ptrB->data();
+    viennacl::vector_range<viennacl::vector<T> > vcl_C = ptrC->data();
+
+    vcl_sparse_prod(*ptrA, trans, vcl_B, vcl_C);
+}
+
+template <typename T>
+void
+cpp_vclSparseMatrix_mat_prod(
+    SEXP ptrA_, SEXP ptrB_, SEXP ptrC_,
+    bool trans,
+    int device_flag)
+{
+    // define device type to use
+    if(device_flag == 0){
+        //use only GPUs
+        long id = 0;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::gpu_tag());
+        viennacl::ocl::switch_context(id);
+    }else{
+        // use only CPUs
+        long id = 1;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::cpu_tag());
+        viennacl::ocl::switch_context(id);
+    }
+
+    Rcpp::XPtr<dynVCLSpMat<T> > ptrA(ptrA_);
+    Rcpp::XPtr<dynVCLMat<T> > ptrB(ptrB_);
+    Rcpp::XPtr<dynVCLMat<T> > ptrC(ptrC_);
+
+    viennacl::matrix_range<viennacl::matrix<T> > vcl_B = ptrB->data();
+    viennacl::matrix_range<viennacl::matrix<T> > vcl_C = ptrC->data();
+
+    vcl_sparse_prod(*ptrA, trans, vcl_B, vcl_C);
+}
+
+// row sums are A %*% 1 and column sums t(A) %*% 1
+template <typename T>
+void
+cpp_vclSparseMatrix_sums(
+    SEXP ptrA_, SEXP ptrC_,
+    bool rows,
+    int device_flag)
+{
+    // define device type to use
+    if(device_flag == 0){
+        //use only GPUs
+        long id = 0;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::gpu_tag());
+        viennacl::ocl::switch_context(id);
+    }else{
+        // use only CPUs
+        long id = 1;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::cpu_tag());
+        viennacl::ocl::switch_context(id);
+    }
+
+    Rcpp::XPtr<dynVCLSpMat<T> > ptrA(ptrA_);
+    Rcpp::XPtr<dynVCLVec<T> > ptrC(ptrC_);
+
+    viennacl::vector_range<viennacl::vector<T> > vcl_C = ptrC->data();
+
+    const int n = rows ? ptrA->ncol() : ptrA->nrow();
+    viennacl::vector<T> ones = viennacl::scalar_vector<T>(n, (T)(1));
+
+    vcl_sparse_prod(*ptrA, !rows, ones, vcl_C);
+}
+
+
+/*** Exported functions ***/
+
+// [[Rcpp::export]]
+SEXP
+cpp_vclSparseMatrix(
+    SEXP i, SEXP p, SEXP x,
+    int nr, int nc,
+    int format,
+    int device_flag,
+    const int type_flag)
+{
+    switch(type_flag) {
+        case 6:
+            return cpp_vclSparseMatrix<float>(i, p, x, nr, nc, format, device_flag);
+        case 8:
+            return cpp_vclSparseMatrix<double>(i, p, x, nr, nc, format, device_flag);
+        default:
+            throw Rcpp::exception("unknown type detected for vclSparseMatrix object!");
+    }
+}
+
+// [[Rcpp::export]]
+IntegerVector
+cpp_vclSparseMatrix_dim(SEXP ptrA, const int type_flag)
+{
+    switch(type_flag) {
+        case 6:
+            return cpp_vclSparseMatrix_dim<float>(ptrA);
+        case 8:
+            return cpp_vclSparseMatrix_dim<double>(ptrA);
+        default:
+            throw Rcpp::exception("unknown type detected for vclSparseMatrix object!");
+    }
+}
+
+// [[Rcpp::export]]
+void
+cpp_vclSparseMatrix_vec_prod(
+    SEXP ptrA, SEXP ptrB, SEXP ptrC,
+    bool trans,
+    int device_flag,
+    const int type_flag)
+{
+    switch(type_flag) {
+        case 6:
+            cpp_vclSparseMatrix_vec_prod<float>(ptrA, ptrB, ptrC, trans, device_flag);
+            return;
+        case 8:
+            cpp_vclSparseMatrix_vec_prod<double>(ptrA, ptrB, ptrC, trans, device_flag);
+            return;
+        default:
+            throw Rcpp::exception("unknown type detected for vclSparseMatrix object!");
+    }
+}
+
+// [[Rcpp::export]]
+void
+cpp_vclSparseMatrix_mat_prod(
+    SEXP ptrA, SEXP ptrB, SEXP ptrC,
+    bool trans,
+    int device_flag,
+    const int type_flag)
+{
+    switch(type_flag) {
+        case 6:
+            cpp_vclSparseMatrix_mat_prod<float>(ptrA, ptrB, ptrC, trans, device_flag);
+            return;
+        case 8:
+            cpp_vclSparseMatrix_mat_prod<double>(ptrA, ptrB, ptrC, trans, device_flag);
+            return;
+        default:
+            throw Rcpp::exception("unknown type detected for vclSparseMatrix object!");
+    }
+}
+
+// [[Rcpp::export]]
+void
+cpp_vclSparseMatrix_sums(
+    SEXP ptrA, SEXP ptrC,
+    bool rows,
+    int device_flag,
+    const int type_flag)
+{
+    switch(type_flag) {
+        case 6:
+            cpp_vclSparseMatrix_sums<float>(ptrA, ptrC, rows, device_flag);
+            return;
+        case 8:
+            cpp_vclSparseMatrix_sums<double>(ptrA, ptrC, rows, device_flag);
+            return;
+        default:
+            throw Rcpp::exception("unknown type detected for vclSparseMatrix object!");
+    }
+}
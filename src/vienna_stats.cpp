@@ -8,6 +8,8 @@
 #include "gpuR/dynEigenVec.hpp"
 #include "gpuR/dynVCLMat.hpp"
 #include "gpuR/dynVCLVec.hpp"
+#include "gpuR/vcl_reduce_kernels.hpp"
+#include "gpuR/vcl_stats_helpers.hpp"
 
 // Use OpenCL with ViennaCL
 #define VIENNACL_WITH_OPENCL 1
@@ -301,6 +303,36 @@ cpp_vclMatrix_rowsum(
     vcl_rowSums = viennacl::linalg::row_sum(vcl_A);
 }
 
+template <typename T>
+void 
+cpp_vclMatrix_margin_extreme(
+    SEXP ptrA_, SEXP ptrC_,
+    bool maximum,
+    bool byRow,
+    int device_flag)
+{
+    // define device type to use
+    if(device_flag == 0){
+        //use only GPUs
+        long id = 0;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::gpu_tag());
+        viennacl::ocl::switch_context(id);
+    }else{
+        // use only CPUs
+        long id = 1;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::cpu_tag());
+        viennacl::ocl::switch_context(id);
+    }
+    
+    Rcpp::XPtr<dynVCLMat<T> > ptrA(ptrA_);
+    Rcpp::XPtr<dynVCLVec<T> > pC(ptrC_);
+    
+    viennacl::vector_range<viennacl::vector<T> > vcl_C  = pC->data();
+    viennacl::matrix_range<viennacl::matrix<T> > vcl_A = ptrA->data();
+    
+    vcl_margin_reduce<T>(vcl_A, vcl_C, maximum ? GPUR_REDUCE_MAX : 0, byRow);
+}
+
 template <typename T>
 void 
 cpp_gpuMatrix_pmcc(
@@ -325,26 +357,9 @@ cpp_gpuMatrix_pmcc(
     XPtr<dynEigenMat<T> > ptrB(ptrB_);
     
     viennacl::matrix<T> vcl_A = ptrA->device_data();
+    viennacl::matrix<T> vcl_B(vcl_A.size2(), vcl_A.size2());
     
-    const int K = vcl_A.size1();
-    const int M = vcl_A.size2();
-    
-    viennacl::vector<T> ones = viennacl::scalar_vector<T>(K, 1);
-    viennacl::vector<T> vcl_meanVec(M);
-    viennacl::matrix<T> vcl_meanMat(K,M);
-    
-    // vector of column means
-    vcl_meanVec = viennacl::linalg::column_sum(vcl_A);
-    vcl_meanVec *= (T)(1)/(T)(K);
-    
-    // matrix of means
-    vcl_meanMat = viennacl::linalg::outer_prod(ones, vcl_meanVec);
-    
-    viennacl::matrix<T> tmp = vcl_A - vcl_meanMat;
-    
-    // calculate pearson covariance
-    viennacl::matrix<T> vcl_B = viennacl::linalg::prod(trans(tmp), tmp);
-    vcl_B *= (T)(1)/(T)(K-1);
+    vcl_pmcc<T>(vcl_A, vcl_B);
     
     ptrB->to_host(vcl_B);
 }
@@ -368,9 +383,6 @@ cpp_vclMatrix_pmcc(
         viennacl::ocl::set_context_device_type(id, viennacl::ocl::cpu_tag());
         viennacl::ocl::switch_context(id);
     }
-//    
-//    viennacl::matrix<T> &vcl_A = *ptrA;
-//    viennacl::matrix<T> &vcl_B = *ptrB;
     
     Rcpp::XPtr<dynVCLMat<T> > ptrA(ptrA_);
     Rcpp::XPtr<dynVCLMat<T> > ptrB(ptrB_);
@@ -378,25 +390,7 @@ cpp_vclMatrix_pmcc(
     viennacl::matrix_range<viennacl::matrix<T> > vcl_A = ptrA->data();
     viennacl::matrix_range<viennacl::matrix<T> > vcl_B = ptrB->data();
     
-    const int M = vcl_A.size2();
-    const int K = vcl_A.size1();
-    
-    viennacl::vector<T> ones = viennacl::scalar_vector<T>(K, 1);
-    viennacl::vector<T> vcl_meanVec(M);
-    viennacl::matrix<T> vcl_meanMat(K,M);
-    
-    // vector of column means
-    vcl_meanVec = viennacl::linalg::column_sum(vcl_A);
-    vcl_meanVec *= (T)(1)/(T)(K);
-    
-    // matrix of means
-    vcl_meanMat = viennacl::linalg::outer_prod(ones, vcl_meanVec);
-    
-    viennacl::matrix<T> tmp = vcl_A - vcl_meanMat;
-    
-    // calculate pearson covariance
-    vcl_B = viennacl::linalg::prod(trans(tmp), tmp);
-    vcl_B *= (T)(1)/(T)(K-1);
+    vcl_pmcc<T>(vcl_A, vcl_B);
 }
 
 
@@ -425,39 +419,9 @@ cpp_gpuMatrix_eucl(
     XPtr<dynEigenMat<T> > ptrD(ptrD_);
     
     viennacl::matrix<T> vcl_A = ptrA->device_data();
-    viennacl::matrix<T> vcl_D;
-    
-    // other temp objects
-    viennacl::matrix<T> twos;
-    viennacl::matrix<T> square_A;
-    
-    const int K = vcl_A.size1();
-      
-    // temp objects
-    viennacl::vector<T> row_ones = viennacl::scalar_vector<T>(K, 1);
-    viennacl::vector<T> vcl_sqrt = viennacl::zero_vector<T>(K);
-    
-    // this will definitely need to be updated with the next ViennaCL release
-    // currently doesn't support the single scalar operation with
-    // element_pow below
-    twos = viennacl::scalar_matrix<T>(K, K, 2);
-    
-    square_A = viennacl::linalg::element_pow(vcl_A, twos);
-    vcl_sqrt = viennacl::linalg::row_sum(square_A);
-    
-    vcl_D = viennacl::linalg::outer_prod(vcl_sqrt, row_ones);
+    viennacl::matrix<T> vcl_D(vcl_A.size1(), vcl_A.size1());
     
-    vcl_D += trans(vcl_D);
-    
-    vcl_D -= 2 * (viennacl::linalg::prod(vcl_A, trans(vcl_A)));
-    
-    if(!squareDist){
-        vcl_D = viennacl::linalg::element_sqrt(vcl_D);    
-    }
-    
-    for(unsigned int i=0; i < vcl_D.size1(); i++){
-        vcl_D(i,i) = 0;
-    }
+    vcl_eucl<T>(vcl_A, vcl_D, squareDist);
     
     ptrD->to_host(vcl_D);
 }
@@ -491,49 +455,11 @@ cpp_gpuMatrix_peucl(
     // copy to GPU
     viennacl::matrix<T> vcl_A = ptrA->device_data();
     viennacl::matrix<T> vcl_B = ptrB->device_data();
-    viennacl::matrix<T> vcl_D;
-    
-    const int M = vcl_A.size2();
-    const int K = vcl_A.size1();
-    const int R = vcl_B.size2();
-    const int Q = vcl_B.size1();
-    
-    viennacl::vector<T> A_row_ones = viennacl::scalar_vector<T>(K, 1);
-    viennacl::vector<T> B_row_ones = viennacl::scalar_vector<T>(Q, 1);
+    viennacl::matrix<T> vcl_D(vcl_A.size1(), vcl_B.size1());
     
-    viennacl::matrix<T> square_A;
-    viennacl::matrix<T> square_B;
-    
-    // this will definitely need to be updated with the next ViennaCL release
-    // currently doesn't support the single scalar operation with
-    // element_pow below
-    {
-        viennacl::matrix<T> twos = viennacl::scalar_matrix<T>(std::max(K, Q), std::max(M, R), 2);
-    
-        square_A = viennacl::linalg::element_pow(vcl_A, twos);
-        square_B = viennacl::linalg::element_pow(vcl_B, twos);
-    }
-    
-    {
-        viennacl::vector<T> vcl_A_rowsum = viennacl::zero_vector<T>(K);
-        viennacl::vector<T> vcl_B_rowsum = viennacl::zero_vector<T>(Q);
-        
-        vcl_A_rowsum = viennacl::linalg::row_sum(square_A);
-        vcl_B_rowsum = viennacl::linalg::row_sum(square_B);
-        
-        viennacl::matrix<T> vclXX = viennacl::linalg::outer_prod(vcl_A_rowsum, B_row_ones);
-        viennacl::matrix<T> vclYY = viennacl::linalg::outer_prod(A_row_ones, vcl_B_rowsum);
-        
-        vcl_D = vclXX + vclYY;
-        vcl_D -= 2 * (viennacl::linalg::prod(vcl_A, trans(vcl_B)));
-    }
-    
-    if(!squareDist){
-        vcl_D = viennacl::linalg::element_sqrt(vcl_D);    
-    }
+    vcl_peucl<T>(vcl_A, vcl_B, vcl_D, squareDist);
     
     ptrD->to_host(vcl_D);
-        
 }
 
 template <typename T>
@@ -556,10 +482,6 @@ cpp_vclMatrix_eucl(
         viennacl::ocl::set_context_device_type(id, viennacl::ocl::cpu_tag());
         viennacl::ocl::switch_context(id);
     }
-//    
-//    viennacl::matrix<T> &vcl_A = *ptrA;
-//    viennacl::matrix<T> &vcl_D = *ptrD;
-    
     
     Rcpp::XPtr<dynVCLMat<T> > ptrA(ptrA_);
     Rcpp::XPtr<dynVCLMat<T> > ptrD(ptrD_);
@@ -567,59 +489,7 @@ cpp_vclMatrix_eucl(
     viennacl::matrix_range<viennacl::matrix<T> > vcl_A = ptrA->data();
     viennacl::matrix_range<viennacl::matrix<T> > vcl_D = ptrD->data();
     
-//    std::cout << "pulled data" << std::endl;
-//    std::cout << vcl_A.size1() << std::endl;
-    
-//    viennacl::vector<T> vcl_sqrt = viennacl::zero_vector<T>(vcl_A.size1());
-    viennacl::vector<T> vcl_sqrt;
-    
-//    std::cout << "row of zeros" << std::endl;
-    
-    // this will definitely need to be updated with the next ViennaCL release
-    // currently doesn't support the single scalar operation with
-    // element_pow below
-    {
-        viennacl::matrix<T> twos = viennacl::scalar_matrix<T>(vcl_A.size1(), vcl_A.size2(), 2);
-    
-//        std::cout << "create 'twos' matrix" << std::endl;
-        
-        viennacl::matrix<T> square_A = viennacl::linalg::element_pow(vcl_A, twos);
-        vcl_sqrt = viennacl::linalg::row_sum(square_A);
-    }
-    
-    
-//    std::cout << "powers and rowsum completed" << std::endl;
-    
-    {
-        viennacl::vector<T> row_ones = viennacl::scalar_vector<T>(vcl_A.size1(), 1);
-        
-//        std::cout << "row of ones" << std::endl;
-        
-        vcl_D = viennacl::linalg::outer_prod(vcl_sqrt, row_ones);
-    }
-    
-//    std::cout << "outer product completed" << std::endl;
-    
-//    std::cout << vcl_D << std::endl;
-    
-    vcl_D += trans(vcl_D);
-    
-//    std::cout << vcl_D << std::endl;
-    
-//    viennacl::matrix<T> temp = 2 * (viennacl::linalg::prod(vcl_A, trans(vcl_A)));
-    
-//    std::cout << temp << std::endl;
-    vcl_D -= 2 * (viennacl::linalg::prod(vcl_A, trans(vcl_A)));
-//    vcl_D -= temp;
-    if(!squareDist){
-        vcl_D = viennacl::linalg::element_sqrt(vcl_D);    
-    }
-    
-    for(unsigned int i=0; i < vcl_D.size1(); i++){
-        vcl_D(i,i) = 0;
-    }
-//    viennacl::diag(vcl_D) = viennacl::zero_vector<T>(vcl_A.size1());
-        
+    vcl_eucl<T>(vcl_A, vcl_D, squareDist);
 }
 
 template <typename T>
@@ -652,55 +522,7 @@ cpp_vclMatrix_peucl(
     viennacl::matrix_range<viennacl::matrix<T> > vcl_B = ptrB->data();
     viennacl::matrix_range<viennacl::matrix<T> > vcl_D = ptrD->data();
     
-    viennacl::matrix<T> square_A;
-    viennacl::matrix<T> square_B;
-    
-//    std::cout << "pulled data" << std::endl;
-    
-    // this will definitely need to be updated with the next ViennaCL release
-    // currently doesn't support the single scalar operation with
-    // element_pow below
-    {
-        viennacl::matrix<T> twos = viennacl::scalar_matrix<T>(std::max(vcl_A.size1(), vcl_B.size1()), std::max(vcl_A.size2(), vcl_B.size2()), 2);
-    
-        square_A = viennacl::linalg::element_pow(vcl_A, twos);
-        square_B = viennacl::linalg::element_pow(vcl_B, twos);
-    }
-    
-//    std::cout << "power calculation complete" << std::endl;
-    
-    {
-        viennacl::vector<T> x_row_ones = viennacl::scalar_vector<T>(vcl_A.size1(), 1);
-        viennacl::vector<T> y_row_ones = viennacl::scalar_vector<T>(vcl_B.size1(), 1);
-        
-        viennacl::vector<T> vcl_A_rowsum = viennacl::zero_vector<T>(vcl_A.size1());
-        viennacl::vector<T> vcl_B_rowsum = viennacl::zero_vector<T>(vcl_B.size1());
-        
-        vcl_A_rowsum = viennacl::linalg::row_sum(square_A);
-        vcl_B_rowsum = viennacl::linalg::row_sum(square_B);
-        
-//        std::cout << "row sums complete" << std::endl;
-        
-        viennacl::matrix<T> vclXX = viennacl::linalg::outer_prod(vcl_A_rowsum, y_row_ones);
-        //std::cout << vclXX << std::endl;
-        viennacl::matrix<T> vclYY = viennacl::linalg::outer_prod(x_row_ones, vcl_B_rowsum);
-//        std::cout << "outer products complete" << std::endl;
-        //    std::cout << vclYY << std::endl;
-        vcl_D = vclXX + vclYY;
-    }
-    
-    
-    vcl_D -= 2 * (viennacl::linalg::prod(vcl_A, trans(vcl_B)));
-    
-    if(!squareDist){
-        vcl_D = viennacl::linalg::element_sqrt(vcl_D);    
-    }
-    
-//    for(unsigned int i=0; i < vcl_D.size1(); i++){
-//        vcl_D(i,i) = 0;
-//    }
-//    viennacl::diag(vcl_D) = viennacl::zero_vector<T>(vcl_A.size1());
-        
+    vcl_peucl<T>(vcl_A, vcl_B, vcl_D, squareDist);
 }
 
 // [[Rcpp::export]]
@@ -991,6 +813,98 @@ cpp_vclMatrix_colsum(
     }
 }
 
+// [[Rcpp::export]]
+void
+cpp_vclMatrix_colmax(
+    SEXP ptrA, SEXP ptrB,
+    int device_flag,
+    const int type_flag)
+{
+    
+    switch(type_flag) {
+        case 4:
+            cpp_vclMatrix_margin_extreme<int>(ptrA, ptrB, true, false, device_flag);
+            return;
+        case 6:
+            cpp_vclMatrix_margin_extreme<float>(ptrA, ptrB, true, false, device_flag);
+            return;
+        case 8:
+            cpp_vclMatrix_margin_extreme<double>(ptrA, ptrB, true, false, device_flag);
+            return;
+        default:
+            throw Rcpp::exception("unknown type detected for vclMatrix object!");
+    }
+}
+
+// [[Rcpp::export]]
+void
+cpp_vclMatrix_colmin(
+    SEXP ptrA, SEXP ptrB,
+    int device_flag,
+    const int type_flag)
+{
+    
+    switch(type_flag) {
+        case 4:
+            cpp_vclMatrix_margin_extreme<int>(ptrA, ptrB, false, false, device_flag);
+            return;
+        case 6:
+            cpp_vclMatrix_margin_extreme<float>(ptrA, ptrB, false, false, device_flag);
+            return;
+        case 8:
+            cpp_vclMatrix_margin_extreme<double>(ptrA, ptrB, false, false, device_flag);
+            return;
+        default:
+            throw Rcpp::exception("unknown type detected for vclMatrix object!");
+    }
+}
+
+// [[Rcpp::export]]
+void
+cpp_vclMatrix_rowmax(
+    SEXP ptrA, SEXP ptrB,
+    int device_flag,
+    const int type_flag)
+{
+    
+    switch(type_flag) {
+        case 4:
+            cpp_vclMatrix_margin_extreme<int>(ptrA, ptrB, true, true, device_flag);
+            return;
+        case 6:
+            cpp_vclMatrix_margin_extreme<float>(ptrA, ptrB, true, true, device_flag);
+            return;
+        case 8:
+            cpp_vclMatrix_margin_extreme<double>(ptrA, ptrB, true, true, device_flag);
+            return;
+        default:
+            throw Rcpp::exception("unknown type detected for vclMatrix object!");
+    }
+}
+
+// [[Rcpp::export]]
+void
+cpp_vclMatrix_rowmin(
+    SEXP ptrA, SEXP ptrB,
+    int device_flag,
+    const int type_flag)
+{
+    
+    switch(type_flag) {
+        case 4:
+            cpp_vclMatrix_margin_extreme<int>(ptrA, ptrB, false, true, device_flag);
+            return;
+        case 6:
+            cpp_vclMatrix_margin_extreme<float>(ptrA, ptrB, false, true, device_flag);
+            return;
+        case 8:
+            cpp_vclMatrix_margin_extreme<double>(ptrA, ptrB, false, true, device_flag);
+            return;
+        default:
+            throw Rcpp::exception("unknown type detected for vclMatrix object!");
+    }
+}
+
 // [[Rcpp::export]]
 void
 cpp_vclMatrix_rowmean(
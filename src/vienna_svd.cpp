@@ -0,0 +1,448 @@
+#include "gpuR/windows_check.hpp"
+
+// eigen headers for handling the R input data and the small SVD
+#include <RcppEigen.h>
+
+#include "gpuR/dynEigenMat.hpp"
+#include "gpuR/dynEigenVec.hpp"
+#include "gpuR/dynVCLMat.hpp"
+#include "gpuR/dynVCLVec.hpp"
+
+// Use OpenCL with ViennaCL
+#define VIENNACL_WITH_OPENCL 1
+
+// ViennaCL headers
+#include "viennacl/ocl/device.hpp"
+#include "viennacl/ocl/platform.hpp"
+#include "viennacl/matrix.hpp"
+#include "viennacl/matrix_proxy.hpp"
+#include "viennacl/linalg/prod.hpp"
+
+// Householder QR and the thin Q
+#include "gpuR/vcl_factor.hpp"
+// small device matrices to and from the host
+#include "gpuR/vcl_eigen_copy.hpp"
+// centering and scaling for prcomp
+#include "gpuR/vcl_stats_helpers.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace Rcpp;
+
+/* Randomized truncated SVD.
+ *
+ * The range of A (m x n) is found from the sketch Y = A Omega with an
+ * n x l Gaussian Omega, sharpened by power iterations that
+ * re-orthonormalize between every product so the sketch conditioning
+ * does not grow with their number.  With Q an orthonormal basis of Y,
+ * t(A) Q = Q2 R2 by a second QR and A ~ Q t(R2) t(Q2), so only the
+ * l x l t(R2) is decomposed on the host.  Every product with A is an
+ * m x n by n x l or n x m by m x l GEMM, the extra memory is O((m + n) l).
+ */
+
+// d <- the l leading singular values of A, U (m x l) and V (n x l) their
+// singular vectors
+template <typename T, typename MatA, typename MatO>
+static void
+vcl_rsvd(
+    MatA &A, MatO &Omega, int power,
+    std::vector<T> &d, viennacl::matrix<T> &U, viennacl::matrix<T> &V)
+{
+    const size_t l = Omega.size2();
+    viennacl::range rl(0, l);
+
+    viennacl::matrix<T> Y = viennacl::linalg::prod(A, Omega);
+
+    for(int q = 0; q < power; q++){
+        vcl_orthonormalize<T>(Y);
+        viennacl::matrix<T> Z = viennacl::linalg::prod(viennacl::trans(A), Y);
+        vcl_orthonormalize<T>(Z);
+        Y = viennacl::linalg::prod(A, Z);
+    }
+    vcl_orthonormalize<T>(Y);
+
+    // t(A) Q = Q2 R2
+    viennacl::matrix<T> Bt = viennacl::linalg::prod(viennacl::trans(A), Y);
+    std::vector<T> betas = viennacl::linalg::inplace_qr(Bt);
+
+    viennacl::matrix<T> vcl_R2 = viennacl::project(Bt, rl, rl);
+    Eigen::MatrixXd R2 = vcl_to_eigen<T>(vcl_R2);
+    R2.template triangularView<Eigen::StrictlyLower>().setZero();
+
+    viennacl::matrix<T> Q2 = vcl_thin_q(Bt, betas);
+
+    // Q t(R2) t(Q2) = (Q U') S t(Q2 V')
+    Eigen::JacobiSVD<Eigen::MatrixXd> svd(R2.transpose(), Eigen::ComputeFullU | Eigen::ComputeFullV);
+
+    d.resize(l);
+    for(size_t j = 0; j < l; j++){
+        d[j] = (T)svd.singularValues()(j);
+    }
+
+    viennacl::matrix<T> vcl_U = vcl_from_eigen<T>(svd.matrixU());
+    viennacl::matrix<T> vcl_V = vcl_from_eigen<T>(svd.matrixV());
+
+    U = viennacl::linalg::prod(Y, vcl_U);
+    V = viennacl::linalg::prod(Q2, vcl_V);
+}
+
+// the first k columns of A
+template <typename T>
+static viennacl::matrix<T>
+leading_cols(viennacl::matrix<T> &A, size_t k)
+{
+    return viennacl::project(A, viennacl::range(0, A.size1()), viennacl::range(0, k));
+}
+
+/* Principal components of the centered and scaled A (overwritten) as the
+ * right singular vectors, so the covariance matrix is never formed.
+ * sdev <- the k leading standard deviations, R <- the p x k rotation and,
+ * unless null, X <- the scores A R.  Nothing but sdev leaves the device.
+ */
+template <typename T, typename MatO>
+static void
+vcl_prcomp(
+    viennacl::matrix<T> &A, MatO &Omega, int power, size_t k,
+    std::vector<T> &sdev, viennacl::matrix<T> &R, viennacl::matrix<T> *X)
+{
+    std::vector<T> d;
+    viennacl::matrix<T> U, V;
+
+    vcl_rsvd(A, Omega, power, d, U, V);
+
+    const T s = (T)(1) / std::sqrt((T)(std::max<size_t>(1, A.size1() - 1)));
+    sdev.resize(k);
+    for(size_t j = 0; j < k; j++){
+        sdev[j] = d[j] * s;
+    }
+
+    R = leading_cols(V, k);
+
+    if(X){
+        *X = viennacl::linalg::prod(A, R);
+    }
+}
+
+/*** gpuMatrix/vclMatrix Templates ***/
+
+template <typename T>
+void
+cpp_gpuMatrix_svd(
+    SEXP ptrA_, SEXP ptrOmega_, SEXP ptrD_, SEXP ptrU_, SEXP ptrV_,
+    int power,
+    int device_flag)
+{
+    // define device type to use
+    if(device_flag == 0){
+        //use only GPUs
+        long id = 0;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::gpu_tag());
+        viennacl::ocl::switch_context(id);
+    }else{
+        // use only CPUs
+        long id = 1;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::cpu_tag());
+        viennacl::ocl::switch_context(id);
+    }
+
+    XPtr<dynEigenMat<T> > ptrA(ptrA_);
+    XPtr<dynEigenMat<T> > ptrOmega(ptrOmega_);
+    XPtr<dynEigenVec<T> > ptrD(ptrD_);
+
+    viennacl::matrix<T> vcl_A = ptrA->device_data();
+    viennacl::matrix<T> vcl_Omega = ptrOmega->device_data();
+
+    std::vector<T> d;
+    viennacl::matrix<T> vcl_U, vcl_V;
+
+    vcl_rsvd(vcl_A, vcl_Omega, power, d, vcl_U, vcl_V);
+
+    Eigen::Map<Eigen::Matrix<T, Eigen::Dynamic, 1> > D = ptrD->data();
+    std::copy(d.begin(), d.begin() + D.size(), D.data());
+
+    if(!Rf_isNull(ptrU_)){
+        XPtr<dynEigenMat<T> > ptrU(ptrU_);
+        viennacl::matrix<T> vcl_Uk = leading_cols(vcl_U, ptrU->ncol());
+        ptrU->to_host(vcl_Uk);
+    }
+    if(!Rf_isNull(ptrV_)){
+        XPtr<dynEigenMat<T> > ptrV(ptrV_);
+        viennacl::matrix<T> vcl_Vk = leading_cols(vcl_V, ptrV->ncol());
+        ptrV->to_host(vcl_Vk);
+    }
+}
+
+template <typename T>
+void
+cpp_vclMatrix_svd(
+    SEXP ptrA_, SEXP ptrOmega_, SEXP ptrD_, SEXP ptrU_, SEXP ptrV_,
+    int power,
+    int device_flag)
+{
+    // define device type to use
+    if(device_flag == 0){
+        //use only GPUs
+        long id = 0;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::gpu_tag());
+        viennacl::ocl::switch_context(id);
+    }else{
+        // use only CPUs
+        long id = 1;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::cpu_tag());
+        viennacl::ocl::switch_context(id);
+    }
+
+    Rcpp::XPtr<dynVCLMat<T> > ptrA(ptrA_);
+    Rcpp::XPtr<dynVCLMat<T> > ptrOmega(ptrOmega_);
+    Rcpp::XPtr<dynVCLVec<T> > ptrD(ptrD_);
+
+    viennacl::matrix_range<viennacl::matrix<T> > vcl_A = ptrA->data();
+    viennacl::matrix_range<viennacl::matrix<T> > vcl_Omega = ptrOmega->data();
+
+    std::vector<T> d;
+    viennacl::matrix<T> vcl_U, vcl_V;
+
+    vcl_rsvd(vcl_A, vcl_Omega, power, d, vcl_U, vcl_V);
+
+    viennacl::vector_range<viennacl::vector<T> > vcl_D = ptrD->data();
+    d.resize(vcl_D.size());
+    viennacl::copy(d, vcl_D);
+
+    if(!Rf_isNull(ptrU_)){
+        Rcpp::XPtr<dynVCLMat<T> > ptrU(ptrU_);
+        viennacl::matrix_range<viennacl::matrix<T> > vcl_Uk = ptrU->data();
+        vcl_Uk = leading_cols(vcl_U, vcl_Uk.size2());
+    }
+    if(!Rf_isNull(ptrV_)){
+        Rcpp::XPtr<dynVCLMat<T> > ptrV(ptrV_);
+        viennacl::matrix_range<viennacl::matrix<T> > vcl_Vk = ptrV->data();
+        vcl_Vk = leading_cols(vcl_V, vcl_Vk.size2());
+    }
+}
+
+template <typename T>
+void
+cpp_gpuMatrix_prcomp(
+    SEXP ptrA_, SEXP ptrOmega_, 
+    SEXP ptrCenter_, SEXP ptrScale_, SEXP ptrSdev_, SEXP ptrR_, SEXP ptrX_,
+    int power,
+    int device_flag)
+{
+    // define device type to use
+    if(device_flag == 0){
+        //use only GPUs
+        long id = 0;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::gpu_tag());
+        viennacl::ocl::switch_context(id);
+    }else{
+        // use only CPUs
+        long id = 1;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::cpu_tag());
+        viennacl::ocl::switch_context(id);
+    }
+
+    XPtr<dynEigenMat<T> > ptrA(ptrA_);
+    XPtr<dynEigenMat<T> > ptrOmega(ptrOmega_);
+    XPtr<dynEigenVec<T> > ptrSdev(ptrSdev_);
+    XPtr<dynEigenMat<T> > ptrR(ptrR_);
+
+    const bool center = !Rf_isNull(ptrCenter_);
+    const bool scale = !Rf_isNull(ptrScale_);
+    const bool retx = !Rf_isNull(ptrX_);
+
+    // a copy already, centered in place
+    viennacl::matrix<T> vcl_A = ptrA->device_data();
+    viennacl::matrix<T> vcl_Omega = ptrOmega->device_data();
+
+    viennacl::vector<T> vcl_center(vcl_A.size2());
+    viennacl::vector<T> vcl_scale(vcl_A.size2());
+
+    if(!vcl_center_scale(vcl_A, center, scale, vcl_center, vcl_scale)){
+        throw Rcpp::exception("cannot rescale a constant/zero column to unit variance");
+    }
+
+    std::vector<T> sdev;
+    viennacl::matrix<T> vcl_R, vcl_X;
+
+    vcl_prcomp(vcl_A, vcl_Omega, power, ptrR->ncol(), sdev, vcl_R, retx ? &vcl_X : NULL);
+
+    Eigen::Map<Eigen::Matrix<T, Eigen::Dynamic, 1> > Sdev = ptrSdev->data();
+    std::copy(sdev.begin(), sdev.end(), Sdev.data());
+
+    ptrR->to_host(vcl_R);
+
+    if(center){
+        XPtr<dynEigenVec<T> > ptrCenter(ptrCenter_);
+        Eigen::Map<Eigen::Matrix<T, Eigen::Dynamic, 1> > Center = ptrCenter->data();
+        std::vector<T> mu(vcl_center.size());
+        viennacl::copy(vcl_center, mu);
+        std::copy(mu.begin(), mu.end(), Center.data());
+    }
+    if(scale){
+        XPtr<dynEigenVec<T> > ptrScale(ptrScale_);
+        Eigen::Map<Eigen::Matrix<T, Eigen::Dynamic, 1> > Scale = ptrScale->data();
+        std::vector<T> sigma(vcl_scale.size());
+        viennacl::copy(vcl_scale, sigma);
+        std::copy(sigma.begin(), sigma.end(), Scale.data());
+    }
+    if(retx){
+        XPtr<dynEigenMat<T> > ptrX(ptrX_);
+        ptrX->to_host(vcl_X);
+    }
+}
+
+template <typename T>
+void
+cpp_vclMatrix_prcomp(
+    SEXP ptrA_, SEXP ptrOmega_, 
+    SEXP ptrCenter_, SEXP ptrScale_, SEXP ptrSdev_, SEXP ptrR_, SEXP ptrX_,
+    int power,
+    int device_flag)
+{
+    // define device type to use
+    if(device_flag == 0){
+        //use only GPUs
+        long id = 0;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::gpu_tag());
+        viennacl::ocl::switch_context(id);
+    }else{
+        // use only CPUs
+        long id = 1;
+        viennacl::ocl::set_context_device_type(id, viennacl::ocl::cpu_tag());
+        viennacl::ocl::switch_context(id);
+    }
+
+    Rcpp::XPtr<dynVCLMat<T> > ptrA(ptrA_);
+    Rcpp::XPtr<dynVCLMat<T> > ptrOmega(ptrOmega_);
+    Rcpp::XPtr<dynVCLVec<T> > ptrSdev(ptrSdev_);
+    Rcpp::XPtr<dynVCLMat<T> > ptrR(ptrR_);
+
+    const bool center = !Rf_isNull(ptrCenter_);
+    const bool scale = !Rf_isNull(ptrScale_);
+    const bool retx = !Rf_isNull(ptrX_);
+
+    // x itself is left untouched
+    viennacl::matrix<T> vcl_A(ptrA->data());
+    viennacl::matrix_range<viennacl::matrix<T> > vcl_Omega = ptrOmega->data();
+    viennacl::matrix_range<viennacl::matrix<T> > vcl_R = ptrR->data();
+
+    viennacl::vector<T> vcl_center(vcl_A.size2());
+    viennacl::vector<T> vcl_scale(vcl_A.size2());
+
+    if(!vcl_center_scale(vcl_A, center, scale, vcl_center, vcl_scale)){
+        throw Rcpp::exception("cannot rescale a constant/zero column to unit variance");
+    }
+
+    std::vector<T> sdev;
+    viennacl::matrix<T> vcl_Rk, vcl_X;
+
+    vcl_prcomp(vcl_A, vcl_Omega, power, vcl_R.size2(), sdev, vcl_Rk, retx ? &vcl_X : NULL);
+
+    viennacl::vector_range<viennacl::vector<T> > vcl_sdev = ptrSdev->data();
+    viennacl::copy(sdev, vcl_sdev);
+
+    vcl_R = vcl_Rk;
+
+    if(center){
+        Rcpp::XPtr<dynVCLVec<T> > ptrCenter(ptrCenter_);
+        viennacl::vector_range<viennacl::vector<T> > vcl_mu = ptrCenter->data();
+        vcl_mu = vcl_center;
+    }
+    if(scale){
+        Rcpp::XPtr<dynVCLVec<T> > ptrScale(ptrScale_);
+        viennacl::vector_range<viennacl::vector<T> > vcl_sigma = ptrScale->data();
+        vcl_sigma = vcl_scale;
+    }
+    if(retx){
+        Rcpp::XPtr<dynVCLMat<T> > ptrX(ptrX_);
+        viennacl::matrix_range<viennacl::matrix<T> > vcl_Xk = ptrX->data();
+        vcl_Xk = vcl_X;
+    }
+}
+
+
+/*** Exported functions ***/
+
+// [[Rcpp::export]]
+void
+cpp_gpuMatrix_svd(
+    SEXP ptrA, SEXP ptrOmega, SEXP ptrD, SEXP ptrU, SEXP ptrV,
+    int power,
+    int device_flag,
+    const int type_flag)
+{
+    switch(type_flag) {
+        case 6:
+            cpp_gpuMatrix_svd<float>(ptrA, ptrOmega, ptrD, ptrU, ptrV, power, device_flag);
+            return;
+        case 8:
+            cpp_gpuMatrix_svd<double>(ptrA, ptrOmega, ptrD, ptrU, ptrV, power, device_flag);
+            return;
+        default:
+            throw Rcpp::exception("unknown type detected for gpuMatrix object!");
+    }
+}
+
+// [[Rcpp::export]]
+void
+cpp_vclMatrix_svd(
+    SEXP ptrA, SEXP ptrOmega, SEXP ptrD, SEXP ptrU, SEXP ptrV,
+    int power,
+    int device_flag,
+    const int type_flag)
+{
+    switch(type_flag) {
+        case 6:
+            cpp_vclMatrix_svd<float>(ptrA, ptrOmega, ptrD, ptrU, ptrV, power, device_flag);
+            return;
+        case 8:
+            cpp_vclMatrix_svd<double>(ptrA, ptrOmega, ptrD, ptrU, ptrV, power, device_flag);
+            return;
+        default:
+            throw Rcpp::exception("unknown type detected for vclMatrix object!");
+    }
+}
+
+// [[Rcpp::export]]
+void
+cpp_gpuMatrix_prcomp(
+    SEXP ptrA, SEXP ptrOmega, 
+    SEXP ptrCenter, SEXP ptrScale, SEXP ptrSdev, SEXP ptrR, SEXP ptrX,
+    int power,
+    int device_flag,
+    const int type_flag)
+{
+    switch(type_flag) {
+        case 6:
+            cpp_gpuMatrix_prcomp<float>(ptrA, ptrOmega, ptrCenter, ptrScale, ptrSdev, ptrR, ptrX, power, device_flag);
+            return;
+        case 8:
+            cpp_gpuMatrix_prcomp<double>(ptrA, ptrOmega, ptrCenter, ptrScale, ptrSdev, ptrR, ptrX, power, device_flag);
+            return;
+        default:
+            throw Rcpp::exception("unknown type detected for gpuMatrix object!");
+    }
+}
+
+// [[Rcpp::export]]
+void
+cpp_vclMatrix_prcomp(
+    SEXP ptrA, SEXP ptrOmega, 
+    SEXP ptrCenter, SEXP ptrScale, SEXP ptrSdev, SEXP ptrR, SEXP ptrX,
+    int power,
+    int device_flag,
+    const int type_flag)
+{
+    switch(type_flag) {
+        case 6:
+            cpp_vclMatrix_prcomp<float>(ptrA, ptrOmega, ptrCenter, ptrScale, ptrSdev, ptrR, ptrX, power, device_flag);
+            return;
+        case 8:
+            cpp_vclMatrix_prcomp<double>(ptrA, ptrOmega, ptrCenter, ptrScale, ptrSdev, ptrR, ptrX, power, device_flag);
+            return;
+        default:
+            throw Rcpp::exception("unknown type detected for vclMatrix object!");
+    }
+}